@@ -1607,7 +1607,22 @@ void LAUTiffViewer::loadViewerState()
 /****************************************************************************/
 LAUTiffViewerWorker::LAUTiffViewerWorker(QObject *parent)
     : QObject(parent)
+    , reader(nullptr)
+    , idleTimer(new QTimer(this))
 {
+    // Let go of the file once the user stops browsing so that it is not held
+    // open (and locked on Windows) while another tool rewrites or appends to it
+    idleTimer->setSingleShot(true);
+    idleTimer->setInterval(READER_IDLE_MSECS);
+    connect(idleTimer, &QTimer::timeout, this, &LAUTiffViewerWorker::releaseReader);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUTiffViewerWorker::~LAUTiffViewerWorker()
+{
+    delete reader;
 }
 
 /****************************************************************************/
@@ -1618,6 +1633,31 @@ void LAUTiffViewerWorker::setFilename(const QString &filename)
     this->filename = filename;
 }
 
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObjectReader *LAUTiffViewerWorker::openReader()
+{
+    // Keep the file open between requests and use the cached directory index
+    // so that jumping to any frame costs the same no matter how deep it is,
+    // but reopen it if the file has been rewritten or grown since it was opened
+    if (reader == nullptr || reader->filename() != filename || reader->isCurrent() == false) {
+        delete reader;
+        reader = new LAUMemoryObjectReader(filename, true);
+    }
+    idleTimer->start();
+    return reader->isValid() ? reader : nullptr;
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUTiffViewerWorker::releaseReader()
+{
+    delete reader;
+    reader = nullptr;
+}
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -1629,7 +1669,8 @@ void LAUTiffViewerWorker::loadImage(int directory)
     }
 
     try {
-        LAUMemoryObject image(filename, directory);
+        LAUMemoryObjectReader *tiffReader = openReader();
+        LAUMemoryObject image = tiffReader ? tiffReader->read(directory) : LAUMemoryObject();
         emit imageLoaded(image, directory);
     } catch (...) {
         qDebug() << "Failed to load directory" << directory << "from" << filename;
@@ -1649,7 +1690,8 @@ void LAUTiffViewerWorker::preloadRange(int start, int end)
 
     for (int i = start; i <= end; ++i) {
         try {
-            LAUMemoryObject image(filename, i);
+            LAUMemoryObjectReader *tiffReader = openReader();
+            LAUMemoryObject image = tiffReader ? tiffReader->read(i) : LAUMemoryObject();
             emit imageLoaded(image, i);
             emit loadingProgress(i);
         } catch (...) {
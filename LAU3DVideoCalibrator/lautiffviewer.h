@@ -24,6 +24,7 @@
 #define LAUTIFFVIEWER_H
 
 #define CAMERA_HEIGHT_PIXELS 480
+#define READER_IDLE_MSECS    2000
 
 #include <QWidget>
 #include <QLabel>
@@ -242,6 +243,7 @@ class LAUTiffViewerWorker : public QObject
 
 public:
     explicit LAUTiffViewerWorker(QObject *parent = nullptr);
+    ~LAUTiffViewerWorker();
 
     void setFilename(const QString &filename);
     void preloadImages(int startDir, int endDir);
@@ -250,8 +252,15 @@ public slots:
     void loadImage(int directory);
     void preloadRange(int start, int end);
 
+private slots:
+    void releaseReader();
+
 private:
     QString filename;
+    LAUMemoryObjectReader *reader;
+    QTimer *idleTimer;
+
+    LAUMemoryObjectReader *openReader();
 
 signals:
     void imageLoaded(const LAUMemoryObject &image, int directory);
@@ -8,6 +8,7 @@
 CONFIG  -= cascade
 CONFIG  += orbbec
 CONFIG  += lucid
+CONFIG  += replay
 
 DEFINES += LUCID_USEPTPCOMMANDS
 
@@ -42,6 +43,7 @@ HEADERS += ../LAUSupportFiles/Filters/lauabstractfilter.h \
            ../LAUSupportFiles/Filters/lauprojectscantocameraglfilter.h \
            ../LAUSupportFiles/Filters/laumergedocumentswidget.h \
            ../LAUSupportFiles/Filters/laubackgroundglfilter.h \
+           ../LAUSupportFiles/Filters/laubackgroundfilter.h \
            ../LAUSupportFiles/Filters/laugreenscreenglfilter.h \
            ../LAUSupportFiles/Sinks/lau3dvideorecordingwidget.h \
            ../LAUSupportFiles/Sinks/lau3dvideoplayerwidget.h \
@@ -79,6 +81,7 @@ SOURCES += main.cpp \
            ../LAUSupportFiles/Filters/lauprojectscantocameraglfilter.cpp \
            ../LAUSupportFiles/Filters/laumergedocumentswidget.cpp \
            ../LAUSupportFiles/Filters/laubackgroundglfilter.cpp \
+           ../LAUSupportFiles/Filters/laubackgroundfilter.cpp \
            ../LAUSupportFiles/Filters/laugreenscreenglfilter.cpp \
            ../LAUSupportFiles/Sinks/lau3dvideorecordingwidget.cpp \
            ../LAUSupportFiles/Sinks/lau3dfiducialglwidget.cpp \
@@ -167,6 +170,12 @@ lucid {
     SOURCES     += ../LAUSupportFiles/Sources/laulucidcamera.cpp
 }
 
+replay {
+    DEFINES     += REPLAY
+    HEADERS     += ../LAUSupportFiles/Sources/laureplaycamera.h
+    SOURCES     += ../LAUSupportFiles/Sources/laureplaycamera.cpp
+}
+
 # ============================================================================
 # PLATFORM-SPECIFIC CONFIGURATION
 # ============================================================================
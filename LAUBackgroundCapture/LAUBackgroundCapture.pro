@@ -8,6 +8,7 @@
 CONFIG  -= cascade
 CONFIG  += orbbec
 CONFIG  += lucid
+CONFIG  += replay
 
 DEFINES += LUCID_USEPTPCOMMANDS
 
@@ -70,6 +71,7 @@ win32:QMAKE_TARGET_COPYRIGHT = "Copyright (c) 2025 Lau Consulting Inc"
 HEADERS += laubackgroundfiltermainwindow.h \
            ../LAUSupportFiles/Filters/lauabstractfilter.h \
            ../LAUSupportFiles/Filters/laubackgroundglfilter.h \
+           ../LAUSupportFiles/Filters/laubackgroundfilter.h \
            ../LAUSupportFiles/Sinks/lau3dvideowidget.h \
            ../LAUSupportFiles/Sinks/lau3dvideoglwidget.h \
            ../LAUSupportFiles/Sinks/lau3dfiducialglwidget.h \
@@ -97,6 +99,7 @@ SOURCES += main.cpp \
            laubackgroundfiltermainwindow.cpp \
            ../LAUSupportFiles/Filters/lauabstractfilter.cpp \
            ../LAUSupportFiles/Filters/laubackgroundglfilter.cpp \
+           ../LAUSupportFiles/Filters/laubackgroundfilter.cpp \
            ../LAUSupportFiles/Sinks/lau3dvideowidget.cpp \
            ../LAUSupportFiles/Sinks/lau3dvideoglwidget.cpp \
            ../LAUSupportFiles/Sinks/lau3dfiducialglwidget.cpp \
@@ -209,3 +212,9 @@ lucid {
     HEADERS     += ../LAUSupportFiles/Sources/laulucidcamera.h
     SOURCES     += ../LAUSupportFiles/Sources/laulucidcamera.cpp
 }
+
+replay {
+    DEFINES     += REPLAY
+    HEADERS     += ../LAUSupportFiles/Sources/laureplaycamera.h
+    SOURCES     += ../LAUSupportFiles/Sources/laureplaycamera.cpp
+}
@@ -35,6 +35,7 @@
 #include <QDir>
 #include <QFile>
 #include "laubackgroundfiltermainwindow.h"
+#include "laubackgroundfilter.h"
 #include "lauscan.h"
 
 #ifdef LUCID
@@ -163,6 +164,68 @@ int checkCamerasAvailable()
     }
 }
 
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// Build a background from a recording on disk with the CPU background filter (no GUI, no OpenGL)
+int backgroundFromRecording(QString inputFilename, QString outputFilename, int maxFilterFrameCount)
+{
+    LAUMemoryObjectReader reader(inputFilename);
+    if (reader.isValid() == false) {
+        fprintf(stderr, "Error: Unable to open recording %s\n", inputFilename.toLocal8Bit().constData());
+        return 1;
+    }
+
+    // THE SAVE TO DISK FILTER WRITES THE OLD BACKGROUND AS THE FIRST DIRECTORY SO SKIP IT
+    int firstFrameIndex = (reader.directories() > 1) ? 1 : 0;
+    LAUMemoryObject frame = reader.read(firstFrameIndex);
+    if (frame.isNull() || frame.colors() != 1 || frame.depth() != sizeof(unsigned short)) {
+        fprintf(stderr, "Error: Recording %s has no 16-bit depth video\n", inputFilename.toLocal8Bit().constData());
+        return 1;
+    }
+
+    // THE FILTER WORKS PIXEL BY PIXEL SO STACKED SENSORS CAN BE FILTERED AS ONE TALL FRAME
+    LAUBackgroundFilter filter(frame.width(), frame.height() * frame.frames());
+    filter.onSetMaxPixelFilterCount(maxFilterFrameCount);
+    filter.setJetrVector(frame.jetr());
+
+    // USE THE FAR END OF THE FIRST SENSOR'S RANGE TO FILL HOLES, JUST LIKE THE LIVE CAMERA'S MAXDISTANCE
+    QVector<double> jetrVector = frame.jetr();
+    if (jetrVector.count() > 36 && std::isfinite(jetrVector.at(36))) {
+        filter.setMaxDistance(static_cast<unsigned short>(qBound(0.0, jetrVector.at(36), 65535.0)));
+    }
+
+    // RUN EVERY DEPTH FRAME THROUGH THE FILTER, SKIPPING ANY INTERLEAVED COLOR FRAMES
+    for (int index = firstFrameIndex; index < reader.directories(); index++) {
+        if (reader.readInto(frame, index) == false) {
+            fprintf(stderr, "Error: Unable to read frame %d from %s\n", index, inputFilename.toLocal8Bit().constData());
+            return 1;
+        }
+        if (frame.colors() != 1 || frame.depth() != sizeof(unsigned short) || (int)frame.width() != filter.width() || (int)(frame.height() * frame.frames()) != filter.height()) {
+            continue;
+        }
+        if (frame.isElapsedValid() == false) {
+            frame.setElapsed((unsigned int)index);
+        }
+        filter.onUpdateBuffer(frame);
+    }
+
+    LAUMemoryObject background = filter.background();
+    if (background.isNull()) {
+        fprintf(stderr, "Error: Need at least %d depth frames to build a background, found %d\n", maxFilterFrameCount, filter.frames());
+        return 1;
+    }
+
+    if (background.save(outputFilename) == false) {
+        fprintf(stderr, "Error: Unable to save background to %s\n", outputFilename.toLocal8Bit().constData());
+        return 1;
+    }
+
+    fprintf(stdout, "Background built from %d frames in %.3f msec per frame\n", filter.frames(), filter.averageFrameTime());
+    fflush(stdout);
+    return 0;
+}
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -194,6 +257,36 @@ int main(int argc, char *argv[])
             return result;
         }
 
+        if (arg == "--background-from-recording" || arg == "-b") {
+            // Get the input and output files, and optionally the frames per minimum filter, from the next arguments
+            if (i + 2 >= argc) {
+                fprintf(stderr, "Error: --background-from-recording requires an input and an output file\n");
+                fprintf(stderr, "Usage: LAUBackgroundFilter --background-from-recording input.tif background.tif [frames]\n");
+                return 1;
+            }
+
+            int frames = 30;
+            if (i + 3 < argc) {
+                bool okay = false;
+                frames = QString::fromLocal8Bit(argv[i + 3]).toInt(&okay);
+                if (okay == false || frames < 1) {
+                    fprintf(stderr, "Error: frames must be a positive integer\n");
+                    return 1;
+                }
+            }
+
+            // Run in console mode - the CPU background filter needs no GUI or OpenGL context
+            QCoreApplication a(argc, argv);
+            a.setOrganizationName(QString("Lau Consulting Inc"));
+            a.setOrganizationDomain(QString("drhalftone.com"));
+            a.setApplicationName(QString("LAUBackgroundFilter"));
+
+            libtiff::TIFFSetErrorHandler(myTIFFErrorHandler);
+            libtiff::TIFFSetWarningHandler(myTIFFWarningHandler);
+
+            return backgroundFromRecording(QString::fromLocal8Bit(argv[i + 1]), QString::fromLocal8Bit(argv[i + 2]), frames);
+        }
+
         if (arg == "--set-camera-names" || arg == "-s") {
             // Get camera names from next argument
             if (i + 1 >= argc) {
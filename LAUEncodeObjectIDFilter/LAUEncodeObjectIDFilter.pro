@@ -1,4 +1,4 @@
-QT = core xml
+QT = core xml concurrent
 
 # Removed gui, widgets, opengl, openglwidgets
 # This is a console application and doesn't need GUI components
@@ -34,6 +34,9 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 #include "laumemoryobject.h"
 #include "lauobjecthashtable.h"
@@ -108,11 +111,6 @@ ValidationResult validatePathString(const QString &path, const QString &paramete
     return result;
 }
 
-bool LAUMemoryObject_LessThan(const LAUMemoryObject &s1, const LAUMemoryObject &s2)
-{
-    return (s1.elapsed() < s2.elapsed());
-}
-
 QByteArray createXMLStringWithObjectID(QByteArray inXml, const QString &objectID, int originalFrameOrder)
 {
     // GRAB THE CURRENT XML FIELD IN HASH TABLE FORM
@@ -173,15 +171,66 @@ QString findMostFrequentObjectID(const QStringList &objectIDs)
     return mostFrequent;
 }
 
+bool rewriteDataFile(LAUMemoryObjectReader &reader, const QList<int> &directories, const QList<QByteArray> &xmlPackets, QTextStream &log)
+{
+    // COPY THE REQUESTED DIRECTORIES, IN THE REQUESTED ORDER, TO A TEMPORARY FILE NEXT TO THE
+    // ORIGINAL SWAPPING IN THE NEW XML PACKETS BUT COPYING THE COMPRESSED PIXEL STRIPS AS IS
+    QString filePath = reader.filename();
+    QFileInfo fileInfo(filePath);
+    QString tempFilePath = fileInfo.dir().absoluteFilePath(QString(".%1.tmp").arg(fileInfo.fileName()));
+
+    libtiff::TIFF *outputTiff = libtiff::TIFFOpen(tempFilePath.toLocal8Bit(), "w");
+    if (!outputTiff) {
+        return false;
+    }
+
+    bool okay = true;
+    for (int frameNum = 0; frameNum < directories.count() && okay; frameNum++) {
+        okay = reader.copyDirectory(outputTiff, directories.at(frameNum), xmlPackets.at(frameNum));
+    }
+    TIFFClose(outputTiff);
+
+    // RELEASE THE INPUT FILE BEFORE REPLACING IT
+    reader.close();
+
+    // THE ORIGINAL IS UNTOUCHED SO FAR, SO A FAILED COPY ONLY LEAVES A TEMPORARY FILE TO CLEAN UP
+    if (!okay) {
+        QFile::remove(tempFilePath);
+        return false;
+    }
+
+    // MOVE THE ORIGINAL ASIDE, MOVE THE NEW FILE INTO ITS PLACE, AND ONLY THEN DROP THE ORIGINAL
+    // SO THAT A FAILURE AT ANY STEP LEAVES EITHER THE ORIGINAL OR THE NEW FILE ON DISK
+    QString backupFilePath = fileInfo.dir().absoluteFilePath(QString(".%1.bak").arg(fileInfo.fileName()));
+    QFile::remove(backupFilePath);
+    if (!QFile::rename(filePath, backupFilePath)) {
+        QFile::remove(tempFilePath);
+        return false;
+    }
+
+    if (!QFile::rename(tempFilePath, filePath)) {
+        // PUT THE ORIGINAL BACK, AND IF EVEN THAT FAILS KEEP BOTH FILES AND SAY WHERE THEY ARE
+        if (QFile::rename(backupFilePath, filePath)) {
+            QFile::remove(tempFilePath);
+        } else {
+            log << "  Error: Could not replace " << filePath << ", the original is at " << backupFilePath << " and the new file is at " << tempFilePath << "\n";
+        }
+        return false;
+    }
+
+    QFile::remove(backupFilePath);
+    return true;
+}
+
 bool undoDataFile(const QString &filePath, int &restoredCount, int &skippedCount)
 {
     console << "Undoing file: " << QFileInfo(QFileInfo(filePath).absolutePath()).fileName() << "/" << QFileInfo(filePath).fileName() << "\n";
     console.flush();
 
     try {
-        // Check if file has object ID metadata to remove
-        LAUMemoryObject firstFrame(filePath, 0);
-        QHash<QString, QString> metadata = LAUMemoryObject::xmlToHash(firstFrame.xml());
+        // Open the file once and check if it has object ID metadata to remove
+        LAUMemoryObjectReader reader(filePath);
+        QHash<QString, QString> metadata = LAUMemoryObject::xmlToHash(reader.xmlPacket(0));
 
         if (!metadata.contains("ObjectID") && !metadata.contains("OriginalFrameOrder")) {
             console << "  Skipping: No object ID metadata found\n";
@@ -190,19 +239,19 @@ bool undoDataFile(const QString &filePath, int &restoredCount, int &skippedCount
         }
 
         // Get number of frames
-        int numDirectories = LAUMemoryObject::howManyDirectoriesDoesThisTiffFileHave(filePath);
+        int numDirectories = reader.directories();
         if (numDirectories <= 1) {
             console << "  Warning: File has only " << numDirectories << " frames, skipping\n";
             skippedCount++;
             return false;
         }
 
-        // Load all frames with their original order information
-        QList<QPair<int, LAUMemoryObject>> frameOrder;
+        // Read each directory's XML packet with its original order information
+        QList<QPair<int, int>> frameOrder;
+        QList<QByteArray> xmlPackets;
 
         for (int frameNum = 0; frameNum < numDirectories; frameNum++) {
-            LAUMemoryObject frame(filePath, frameNum);
-            QHash<QString, QString> frameMeta = LAUMemoryObject::xmlToHash(frame.xml());
+            QHash<QString, QString> frameMeta = LAUMemoryObject::xmlToHash(reader.xmlPacket(frameNum));
 
             // Get original frame order if it exists, otherwise use current order
             int originalOrder = frameNum;
@@ -234,28 +283,25 @@ bool undoDataFile(const QString &filePath, int &restoredCount, int &skippedCount
             writer.writeEndDocument();
             buffer.close();
 
-            frame.setXML(xmlByteArray);
-            frameOrder.append(QPair<int, LAUMemoryObject>(originalOrder, frame));
+            xmlPackets.append(xmlByteArray);
+            frameOrder.append(QPair<int, int>(originalOrder, frameNum));
         }
 
-        // Sort frames back to original order
-        std::sort(frameOrder.begin(), frameOrder.end(),
-            [](const QPair<int, LAUMemoryObject> &a, const QPair<int, LAUMemoryObject> &b) {
-                return a.first < b.first;
-            });
+        // Sort directories back to original order
+        std::sort(frameOrder.begin(), frameOrder.end());
 
-        // Write frames back in original order
-        libtiff::TIFF *outputTiff = libtiff::TIFFOpen(filePath.toLocal8Bit(), "w");
-        if (!outputTiff) {
-            console << "  Error: Failed to open file for writing\n";
-            return false;
+        QList<int> directories;
+        QList<QByteArray> orderedPackets;
+        for (const QPair<int, int> &pair : frameOrder) {
+            directories << pair.second;
+            orderedPackets << xmlPackets.at(pair.second);
         }
 
-        for (int frameNum = 0; frameNum < frameOrder.count(); frameNum++) {
-            frameOrder[frameNum].second.save(outputTiff, frameNum);
+        // Write directories back in original order without re-encoding the pixel data
+        if (!rewriteDataFile(reader, directories, orderedPackets, console)) {
+            console << "  Error: Failed to write restored file\n";
+            return false;
         }
-
-        TIFFClose(outputTiff);
         restoredCount++;
         console << "  Success: Removed object ID metadata and restored original frame order\n";
         return true;
@@ -354,77 +400,64 @@ struct ProcessingResult {
     QString status; // "success", "duplicate", "bad_file", "already_processed", "error"
 };
 
-ProcessingResult processDataFileWithResult(const QString &filePath, const LAUObjectHashTable &rfidTable, QHash<QString, QString> &objectIDToFile, int &renamedCount, int &badFileCount)
+// RESULT OF THE READ-ONLY ANALYSIS OF A SINGLE DATA FILE, WHICH IS SAFE TO RUN ON ANY THREAD
+struct FileAnalysis {
+    QString filePath;
+    QString status; // "no_calibration", "has_object_id", "identified", "bad_file", "error"
+    QString objectID;
+    QString log;    // CONSOLE OUTPUT HELD BACK SO IT CAN BE PRINTED IN FILE ORDER
+};
+
+int defaultWorkerCount()
 {
-    console << "Processing file: " << QFileInfo(QFileInfo(filePath).absolutePath()).fileName() << "/" << QFileInfo(filePath).fileName() << "\n";
-    console.flush();
+    return qMax(1, QThread::idealThreadCount());
+}
+
+QString renamedFilePath(const QString &filePath, const QString &prefix)
+{
+    // Swap the "data" prefix for the given prefix (e.g., "data00023.tif" -> "noTag00023.tif")
+    QFileInfo fileInfo(filePath);
+    QString dataNumber = fileInfo.baseName().mid(4);
+    QString newFileName = QString("%1%2.%3").arg(prefix).arg(dataNumber).arg(fileInfo.suffix());
+    return fileInfo.dir().absoluteFilePath(newFileName);
+}
+
+FileAnalysis analyzeDataFile(const QString &filePath, const LAUObjectHashTable &rfidTable)
+{
+    FileAnalysis analysis;
+    analysis.filePath = filePath;
+    analysis.status = "error";
+
+    QTextStream log(&analysis.log);
+    log << "Processing file: " << QFileInfo(QFileInfo(filePath).absolutePath()).fileName() << "/" << QFileInfo(filePath).fileName() << "\n";
 
     try {
+        // OPEN THE FILE ONCE AND READ ONLY THE METADATA OF EACH DIRECTORY, NEVER THE PIXELS
+        LAUMemoryObjectReader reader(filePath);
+
         // CHECK IF FILE ALREADY HAS A OBJECT ID IN METADATA (FRAME 0)
-        LAUMemoryObject firstFrame(filePath, 0);
+        LAUMemoryObjectMetaData firstFrame = reader.metaData(0);
 
         // VALIDATE JETR VECTORS IN FIRST FRAME (BACKGROUND)
         // First frame should contain complete JETR calibration vectors from background
-        QVector<double> jetrVector = firstFrame.jetr();
+        QVector<double> jetrVector = firstFrame.jetr;
         if (jetrVector.isEmpty() || jetrVector.size() < LAU_JETR_VECTOR_SIZE) {
             // No valid JETR vectors found - this file was recorded without proper calibration
-            QFileInfo fileInfo(filePath);
-            QString fileName = fileInfo.baseName();
-            QString dataNumber = fileName.mid(4);
-            QString newFileName = QString("noCal%1.%2").arg(dataNumber).arg(fileInfo.suffix());
-            QString newFilePath = fileInfo.dir().absoluteFilePath(newFileName);
-
-            console << "  Warning: Missing or incomplete JETR calibration (" << jetrVector.size() << " elements), renaming to: " << newFileName << "\n";
-            console << "  (Hint: Run LAUBackgroundFilter to create calibration, then re-record videos)\n";
-
-            // Rename the file
-            ProcessingResult result;
-            QFile file(filePath);
-            if (file.rename(newFilePath)) {
-                badFileCount++;
-                console << "  Success: Renamed file with invalid JETR\n";
-                result.success = true;
-                result.status = "no_calibration";
-                result.newFilePath = newFilePath;
-            } else {
-                console << "  Error: Failed to rename file\n";
-                result.success = false;
-                result.status = "error";
-                result.newFilePath = filePath;
-            }
-            return result;
+            log << "  Warning: Missing or incomplete JETR calibration (" << jetrVector.size() << " elements), renaming to: " << QFileInfo(renamedFilePath(filePath, "noCal")).fileName() << "\n";
+            log << "  (Hint: Run LAUBackgroundFilter to create calibration, then re-record videos)\n";
+            analysis.status = "no_calibration";
+            return analysis;
         }
 
         // Validate JETR vector size is a multiple of LAU_JETR_VECTOR_SIZE (LAU_JETR_VECTOR_SIZE elements per camera)
         if (jetrVector.size() % LAU_JETR_VECTOR_SIZE != 0) {
-            QFileInfo fileInfo(filePath);
-            QString fileName = fileInfo.baseName();
-            QString dataNumber = fileName.mid(4);
-            QString newFileName = QString("noCal%1.%2").arg(dataNumber).arg(fileInfo.suffix());
-            QString newFilePath = fileInfo.dir().absoluteFilePath(newFileName);
-
             int numCameras = jetrVector.size() / LAU_JETR_VECTOR_SIZE;
             int remainder = jetrVector.size() % LAU_JETR_VECTOR_SIZE;
-            console << "  Warning: Invalid JETR vector size (" << jetrVector.size()
-                    << " elements = " << numCameras << " cameras + " << remainder
-                    << " extra), renaming to: " << newFileName << "\n";
-
-            // Rename the file
-            ProcessingResult result;
-            QFile file(filePath);
-            if (file.rename(newFilePath)) {
-                badFileCount++;
-                console << "  Success: Renamed file with malformed JETR\n";
-                result.success = true;
-                result.status = "no_calibration";
-                result.newFilePath = newFilePath;
-            } else {
-                console << "  Error: Failed to rename file\n";
-                result.success = false;
-                result.status = "error";
-                result.newFilePath = filePath;
-            }
-            return result;
+            log << "  Warning: Invalid JETR vector size (" << jetrVector.size()
+                << " elements = " << numCameras << " cameras + " << remainder
+                << " extra), renaming to: " << QFileInfo(renamedFilePath(filePath, "noCal")).fileName() << "\n";
+            analysis.status = "no_calibration";
+            return analysis;
         }
 
         // JETR size is valid - now check calibration quality for each camera
@@ -490,107 +523,47 @@ ProcessingResult processDataFileWithResult(const QString &filePath, const LAUObj
 
         // If calibration is incomplete, rename file
         if (!hasValidCalibration) {
-            QFileInfo fileInfo(filePath);
-            QString fileName = fileInfo.baseName();
-            QString dataNumber = fileName.mid(4);
-            QString newFileName = QString("noCal%1.%2").arg(dataNumber).arg(fileInfo.suffix());
-            QString newFilePath = fileInfo.dir().absoluteFilePath(newFileName);
-
-            console << "  Warning: Incomplete calibration - " << calibrationIssue << ", renaming to: " << newFileName << "\n";
-            console << "  (Hint: Load a sample video in LAUJetrStandalone to set transforms and bounding box)\n";
-
-            // Rename the file
-            ProcessingResult result;
-            QFile file(filePath);
-            if (file.rename(newFilePath)) {
-                badFileCount++;
-                console << "  Success: Renamed file with incomplete calibration\n";
-                result.success = true;
-                result.status = "no_calibration";
-                result.newFilePath = newFilePath;
-            } else {
-                console << "  Error: Failed to rename file\n";
-                result.success = false;
-                result.status = "error";
-                result.newFilePath = filePath;
-            }
-            return result;
+            log << "  Warning: Incomplete calibration - " << calibrationIssue << ", renaming to: " << QFileInfo(renamedFilePath(filePath, "noCal")).fileName() << "\n";
+            log << "  (Hint: Load a sample video in LAUJetrStandalone to set transforms and bounding box)\n";
+            analysis.status = "no_calibration";
+            return analysis;
         }
 
-        qDebug() << "  JETR validation passed:" << numCameras << "camera(s), calibrated with transforms and bounding boxes";
+        log << "  JETR validation passed: " << numCameras << " camera(s), calibrated with transforms and bounding boxes\n";
 
-        QHash<QString, QString> metadata = LAUMemoryObject::xmlToHash(firstFrame.xml());
+        QHash<QString, QString> metadata = LAUMemoryObject::xmlToHash(firstFrame.xml);
 
         if (metadata.contains("ObjectID") && !metadata["ObjectID"].isEmpty()) {
-            QString existingObjectID = metadata["ObjectID"].trimmed(); // Remove padding for comparison
-
-            // CHECK FOR DUPLICATES
-            if (objectIDToFile.contains(existingObjectID)) {
-                // This object ID was already processed by another file, rename this one
-                QFileInfo fileInfo(filePath);
-                QString fileName = fileInfo.baseName();
-                QString dataNumber = fileName.mid(4);
-                QString newFileName = QString("noTag%1.%2").arg(dataNumber).arg(fileInfo.suffix());
-                QString newFilePath = fileInfo.dir().absoluteFilePath(newFileName);
-
-                console << "  Info: Object ID " << existingObjectID << " already processed by " << QFileInfo(objectIDToFile[existingObjectID]).fileName() << "\n";
-                console << "  Renaming duplicate to: " << newFileName << "\n";
-                
-                ProcessingResult result;
-                QFile file(filePath);
-                if (file.rename(newFilePath)) {
-                    renamedCount++;
-                    console << "  Success: Renamed duplicate file\n";
-                    result.success = true;
-                    result.status = "duplicate";
-                    result.newFilePath = newFilePath;
-                    result.objectID = existingObjectID;
-                } else {
-                    console << "  Error: Failed to rename file\n";
-                    result.success = false;
-                    result.status = "error";
-                    result.newFilePath = filePath;
-                }
-                return result;
-            } else {
-                // Add to processed list and return immediately
-                objectIDToFile[existingObjectID] = filePath;
-                console << "  Info: File already has object ID " << existingObjectID << " in metadata, skipping\n";
-                ProcessingResult result;
-                result.success = true;
-                result.status = "already_processed";
-                result.objectID = existingObjectID;
-                result.newFilePath = filePath;
-                return result;
-            }
+            // Remove padding for comparison
+            analysis.objectID = metadata["ObjectID"].trimmed();
+            analysis.status = "has_object_id";
+            return analysis;
         }
-        // HOW MANY DIRECTORIES DOES THIS TIFF FILE HAVE
-        int numDirectories = LAUMemoryObject::howManyDirectoriesDoesThisTiffFileHave(filePath);
+
+        // FIND OUT HOW MANY DIRECTORIES IT HAS
+        int numDirectories = reader.directories();
         if (numDirectories <= 1) {
-            console << "  Warning: File has only " << numDirectories << " frames, skipping\n";
-            ProcessingResult result;
-            result.success = false;
-            result.status = "error";
-            result.newFilePath = filePath;
-            return result;
+            log << "  Warning: File has only " << numDirectories << " frames, skipping\n";
+            return analysis;
         }
 
-        // GENERATE A LIST OF VALID VIDEO FRAMES AND EXTRACT OBJECT IDs
+        // EXTRACT OBJECT IDs FROM THE VALID VIDEO FRAMES, ONLY KEEPING THE
+        // PREVIOUS FRAME'S ELAPSED TIME SO THAT WORKERS DON'T HOLD WHOLE RECORDINGS
         QStringList objectIDs;
-        QList<LAUMemoryObject> frames;
+        unsigned int lastElapsed = 0;
         bool headerFrame = false;
 
         for (int frameNum = 0; frameNum < numDirectories; frameNum++) {
-            // LOAD THE CURRENT FRAME OF VIDEO FROM DISK
-            LAUMemoryObject frame(filePath, frameNum);
+            // READ THE METADATA OF THE NEXT FRAME OF VIDEO FROM THE ALREADY OPEN FILE
+            LAUMemoryObjectMetaData frame = reader.metaData(frameNum);
 
-            // ALWAYS KEEP THE FIRST FRAME OF VIDEO OTHERWISE ONLY KEEP IF VALID
+            // ALWAYS SKIP THE FIRST FRAME OF VIDEO OTHERWISE ONLY KEEP IF VALID
             if (frameNum > 0 && !headerFrame) {
-                if (frame.elapsed() < frames.last().elapsed()) {
+                if (frame.elapsed < lastElapsed) {
                     headerFrame = true;
                 } else {
                     // Extract object ID from RFID
-                    QString rfid = frame.rfid();
+                    QString rfid = frame.rfid;
                     int objectIndex = rfidTable.id(rfid);
                     QString objectID;
 
@@ -607,149 +580,223 @@ ProcessingResult processDataFileWithResult(const QString &filePath, const LAUObj
                     }
                 }
             }
-            frames << frame;
+            lastElapsed = frame.elapsed;
         }
 
+        // RELEASE THE INPUT FILE SO IT CAN BE RENAMED OR OVERWRITTEN LATER
+        reader.close();
+
         // CHECK IF WE HAVE ENOUGH VALID OBJECT ID READINGS
         if (objectIDs.count() < 5) {
-            // Extract the data number from the current file (e.g., "00023" from "data00023.tif")
-            QFileInfo fileInfo(filePath);
-            QString fileName = fileInfo.baseName(); // "data00023"
-            QString dataNumber = fileName.mid(4); // "00023"
-            
-            // Create new filename: badFile00023.tif
-            QString newFileName = QString("badFile%1.%2").arg(dataNumber).arg(fileInfo.suffix());
-            QString newFilePath = fileInfo.dir().absoluteFilePath(newFileName);
-            
-            console << "  Warning: Not enough valid object ID readings (" << objectIDs.count() << "), renaming to: " << newFileName << "\n";
-            
-            // Rename the file
-            ProcessingResult result;
-            QFile file(filePath);
-            if (file.rename(newFilePath)) {
-                badFileCount++;
-                console << "  Success: Renamed bad file\n";
-                result.success = true;
-                result.status = "bad_file";
-                result.newFilePath = newFilePath;
-            } else {
-                console << "  Error: Failed to rename bad file\n";
-                result.success = false;
-                result.status = "error";
-                result.newFilePath = filePath;
-            }
-            return result;
+            log << "  Warning: Not enough valid object ID readings (" << objectIDs.count() << "), renaming to: " << QFileInfo(renamedFilePath(filePath, "badFile")).fileName() << "\n";
+            analysis.status = "bad_file";
+            return analysis;
         }
 
         // FIND THE MOST FREQUENT OBJECT ID (MODE)
-        QString finalObjectID = findMostFrequentObjectID(objectIDs);
-        if (finalObjectID.isEmpty()) {
-            console << "  Warning: Could not determine object ID, skipping\n";
-            ProcessingResult result;
-            result.success = false;
-            result.status = "error";
-            result.newFilePath = filePath;
-            return result;
+        analysis.objectID = findMostFrequentObjectID(objectIDs);
+        if (analysis.objectID.isEmpty()) {
+            log << "  Warning: Could not determine object ID, skipping\n";
+            return analysis;
         }
 
-        // CHECK FOR DUPLICATES
-        if (objectIDToFile.contains(finalObjectID)) {
-            // Extract the data number from the current file (e.g., "00042" from "data00042.tif")
-            QFileInfo fileInfo(filePath);
-            QString fileName = fileInfo.baseName(); // "data00042"
-            QString dataNumber = fileName.mid(4); // "00042"
-
-            // Create new filename: noTag00042.tif
-            QString newFileName = QString("noTag%1.%2").arg(dataNumber).arg(fileInfo.suffix());
-            QString newFilePath = fileInfo.dir().absoluteFilePath(newFileName);
+        analysis.status = "identified";
+        return analysis;
 
-            console << "  Info: Object ID " << finalObjectID << " already processed by " << QFileInfo(objectIDToFile[finalObjectID]).fileName() << "\n";
-            console << "  Renaming duplicate to: " << newFileName << "\n";
+    } catch (const std::exception &e) {
+        log << "  Error: " << e.what() << "\n";
+        analysis.status = "error";
+        return analysis;
+    }
+}
 
-            // Rename the file
-            ProcessingResult result;
-            QFile file(filePath);
-            if (file.rename(newFilePath)) {
+ProcessingResult renameDataFile(const QString &filePath, const QString &prefix, const QString &status, const QString &description)
+{
+    ProcessingResult result;
+    QString newFilePath = renamedFilePath(filePath, prefix);
+
+    QFile file(filePath);
+    if (file.rename(newFilePath)) {
+        console << "  Success: Renamed " << description << "\n";
+        result.success = true;
+        result.status = status;
+        result.newFilePath = newFilePath;
+    } else {
+        console << "  Error: Failed to rename " << (status == "bad_file" ? "bad file" : "file") << "\n";
+        result.success = false;
+        result.status = "error";
+        result.newFilePath = filePath;
+    }
+    return result;
+}
+
+ProcessingResult resolveDataFile(const FileAnalysis &analysis, QHash<QString, QString> &objectIDToFile, int &renamedCount, int &badFileCount)
+{
+    // THIS RUNS ON THE MAIN THREAD IN FILE NAME ORDER SO THE FIRST FILE TO CLAIM
+    // AN OBJECT ID ALWAYS KEEPS IT, NO MATTER HOW MANY WORKERS ANALYZED THE FILES
+    console << analysis.log;
+
+    ProcessingResult result;
+    result.newFilePath = analysis.filePath;
+    result.status = "error";
+
+    if (analysis.status == "no_calibration") {
+        result = renameDataFile(analysis.filePath, "noCal", "no_calibration", "file with invalid calibration");
+        if (result.success) {
+            badFileCount++;
+        }
+    } else if (analysis.status == "bad_file") {
+        result = renameDataFile(analysis.filePath, "badFile", "bad_file", "bad file");
+        if (result.success) {
+            badFileCount++;
+        }
+    } else if (analysis.status == "has_object_id" || analysis.status == "identified") {
+        // CHECK FOR DUPLICATES
+        if (objectIDToFile.contains(analysis.objectID)) {
+            console << "  Info: Object ID " << analysis.objectID << " already processed by " << QFileInfo(objectIDToFile[analysis.objectID]).fileName() << "\n";
+            console << "  Renaming duplicate to: " << QFileInfo(renamedFilePath(analysis.filePath, "noTag")).fileName() << "\n";
+
+            result = renameDataFile(analysis.filePath, "noTag", "duplicate", "duplicate file");
+            if (result.success) {
                 renamedCount++;
-                console << "  Success: Renamed duplicate file\n";
-                result.success = true;
-                result.status = "duplicate";
-                result.objectID = finalObjectID;
-                result.newFilePath = newFilePath;
+                result.objectID = analysis.objectID;
+            }
+        } else {
+            // MARK THIS OBJECT ID AS PROCESSED AND TRACK THE FILE
+            objectIDToFile[analysis.objectID] = analysis.filePath;
+            result.success = true;
+            result.objectID = analysis.objectID;
+
+            if (analysis.status == "has_object_id") {
+                console << "  Info: File already has object ID " << analysis.objectID << " in metadata, skipping\n";
+                result.status = "already_processed";
             } else {
-                console << "  Error: Failed to rename file\n";
-                result.success = false;
-                result.status = "error";
-                result.newFilePath = filePath;
+                // Show whether object ID is from mapping or raw RFID (before padding)
+                if (analysis.objectID.length() > 10) {
+                    // Likely a raw RFID tag (they are typically 15+ digits)
+                    console << "  Identified object ID (RFID tag): " << analysis.objectID << " (will be padded to 15 digits)\n";
+                } else {
+                    console << "  Identified object ID: " << analysis.objectID << " (will be padded to 15 digits)\n";
+                }
+                result.status = "success";
             }
-            return result;
         }
+    }
+    console.flush();
 
-        // MARK THIS OBJECT ID AS PROCESSED AND TRACK THE FILE
-        objectIDToFile[finalObjectID] = filePath;
+    return result;
+}
 
-        // Show whether object ID is from mapping or raw RFID (before padding)
-        if (finalObjectID.length() > 10) {
-            // Likely a raw RFID tag (they are typically 15+ digits)
-            console << "  Identified object ID (RFID tag): " << finalObjectID << " (will be padded to 15 digits)\n";
-        } else {
-            console << "  Identified object ID: " << finalObjectID << " (will be padded to 15 digits)\n";
-        }
+bool encodeDataFile(const QString &filePath, const QString &objectID, QString &logString)
+{
+    QTextStream log(&logString);
+    log << "Encoding file: " << QFileInfo(QFileInfo(filePath).absolutePath()).fileName() << "/" << QFileInfo(filePath).fileName() << "\n";
 
-        // ADD OBJECT ID AND ORIGINAL FRAME ORDER TO ALL FRAMES
-        for (int frameNum = 0; frameNum < frames.count(); frameNum++) {
-            LAUMemoryObject &frame = frames[frameNum];
-            QByteArray newXml = createXMLStringWithObjectID(frame.xml(), finalObjectID, frameNum);
-            frame.setXML(newXml);
+    try {
+        // OPEN THE FILE ONCE AND FIND OUT HOW MANY DIRECTORIES IT HAS
+        LAUMemoryObjectReader reader(filePath);
+        int numDirectories = reader.directories();
+        if (numDirectories <= 1) {
+            log << "  Error: File has only " << numDirectories << " frames\n";
+            return false;
         }
 
-        // SORT FRAMES IN CHRONOLOGICAL ORDER ACCORDING TO THE ELAPSED TIME
-        std::sort(frames.begin(), frames.end(), LAUMemoryObject_LessThan);
-
-        // OPEN OUTPUT TIFF FILE (OVERWRITE ORIGINAL)
-        libtiff::TIFF *outputTiff = libtiff::TIFFOpen(filePath.toLocal8Bit(), "w");
-        if (!outputTiff) {
-            console << "  Error: Failed to open file for writing\n";
-            ProcessingResult result;
-            result.success = false;
-            result.status = "error";
-            result.newFilePath = filePath;
-            return result;
+        // ADD OBJECT ID AND ORIGINAL FRAME ORDER TO EVERY DIRECTORY'S XML PACKET
+        QList<QPair<unsigned int, int>> frameOrder;
+        QList<QByteArray> xmlPackets;
+        for (int frameNum = 0; frameNum < numDirectories; frameNum++) {
+            LAUMemoryObjectMetaData frame = reader.metaData(frameNum);
+            xmlPackets << createXMLStringWithObjectID(frame.xml, objectID, frameNum);
+            frameOrder << QPair<unsigned int, int>(frame.elapsed, frameNum);
         }
 
-        // WRITE THE FRAMES OUT TO DISK IN CHRONOLOGICAL ORDER
-        for (int frameNum = 0; frameNum < frames.count(); frameNum++) {
-            frames.at(frameNum).save(outputTiff, frameNum);
+        // SORT DIRECTORIES IN CHRONOLOGICAL ORDER ACCORDING TO THE ELAPSED TIME,
+        // BREAKING TIES BY THE ORIGINAL DIRECTORY INDEX
+        std::sort(frameOrder.begin(), frameOrder.end());
+
+        QList<int> directories;
+        QList<QByteArray> orderedPackets;
+        for (const QPair<unsigned int, int> &pair : frameOrder) {
+            directories << pair.second;
+            orderedPackets << xmlPackets.at(pair.second);
         }
 
-        // CLOSE THE TIFF FILE
-        TIFFClose(outputTiff);
+        // OVERWRITE THE ORIGINAL WITHOUT DECODING OR RE-ENCODING ANY PIXEL DATA
+        if (!rewriteDataFile(reader, directories, orderedPackets, log)) {
+            log << "  Error: Failed to write encoded file\n";
+            return false;
+        }
 
-        console << "  Success: Encoded object ID " << finalObjectID << " and reordered " << frames.count() << " frames\n";
-        ProcessingResult result;
-        result.success = true;
-        result.status = "success";
-        result.objectID = finalObjectID;
-        result.newFilePath = filePath;
-        return result;
+        log << "  Success: Encoded object ID " << objectID << " and reordered " << numDirectories << " frames\n";
+        return true;
 
     } catch (const std::exception &e) {
-        console << "  Error: " << e.what() << "\n";
-        ProcessingResult result;
-        result.success = false;
-        result.status = "error";
-        result.newFilePath = filePath;
-        return result;
+        log << "  Error: " << e.what() << "\n";
+        return false;
     }
 }
 
-bool processDataFile(const QString &filePath, const LAUObjectHashTable &rfidTable, QHash<QString, QString> &objectIDToFile, int &renamedCount, int &badFileCount)
+QList<ProcessingResult> processDataFilesWithResults(const QStringList &filePaths, const LAUObjectHashTable &rfidTable, QHash<QString, QString> &objectIDToFile, int &renamedCount, int &badFileCount, int workers)
 {
-    ProcessingResult result = processDataFileWithResult(filePath, rfidTable, objectIDToFile, renamedCount, badFileCount);
-    return result.success;
+    // QT 5 HAS NO BLOCKINGMAP OVERLOAD THAT TAKES ITS OWN POOL, SO SIZE THE GLOBAL POOL FOR THE WORKERS
+    QThreadPool::globalInstance()->setMaxThreadCount(qMax(1, workers));
+
+    // STEP 1: ANALYZE EVERY FILE IN PARALLEL WITHOUT TOUCHING THE FILE SYSTEM
+    QList<FileAnalysis> analyses;
+    for (const QString &filePath : filePaths) {
+        FileAnalysis analysis;
+        analysis.filePath = filePath;
+        analyses << analysis;
+    }
+
+    if (workers > 1) {
+        QtConcurrent::blockingMap(analyses, [&rfidTable](FileAnalysis &analysis) {
+            analysis = analyzeDataFile(analysis.filePath, rfidTable);
+        });
+    } else {
+        for (FileAnalysis &analysis : analyses) {
+            analysis = analyzeDataFile(analysis.filePath, rfidTable);
+        }
+    }
+
+    // STEP 2: RESOLVE DUPLICATES AND RENAME FILES SERIALLY IN FILE NAME ORDER
+    QList<ProcessingResult> results;
+    QList<int> encodeIndices;
+    for (int n = 0; n < analyses.count(); n++) {
+        results << resolveDataFile(analyses.at(n), objectIDToFile, renamedCount, badFileCount);
+        if (results.last().status == "success") {
+            encodeIndices << n;
+        }
+    }
+
+    // STEP 3: REWRITE EACH NEWLY IDENTIFIED FILE IN PARALLEL SINCE NO TWO SHARE A PATH
+    QVector<QString> logs(results.count());
+    QVector<bool> encoded(results.count(), false);
+    auto encode = [&](const int &n) {
+        encoded[n] = encodeDataFile(results.at(n).newFilePath, results.at(n).objectID, logs[n]);
+    };
+
+    if (workers > 1) {
+        QtConcurrent::blockingMap(encodeIndices, encode);
+    } else {
+        for (const int &n : encodeIndices) {
+            encode(n);
+        }
+    }
+
+    for (const int &n : encodeIndices) {
+        console << logs.at(n);
+        if (!encoded.at(n)) {
+            results[n].success = false;
+            results[n].status = "error";
+        }
+    }
+    console.flush();
+
+    return results;
 }
 
-int processManifestMode(const QString &manifestPath, const QString &rfidMappingFile, bool dryRun = false)
+int processManifestMode(const QString &manifestPath, const QString &rfidMappingFile, bool dryRun = false, int workers = defaultWorkerCount())
 {
     // Load manifest JSON file
     QFile file(manifestPath);
@@ -881,7 +928,7 @@ int processManifestMode(const QString &manifestPath, const QString &rfidMappingF
 
         console << "\n========================================\n";
         console << "Processing Strategy:\n";
-        console << "  1. Each directory would be processed sequentially\n";
+        console << "  1. Each directory would be processed with " << workers << " worker(s)\n";
         console << "  2. All data*.tif files would be analyzed for RFID\n";
         console << "  3. Files with < 5 valid RFID readings would be renamed to badFile#####.tif\n";
         console << "  4. Duplicate object IDs would be renamed to noTag#####.tif\n";
@@ -933,7 +980,11 @@ int processManifestMode(const QString &manifestPath, const QString &rfidMappingF
     int totalBadFiles = 0;
     QHash<QString, ProcessingResult> fileResults; // Map original file path to result
 
-    foreach (const QString &dirPath, directoriesToProcess) {
+    // SORT DIRECTORIES SO THE PROCESSING ORDER DOES NOT DEPEND ON HASH ORDER
+    QList<QString> sortedDirectories = directoriesToProcess.values();
+    std::sort(sortedDirectories.begin(), sortedDirectories.end());
+
+    for (const QString &dirPath : sortedDirectories) {
         console << "\nProcessing directory: " << dirPath << "\n";
         console << "========================================\n";
 
@@ -954,11 +1005,17 @@ int processManifestMode(const QString &manifestPath, const QString &rfidMappingF
         int renamedCount = 0;
         int badFileCount = 0;
 
+        QStringList filePaths;
         for (const QFileInfo &fileInfo : fileList) {
-            ProcessingResult result = processDataFileWithResult(fileInfo.absoluteFilePath(), rfidTable, objectIDToFile, renamedCount, badFileCount);
+            filePaths << fileInfo.absoluteFilePath();
+        }
+
+        QList<ProcessingResult> results = processDataFilesWithResults(filePaths, rfidTable, objectIDToFile, renamedCount, badFileCount, workers);
+        for (int n = 0; n < results.count(); n++) {
+            const ProcessingResult &result = results.at(n);
 
             // Store result for manifest updating
-            fileResults[fileInfo.absoluteFilePath()] = result;
+            fileResults[filePaths.at(n)] = result;
 
             if (result.success) {
                 successCount++;
@@ -1074,9 +1131,28 @@ int main(int argc, char *argv[])
     libtiff::TIFFSetErrorHandler(myTIFFErrorHandler);
     libtiff::TIFFSetWarningHandler(myTIFFWarningHandler);
 
+    // PULL THE WORKER COUNT OUT OF THE ARGUMENT LIST SO THE REMAINING ARGUMENTS KEEP THEIR POSITIONS
+    QStringList arguments;
+    int workers = defaultWorkerCount();
+    for (int n = 0; n < argc; n++) {
+        QString argument = QString::fromUtf8(argv[n]);
+        if (argument == "--jobs" || argument == "-j") {
+            bool okay = false;
+            int value = (n + 1 < argc) ? QString::fromUtf8(argv[++n]).toInt(&okay) : 0;
+            if (!okay || value < 1 || value > 1024) {
+                console << "Error: --jobs expects a worker count between 1 and 1024\n";
+                return 1;
+            }
+            workers = value;
+        } else {
+            arguments << argument;
+        }
+    }
+    argc = arguments.count();
+
     // CHECK FOR HELP ARGUMENT FIRST
     if (argc >= 2) {
-        QString arg1 = QString::fromUtf8(argv[1]);
+        QString arg1 = arguments.at(1);
         if (arg1 == "-h" || arg1 == "--help" || arg1 == "-?" || arg1.toLower() == "help") {
             console << "LAUEncodeObjectIDFilter - Object ID Metadata Encoding Tool\n";
             console << "========================================================\n";
@@ -1094,7 +1170,8 @@ int main(int argc, char *argv[])
             console << "  Directory mode:  LAUEncodeObjectIDFilter <directory_path> [rfid_mapping.csv]\n";
             console << "  Manifest mode:   LAUEncodeObjectIDFilter --manifest <manifest.json> [rfid_mapping.csv]\n";
             console << "  Dry-run mode:    LAUEncodeObjectIDFilter --dry-run --manifest <manifest.json> [rfid_mapping.csv]\n";
-            console << "  Undo mode:       LAUEncodeObjectIDFilter --undo <directory_path>\n\n";
+            console << "  Undo mode:       LAUEncodeObjectIDFilter --undo <directory_path>\n";
+            console << "  Any mode above accepts --jobs <count> to set the number of worker threads\n\n";
             console << "ARGUMENTS:\n";
             console << "  directory_path    Directory containing data####.tif files to process\n";
             console << "                    Must be an existing directory\n";
@@ -1108,6 +1185,9 @@ int main(int argc, char *argv[])
             console << "                    Shows detailed preview of what would be done\n\n";
             console << "  --undo            Remove object ID metadata and restore original frame order\n";
             console << "                    Renames noTag*.tif, badFile*.tif, and noCal*.tif back to data*.tif\n\n";
+            console << "  --jobs, -j count  Number of files to process concurrently (1 to 1024)\n";
+            console << "                    Defaults to the number of CPU cores (" << defaultWorkerCount() << ")\n";
+            console << "                    Renames and object ID assignments are identical for any count\n\n";
             console << "PROCESSING BEHAVIOR:\n";
             console << "  - Analyzes RFID readings from video frames\n";
             console << "  - Requires minimum 5 valid RFID readings per file\n";
@@ -1207,7 +1287,7 @@ int main(int argc, char *argv[])
     int argIndex = 1;
 
     // Check for --dry-run flag
-    if (QString::fromUtf8(argv[argIndex]) == "--dry-run") {
+    if (arguments.at(argIndex) == "--dry-run") {
         dryRun = true;
         argIndex++;
         if (argc <= argIndex) {
@@ -1217,7 +1297,7 @@ int main(int argc, char *argv[])
     }
 
     // Check for --undo flag
-    if (QString::fromUtf8(argv[argIndex]) == "--undo") {
+    if (arguments.at(argIndex) == "--undo") {
         undoMode = true;
         argIndex++;
         if (argc <= argIndex) {
@@ -1226,7 +1306,7 @@ int main(int argc, char *argv[])
         }
 
         // VALIDATE DIRECTORY PATH
-        QString directoryPath = QString::fromUtf8(argv[argIndex]);
+        QString directoryPath = arguments.at(argIndex);
         ValidationResult validation = validatePathString(directoryPath, "directory path", true, true);
         if (!validation.valid) {
             console << validation.errorMessage << "\n";
@@ -1236,7 +1316,7 @@ int main(int argc, char *argv[])
         return undoDirectoryProcessing(directoryPath);
     }
 
-    QString firstArg = QString::fromUtf8(argv[argIndex]);
+    QString firstArg = arguments.at(argIndex);
     if (firstArg == "--manifest") {
         // MANIFEST MODE
         argIndex++;
@@ -1246,7 +1326,7 @@ int main(int argc, char *argv[])
         }
 
         // VALIDATE MANIFEST PATH
-        QString manifestPath = QString::fromUtf8(argv[argIndex]);
+        QString manifestPath = arguments.at(argIndex);
         ValidationResult validation = validatePathString(manifestPath, "manifest path", false, false);
         if (!validation.valid) {
             console << validation.errorMessage << "\n";
@@ -1256,7 +1336,7 @@ int main(int argc, char *argv[])
         QString rfidMappingFile;
         argIndex++;
         if (argc > argIndex) {
-            rfidMappingFile = QString::fromUtf8(argv[argIndex]);
+            rfidMappingFile = arguments.at(argIndex);
 
             // VALIDATE RFID MAPPING FILE PATH
             ValidationResult rfidValidation = validatePathString(rfidMappingFile, "RFID mapping file", false, false);
@@ -1266,7 +1346,7 @@ int main(int argc, char *argv[])
             }
         }
 
-        return processManifestMode(manifestPath, rfidMappingFile, dryRun);
+        return processManifestMode(manifestPath, rfidMappingFile, dryRun, workers);
     }
 
     if (dryRun) {
@@ -1288,7 +1368,7 @@ int main(int argc, char *argv[])
     // GET RFID MAPPING FILE
     QString rfidMappingFile;
     if (argc >= 3) {
-        rfidMappingFile = QString::fromUtf8(argv[2]);
+        rfidMappingFile = arguments.at(2);
 
         // VALIDATE RFID MAPPING FILE PATH
         ValidationResult rfidValidation = validatePathString(rfidMappingFile, "RFID mapping file", false, false);
@@ -1331,7 +1411,7 @@ int main(int argc, char *argv[])
         return 3;
     }
 
-    console << "Found " << fileList.count() << " data files to process\n\n";
+    console << "Found " << fileList.count() << " data files to process with " << workers << " worker(s)\n\n";
 
     // PROCESS EACH FILE
     QHash<QString, QString> objectIDToFile; // Map object ID to first file that had it
@@ -1340,10 +1420,14 @@ int main(int argc, char *argv[])
     int renamedCount = 0;
     int badFileCount = 0;
 
+    QStringList filePaths;
     for (const QFileInfo &fileInfo : fileList) {
-        bool success = processDataFile(fileInfo.absoluteFilePath(), rfidTable, objectIDToFile, renamedCount, badFileCount);
+        filePaths << fileInfo.absoluteFilePath();
+    }
 
-        if (success) {
+    QList<ProcessingResult> results = processDataFilesWithResults(filePaths, rfidTable, objectIDToFile, renamedCount, badFileCount, workers);
+    for (const ProcessingResult &result : results) {
+        if (result.success) {
             successCount++;
         } else {
             skipCount++;
@@ -1,5 +1,6 @@
 CONFIG  += cascade
 CONFIG  += lucid
+CONFIG  += replay
 CONFIG  += orbbec
 
 QT      += core gui serialport widgets opengl openglwidgets xml concurrent network
@@ -116,6 +117,12 @@ lucid {
     SOURCES     += ../LAUSupportFiles/Sources/laulucidcamera.cpp
 }
 
+replay {
+    DEFINES     += REPLAY
+    HEADERS     += ../LAUSupportFiles/Sources/laureplaycamera.h
+    SOURCES     += ../LAUSupportFiles/Sources/laureplaycamera.cpp
+}
+
 orbbec {
     DEFINES     += ORBBEC
     HEADERS     += ../LAUSupportFiles/Sources/lauorbbeccamera.h
@@ -15,6 +15,8 @@ TEMPLATE = subdirs
 #   7. LAUOnTrakWidget            - USB relay control for camera power cycling
 #   8. LAU3DVideoCalibrator       - JETR calibration vector editor for camera setup
 #   9. LAUInstallerPalette        - Central hub for managing tools (setup assistant)
+#
+# The tests subdirectory holds the QTest projects, run them with "make check"
 # ============================================================================
 
 # Define the subprojects
@@ -27,7 +29,8 @@ SUBDIRS += \
     LAURemoteToolsScheduler/LAURemoteToolsScheduler.pro \
     LAUOnTrakWidget/LAUOnTrakWidget.pro \
     LAU3DVideoCalibrator/LAU3DVideoCalibrator.pro \
-    LAUInstallerPalette/LAUInstallerPalette.pro
+    LAUInstallerPalette/LAUInstallerPalette.pro \
+    tests/tests.pro
 
 # Optional: Define dependencies between projects if needed
 # LAUMonitorLiveVideo.depends = LAU3DVideoInspector/LAU3DVideoInspector.pro
@@ -46,7 +46,7 @@
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-LAUCascadeClassifierFromLiveVideo::LAUCascadeClassifierFromLiveVideo(QWidget *parent) : QDialog(parent), shutDownFlag(false), filterCount(0), sensorCount(0), cameraCount(0), directoryString(QString()), rfidHashTable(nullptr), rfidObject(nullptr), saveToDiskFilter(nullptr), dataFileCount(-1), callCount(0), monitoringStarted(false), channel(0)
+LAUCascadeClassifierFromLiveVideo::LAUCascadeClassifierFromLiveVideo(QWidget *parent) : QDialog(parent), shutDownFlag(false), filterCount(0), sensorCount(0), cameraCount(0), directoryString(QString()), rfidHashTable(nullptr), rfidObject(nullptr), saveToDiskFilter(nullptr), dataFileCount(-1), callCount(0), monitoringStarted(false), channel(0), framesInFlightCount(0)
 {
     this->setLayout(new QVBoxLayout());
     this->layout()->setContentsMargins(0, 0, 0, 0);
@@ -109,7 +109,7 @@ LAUCascadeClassifierFromLiveVideo::LAUCascadeClassifierFromLiveVideo(QWidget *pa
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-LAUCascadeClassifierFromLiveVideo::LAUCascadeClassifierFromLiveVideo(QString dirString, int threshold, QWidget *parent) : QDialog(parent), shutDownFlag(false), filterCount(0), sensorCount(0), cameraCount(0), directoryString(dirString), rfidHashTable(nullptr), rfidObject(nullptr), saveToDiskFilter(nullptr), dataFileCount(-1), callCount(0), monitoringStarted(false), channel(0)
+LAUCascadeClassifierFromLiveVideo::LAUCascadeClassifierFromLiveVideo(QString dirString, int threshold, QWidget *parent) : QDialog(parent), shutDownFlag(false), filterCount(0), sensorCount(0), cameraCount(0), directoryString(dirString), rfidHashTable(nullptr), rfidObject(nullptr), saveToDiskFilter(nullptr), dataFileCount(-1), callCount(0), monitoringStarted(false), channel(0), framesInFlightCount(0)
 {
     Q_UNUSED(threshold);
     this->setLayout(new QVBoxLayout());
@@ -350,19 +350,11 @@ LAUCascadeClassifierFromLiveVideo::LAUCascadeClassifierFromLiveVideo(QString dir
         logFile.open(QIODevice::Append);
         logTS.setDevice(&logFile);
 
-        // ALLOCATE MEMORY OBJECTS TO HOLD INCOMING VIDEO FRAMES
-        for (int n = 0; n < NUMFRAMESINBUFFER; n++) {
-            LAUModalityObject frame;
-            frame.depth = LAUMemoryObject(cameras.first()->width(), cameras.first()->height(), 1, sizeof(unsigned short), sensorCount);
-            frame.depth.setJetr(jetr);
-#if defined(RECORDRAWVIDEOTODISK) && defined(ORBBEC)
-            frame.color = cameras.last()->colorMemoryObject();
-#else
-            frame.color = LAUMemoryObject();
-#endif
-            frame.mappi = LAUMemoryObject();
-            framesList << frame;
-        }
+        // ALLOCATE MEMORY OBJECTS TO HOLD INCOMING VIDEO FRAMES WHERE THE NUMBER OF
+        // FRAME SETS IN FLIGHT COMES FROM THE SETTINGS SO THAT A SLOW SAVE OR CLASSIFIER
+        // PASS ONLY THROTTLES ITS OWN STAGE INSTEAD OF THE WHOLE ACQUISITION LOOP
+        framesJetr = jetr;
+        setFramesInFlight(QSettings().value("LAUCascadeClassifierFromLiveVideo::framesInFlight", NUMFRAMESINBUFFER).toInt());
 
         // CREATE A GLWIDGET TO DISPLAY GRAYSCALE VIDEO
         LAU3DVideoGLWidget *glWidget;
@@ -503,6 +495,57 @@ LAUCascadeClassifierFromLiveVideo::~LAUCascadeClassifierFromLiveVideo()
     }
 }
 
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUModalityObject LAUCascadeClassifierFromLiveVideo::allocateFrame() const
+{
+    LAUModalityObject frame;
+    frame.depth = LAUMemoryObject(cameras.first()->width(), cameras.first()->height(), 1, sizeof(unsigned short), sensorCount);
+    frame.depth.setJetr(framesJetr);
+
+    // CARRY THE CAMERA'S MAKE AND MODEL IN THE XML PACKET SO A REPLAY CAN REBUILD THE SAME LOOK UP TABLE
+    QHash<QString, QString> hashTable;
+    hashTable["make"] = cameras.first()->make();
+    hashTable["model"] = cameras.first()->model();
+    frame.depth.setXML(LAUMemoryObject::hashToXml(hashTable));
+#if defined(RECORDRAWVIDEOTODISK) && defined(ORBBEC)
+    frame.color = cameras.last()->colorMemoryObject();
+#else
+    frame.color = LAUMemoryObject();
+#endif
+    frame.mappi = LAUMemoryObject();
+    return (frame);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUCascadeClassifierFromLiveVideo::setFramesInFlight(int count)
+{
+    // WE CAN ONLY RESIZE THE POOL BEFORE THE FIRST FRAMES HAVE BEEN HANDED TO THE CAMERA
+    if (monitoringStarted || cameras.isEmpty()) {
+        qDebug() << "LAUCascadeClassifierFromLiveVideo :: cannot change frames in flight once streaming has started";
+        return;
+    }
+
+    // KEEP THE NUMBER OF FRAME SETS WITHIN A SENSIBLE RANGE
+    count = qMax(1, qMin(count, MAXFRAMESINFLIGHT));
+
+    // GROW OR SHRINK THE LIST OF FRAME SETS WAITING TO BE SENT TO THE CAMERA
+    while (framesList.count() < count) {
+        framesList << allocateFrame();
+    }
+    while (framesList.count() > count) {
+        framesList.removeLast();
+    }
+    framesInFlightCount = count;
+
+    // SAVE THE SETTING FOR THE NEXT TIME THE APPLICATION IS RUN
+    QSettings settings;
+    settings.setValue("LAUCascadeClassifierFromLiveVideo::framesInFlight", framesInFlightCount);
+}
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -593,7 +636,10 @@ void LAUCascadeClassifierFromLiveVideo::onUpdateBuffer(LAUMemoryObject depth, LA
         framesList << frame;
     }
 
-    // EMIT THE SIGNAL TO TELL THE FRAME GRABBER TO GRAB THE NEXT SET OF FRAMES
+    // EMIT THE SIGNAL TO TELL THE FRAME GRABBER TO GRAB THE NEXT SET OF FRAMES, ON THE
+    // FIRST CALL THIS PRIMES THE PIPELINE WITH EVERY FRAME SET IN THE POOL AND AFTER
+    // THAT EACH RETURNING FRAME SET IS SENT STRAIGHT BACK TO THE CAMERA SO THAT ALL
+    // STAGES STAY BUSY AND THROUGHPUT TRACKS THE SLOWEST STAGE
     while (framesList.isEmpty() == false) {
         // GET THE NEXT AVAILABLE FRAME BUFFER FROM OUR BUFFER LIST
         LAUModalityObject frame = framesList.takeFirst();
@@ -627,7 +673,16 @@ void LAUCascadeClassifierFromLiveVideo::checkFrameRate()
     double callsPerSecond = callCount / elapsedSeconds;
 
     qDebug() << "Average calls per second over last" << elapsedSeconds
-             << "seconds:" << callsPerSecond;
+             << "seconds:" << callsPerSecond << "with" << framesInFlightCount << "frame sets in flight";
+
+#ifdef ENABLEFILTERS
+    // REPORT HOW FAR BEHIND THE DISK WRITER IS RUNNING
+    if (saveToDiskFilter) {
+        qDebug() << "Save queue depth:" << saveToDiskFilter->queueDepth()
+                 << "high water mark:" << saveToDiskFilter->queueHighWaterMark()
+                 << "dropped frames:" << saveToDiskFilter->droppedFrames();
+    }
+#endif
 
     // Check if frame rate is too low
     if (callsPerSecond < minCallsPerSecond) {
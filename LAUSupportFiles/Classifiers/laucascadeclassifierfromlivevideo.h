@@ -37,6 +37,8 @@
 #include "laugreenscreenglfilter.h"
 #endif
 
+#define MAXFRAMESINFLIGHT 16
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -92,6 +94,13 @@ public:
         triggerRelayCyclingAndWait();
     }
 
+    int framesInFlight() const
+    {
+        return (framesInFlightCount);
+    }
+
+    void setFramesInFlight(int count);
+
 public slots:
     void onCameraError(QString string);
     void onRFID(QString string, QTime time);
@@ -163,6 +172,11 @@ private:
     QList<LAUModalityObject> framesList;
     QList<LAUAbstractFilterController *> filterControllers;
 
+    // KEEP TRACK OF HOW MANY FRAME SETS CIRCULATE THROUGH THE PIPELINE SO THAT
+    // EACH STAGE CAN WORK ON ITS OWN FRAME WHILE THE OTHERS WORK ON THEIRS
+    int framesInFlightCount;
+    QVector<double> framesJetr;
+
     // CREATE VARIABLES TO DETERMINE WHEN OBJECTS ARE FLOWING THROUGH
     // AND WHEN WE SHOULD IGNORE RFIDS OF OBJECTS MOVING IN BACKWARD
     int dataFileCount;
@@ -198,6 +212,7 @@ private slots:
 
 private:
     void triggerRelayCyclingAndWait();
+    LAUModalityObject allocateFrame() const;
 
 signals:
     void emitBuffer(LAUMemoryObject depth, LAUMemoryObject color, LAUMemoryObject mapping);
@@ -0,0 +1,345 @@
+/*********************************************************************************
+ *                                                                               *
+ * Copyright (C) 2025 Dr. Daniel L. Lau                                          *
+ *                                                                               *
+ * This file is part of LAU 3D Video Inspection System.                         *
+ *                                                                               *
+ * LAU 3D Video Inspection System is free software: you can redistribute it     *
+ * and/or modify it under the terms of the GNU Lesser General Public License    *
+ * as published by the Free Software Foundation, either version 3 of the        *
+ * License, or (at your option) any later version.                              *
+ *                                                                               *
+ * LAU 3D Video Inspection System is distributed in the hope that it will be    *
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser      *
+ * General Public License for more details.                                     *
+ *                                                                               *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with LAU 3D Video Inspection System. If not, see                       *
+ * <https://www.gnu.org/licenses/>.                                             *
+ *                                                                               *
+ *********************************************************************************/
+
+#include "laubackgroundfilter.h"
+
+#include <QPoint>
+#include <QtConcurrent>
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUBackgroundFilter::LAUBackgroundFilter(unsigned int cols, unsigned int rows, QObject *parent) : LAUAbstractFilter(cols, rows, parent), frameCounter(0), maxFilterFrameCount(30), pixelCount(0), maxDistance(65535.0f), timedNanoseconds(0), timedFrames(0)
+{
+    // THE GPU FILTER PROCESSES ALL SENSORS UNLESS TOLD OTHERWISE
+    channel = -1;
+
+    // THE GPU FILTER TREATS EACH ROW AS COLS/4 RGBA TEXELS SO ANY TRAILING
+    // COLUMNS THAT DO NOT FILL A TEXEL ARE NEVER TOUCHED BY THE SHADERS
+    pixelCount = (int)((cols / 4) * 4 * rows);
+
+    // ALLOCATE THE FOUR ACCUMULATORS THAT STAND IN FOR THE FRAME BUFFER OBJECTS
+    for (int n = 0; n < 4; n++) {
+        accumulators[n] = LAUMemoryObject(cols, rows, 1, sizeof(unsigned short), 1);
+        if (accumulators[n].isValid()) {
+            memset(accumulators[n].constPointer(), 0, accumulators[n].length());
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUBackgroundFilter::~LAUBackgroundFilter()
+{
+    if (timedFrames > 0) {
+        qDebug() << "LAUBackgroundFilter::~LAUBackgroundFilter()" << timedFrames << "frames" << averageFrameTime() << "msec per frame";
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUBackgroundFilter::extractMinimumPixel(const unsigned short *inA, const unsigned short *inB, unsigned short *out, int count)
+{
+    // PIXELS OF A AT OR BELOW THE THRESHOLD ARE HOLES SO THEY ARE PUSHED TO 0xFFFF
+    // BEFORE TAKING THE MINIMUM, WHICH IS EXACTLY WHAT THE EXTRACTMINIMUMPIXEL SHADER DOES
+    int index = 0;
+    __m128i thresholdVec = _mm_set1_epi16((short)LAUBACKGROUNDMINPIXELTHRESHOLD);
+    for (; index + 8 <= count; index += 8) {
+        __m128i aVec = _mm_loadu_si128((const __m128i *)(inA + index));
+        __m128i bVec = _mm_loadu_si128((const __m128i *)(inB + index));
+        __m128i mask = _mm_cmpeq_epi16(_mm_min_epu16(aVec, thresholdVec), aVec);
+        aVec = _mm_or_si128(aVec, mask);
+        _mm_storeu_si128((__m128i *)(out + index), _mm_min_epu16(aVec, bVec));
+    }
+
+    // FINISH ANY PIXELS THAT DID NOT FILL A COMPLETE VECTOR
+    for (; index < count; index++) {
+        if (inA[index] <= LAUBACKGROUNDMINPIXELTHRESHOLD) {
+            out[index] = inB[index];
+        } else {
+            out[index] = qMin(inA[index], inB[index]);
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUBackgroundFilter::extractMaximumPixel(const unsigned short *inA, const unsigned short *inB, unsigned short *out, int count)
+{
+    // PIXELS OF A AT OR ABOVE THE THRESHOLD ARE SATURATED SO THEY ARE PUSHED TO ZERO
+    // BEFORE TAKING THE MAXIMUM, WHICH IS EXACTLY WHAT THE EXTRACTMAXIMUMPIXEL SHADER DOES
+    int index = 0;
+    __m128i thresholdVec = _mm_set1_epi16((short)LAUBACKGROUNDMAXPIXELTHRESHOLD);
+    for (; index + 8 <= count; index += 8) {
+        __m128i aVec = _mm_loadu_si128((const __m128i *)(inA + index));
+        __m128i bVec = _mm_loadu_si128((const __m128i *)(inB + index));
+        __m128i mask = _mm_cmpeq_epi16(_mm_max_epu16(aVec, thresholdVec), aVec);
+        aVec = _mm_andnot_si128(mask, aVec);
+        _mm_storeu_si128((__m128i *)(out + index), _mm_max_epu16(aVec, bVec));
+    }
+
+    // FINISH ANY PIXELS THAT DID NOT FILL A COMPLETE VECTOR
+    for (; index < count; index++) {
+        if (inA[index] >= LAUBACKGROUNDMAXPIXELTHRESHOLD) {
+            out[index] = inB[index];
+        } else {
+            out[index] = qMax(inA[index], inB[index]);
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUBackgroundFilter::runStage(Stage stage, const unsigned short *inA, const unsigned short *inB, unsigned short *out) const
+{
+    // SPLIT THE FRAME INTO BLOCKS OF ROWS SO THAT EACH CORE GETS A CONTIGUOUS RUN OF PIXELS
+    int pixelsPerBlock = qMax(8, (pixelCount / qMax(1, (int)numRows)) * LAUBACKGROUNDROWSPERBLOCK);
+    QList<int> blocks;
+    for (int index = 0; index < pixelCount; index += pixelsPerBlock) {
+        blocks << index;
+    }
+
+    QtConcurrent::blockingMap(blocks, [&](const int &index) {
+        int count = qMin(pixelsPerBlock, pixelCount - index);
+        if (stage == StageMinimum) {
+            extractMinimumPixel(inA + index, inB + index, out + index, count);
+        } else {
+            extractMaximumPixel(inA + index, inB + index, out + index, count);
+        }
+    });
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUBackgroundFilter::updateBuffer(LAUMemoryObject depth, LAUMemoryObject color, LAUMemoryObject mapping)
+{
+    Q_UNUSED(color);
+    Q_UNUSED(mapping);
+
+    // MAKE SURE WE HAVE A VALID DEPTH BUFFER THAT MATCHES OUR ACCUMULATORS
+    if (isNull() || depth.isNull() || !depth.isElapsedValid()) {
+        return;
+    }
+
+    if ((int)depth.width() != numCols || (int)depth.height() != numRows || depth.depth() != sizeof(unsigned short)) {
+        qDebug() << "LAUBackgroundFilter::updateBuffer() size mismatch" << depth.width() << depth.height() << depth.depth();
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // GRAB THE SENSOR FRAME THAT WE ARE FILTERING
+    unsigned short *frame = (unsigned short *)depth.constFrame((channel > -1) ? (channel % depth.frames()) : 0);
+    unsigned short *buffers[4];
+    for (int n = 0; n < 4; n++) {
+        buffers[n] = (unsigned short *)accumulators[n].constPointer();
+    }
+
+    // FIRST STAGE: RUNNING MINIMUM OF THE INCOMING FRAMES, RESTARTING EVERY MAXFILTERFRAMECOUNT FRAMES
+    if ((frameCounter % maxFilterFrameCount) == 0) {
+        memset(buffers[frameCounter % 2], 0xff, pixelCount * sizeof(unsigned short));
+        runStage(StageMinimum, frame, buffers[frameCounter % 2], buffers[frameCounter % 2]);
+    } else {
+        runStage(StageMinimum, frame, buffers[(frameCounter + 1) % 2], buffers[frameCounter % 2]);
+    }
+
+    // THE GPU FILTER ZEROS THE SINGLE SENSOR BUFFER BEFORE READING BACK THE RESULT
+    if (channel < 0) {
+        memset(frame, 0, depth.block());
+    }
+
+    // SECOND STAGE: RUNNING MAXIMUM OF THE MINIMUM FRAMES, PING-PONGING BETWEEN ACCUMULATORS TWO AND THREE
+    int targetA = ((frameCounter / maxFilterFrameCount) + 0) % 2 + 2;
+    int targetB = ((frameCounter / maxFilterFrameCount) + 1) % 2 + 2;
+    if (frameCounter < 2) {
+        memset(buffers[targetA], 0, pixelCount * sizeof(unsigned short));
+    } else if ((frameCounter % maxFilterFrameCount) == 0) {
+        runStage(StageMaximum, buffers[(frameCounter + 1) % 2], buffers[targetB], buffers[targetA]);
+    }
+
+    // INCREMENT FRAME COUNTER FOR NEXT TIME AROUND
+    frameCounter++;
+
+    // OVERWRITE THE INCOMING DEPTH BUFFER WITH THE CURRENT RESULT
+    if (frameCounter < maxFilterFrameCount) {
+        memcpy(frame, buffers[frameCounter % 2], pixelCount * sizeof(unsigned short));
+    } else {
+        memcpy(frame, buffers[targetA], pixelCount * sizeof(unsigned short));
+    }
+
+    timedNanoseconds += timer.nsecsElapsed();
+    timedFrames++;
+    if ((timedFrames % 1000) == 0) {
+        qDebug() << "LAUBackgroundFilter::updateBuffer()" << averageFrameTime() << "msec per frame";
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObject LAUBackgroundFilter::background() const
+{
+    // CHECK IF WE HAVE ENOUGH FRAMES TO CREATE A VALID BACKGROUND
+    if (isNull() || frameCounter < maxFilterFrameCount) {
+        return (LAUMemoryObject());
+    }
+
+    // COPY THE LAST BACKGROUND BUFFER AND PERFORM IN-PLACE INPAINTING
+    LAUMemoryObject object(numCols, numRows, 1, sizeof(unsigned short), 1);
+    memset(object.constPointer(), 0, object.length());
+    memcpy(object.constPointer(), accumulators[3].constPointer(), pixelCount * sizeof(unsigned short));
+    inPaint(object, (unsigned short)maxDistance);
+
+    // SET THE JETR VECTOR IN THE MEMORY OBJECT
+    object.setConstJetr(jetrVector);
+
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUBackgroundFilter::onEmitBackground()
+{
+    // CHECK IF WE HAVE ENOUGH FRAMES TO CREATE A VALID BACKGROUND
+    if (frameCounter < maxFilterFrameCount) {
+        qDebug() << "Background not ready - need" << maxFilterFrameCount << "frames, currently have" << frameCounter;
+        return;
+    }
+
+    LAUMemoryObject object = background();
+    if (object.isValid()) {
+        emit emitBackground(object);
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUBackgroundFilter::inPaint(LAUMemoryObject object, unsigned short fill)
+{
+    // MAKE LIST OF PIXELS CORRESPONDING TO HOLES
+    int numCols = object.width();
+    int numRows = object.height();
+    unsigned short *buffer = (unsigned short *)object.constPointer();
+
+#define USE_ZMAX_TO_INPAINT
+#ifdef USE_ZMAX_TO_INPAINT
+    // ITERATE THROUGH EACH PIXEL AND ADD TO LIST IF ITS EMPTY
+    for (int row = 0; row < numRows; row++) {
+        for (int col = 0; col < numCols; col++) {
+            if (buffer[row * numCols + col] == 0) {
+                buffer[row * numCols + col] = fill;
+            }
+        }
+    }
+#else
+    // MAKE LIST OF PIXELS CORRESPONDING TO HOLES
+    QList<QPoint> pixels;
+
+    // ITERATE THROUGH EACH PIXEL AND ADD TO LIST IF ITS EMPTY
+    for (int row = 0; row < numRows; row++) {
+        for (int col = 0; col < numCols; col++) {
+            if (buffer[row * numCols + col] == 0) {
+                pixels.append(QPoint(col, row));
+            }
+        }
+    }
+
+    // MAKE SURE WE HAVE AT LEAST ONE VALID PIXEL TO BUILD FROM
+    if (pixels.count() < (numRows * numCols)) {
+        // CONTINUOUSLY ITERATE THROUGH THE PIXEL LIST UNTIL WE'VE WIDDLED IT AWAY COMPLETELY
+        QList<QPoint> inPixels;
+        QList<QPoint> otPixels;
+        while (pixels.count() > 0) {
+            while (pixels.count() > 0) {
+                QPoint pixel = pixels.takeFirst();
+
+                // TEST PIXEL TO SEE IF ONE OF ITS FOUR NEIGHBORS EXIST
+                unsigned short cumSum = 0xffff;
+
+                // TEST THE LEFT-NEIGHBOR
+                if (pixel.x() > 0) {
+                    unsigned short val = buffer[(pixel.y() + 0) * numCols + (pixel.x() - 1)];
+                    if (val) {
+                        cumSum = (unsigned short)qMin(cumSum, val);
+                    }
+                }
+
+                // TEST THE RIGHT-NEIGHBOR
+                if (pixel.x() + 1 < numCols) {
+                    unsigned short val = buffer[(pixel.y() + 0) * numCols + (pixel.x() + 1)];
+                    if (val) {
+                        cumSum = (unsigned short)qMin(cumSum, val);
+                    }
+                }
+
+                // TEST THE ABOVE-NEIGHBOR
+                if (pixel.y() > 0) {
+                    unsigned short val = buffer[(pixel.y() - 1) * numCols + (pixel.x() + 0)];
+                    if (val) {
+                        cumSum = (unsigned short)qMin(cumSum, val);
+                    }
+                }
+
+                // TEST THE BELOW-NEIGHBOR
+                if (pixel.y() + 1 < numRows) {
+                    unsigned short val = buffer[(pixel.y() + 1) * numCols + (pixel.x() + 0)];
+                    if (val) {
+                        cumSum = (unsigned short)qMin(cumSum, val);
+                    }
+                }
+
+                // IF IT DOES NOT HAVE A NEIGHBOR, ADD IT TO THE END OF THE LIST AND WE WILL TRY AGAIN
+                // DURING THE NEXT TIME THROUGH THE PIXEL LIST OTHERWISE UPDATE THE PIXEL IN THE MEMORY OBJECT
+                if (cumSum != 0xffff) {
+                    otPixels.append(QPoint(pixel.y()*numCols + pixel.x(), (int)cumSum));
+                } else {
+                    inPixels.append(pixel);
+                }
+            }
+
+            // NOW THAT WE HAVE A LIST OF PIXELS THAT CAN BE IN-FILLED, LET'S FILL THEM IN
+            while (otPixels.count() > 0) {
+                QPoint point = otPixels.takeFirst();
+                buffer[point.x()] = (unsigned short)point.y();
+            }
+
+            // NOW COPY THE LIST OF PIXELS THAT STILL NEED IN-FILLING BACK
+            // TO OUR PIXELS LIST AND REMOVE THEM FORM THE SEPARATE LIST
+            pixels = inPixels;
+            inPixels.clear();
+        }
+    }
+#endif
+    //QString tempFileString = QStandardPaths::writableLocation(QStandardPaths::TempLocation).append("/background.tif");
+    //object.save(tempFileString);
+    //qDebug() << tempFileString;
+
+    return;
+}
@@ -0,0 +1,120 @@
+/*********************************************************************************
+ *                                                                               *
+ * Copyright (C) 2025 Dr. Daniel L. Lau                                          *
+ *                                                                               *
+ * This file is part of LAU 3D Video Inspection System.                         *
+ *                                                                               *
+ * LAU 3D Video Inspection System is free software: you can redistribute it     *
+ * and/or modify it under the terms of the GNU Lesser General Public License    *
+ * as published by the Free Software Foundation, either version 3 of the        *
+ * License, or (at your option) any later version.                              *
+ *                                                                               *
+ * LAU 3D Video Inspection System is distributed in the hope that it will be    *
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser      *
+ * General Public License for more details.                                     *
+ *                                                                               *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with LAU 3D Video Inspection System. If not, see                       *
+ * <https://www.gnu.org/licenses/>.                                             *
+ *                                                                               *
+ *********************************************************************************/
+
+#ifndef LAUBACKGROUNDFILTER_H
+#define LAUBACKGROUNDFILTER_H
+
+#include <QElapsedTimer>
+
+#include "lauabstractfilter.h"
+
+// THESE THRESHOLDS REPRODUCE THE 0.001 AND 0.999 TESTS IN THE EXTRACTMINIMUMPIXEL AND
+// EXTRACTMAXIMUMPIXEL SHADERS AFTER 16-BIT DEPTH IS NORMALIZED TO THE RANGE [0,1]
+#define LAUBACKGROUNDMINPIXELTHRESHOLD  65
+#define LAUBACKGROUNDMAXPIXELTHRESHOLD  65470
+#define LAUBACKGROUNDROWSPERBLOCK       32
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+class LAUBackgroundFilter : public LAUAbstractFilter
+{
+    Q_OBJECT
+
+public:
+    explicit LAUBackgroundFilter(unsigned int cols, unsigned int rows, QObject *parent = nullptr);
+    ~LAUBackgroundFilter();
+
+    bool isValid() const
+    {
+        return (accumulators[0].isValid());
+    }
+
+    bool isNull() const
+    {
+        return (!isValid());
+    }
+
+    void setMaxDistance(unsigned short val)
+    {
+        maxDistance = val;
+    }
+
+    void setJetrVector(QVector<double> vector)
+    {
+        jetrVector = vector;
+    }
+
+    int frames() const
+    {
+        return (frameCounter);
+    }
+
+    double averageFrameTime() const
+    {
+        if (timedFrames > 0) {
+            return ((double)timedNanoseconds / (double)timedFrames / 1.0e6);
+        }
+        return (0.0);
+    }
+
+    LAUMemoryObject background() const;
+
+    static void extractMinimumPixel(const unsigned short *inA, const unsigned short *inB, unsigned short *out, int count);
+    static void extractMaximumPixel(const unsigned short *inA, const unsigned short *inB, unsigned short *out, int count);
+    static void inPaint(LAUMemoryObject object, unsigned short fill);
+
+public slots:
+    void onReset()
+    {
+        frameCounter = 0;
+    }
+
+    void onSetMaxPixelFilterCount(int val)
+    {
+        maxFilterFrameCount = qMax(1, val);
+    }
+
+    void onEmitBackground();
+
+protected:
+    void updateBuffer(LAUMemoryObject depth = LAUMemoryObject(), LAUMemoryObject color = LAUMemoryObject(), LAUMemoryObject mapping = LAUMemoryObject());
+
+signals:
+    void emitBackground(LAUMemoryObject background);
+
+private:
+    int frameCounter;
+    int maxFilterFrameCount;
+    int pixelCount;
+    float maxDistance;
+    QVector<double> jetrVector;
+    LAUMemoryObject accumulators[4];   // MIRRORS THE FOUR FRAME BUFFER OBJECTS OF LAUBACKGROUNDGLFILTER
+
+    qint64 timedNanoseconds;
+    qint64 timedFrames;
+
+    typedef enum { StageMinimum, StageMaximum } Stage;
+    void runStage(Stage stage, const unsigned short *inA, const unsigned short *inB, unsigned short *out) const;
+};
+
+#endif // LAUBACKGROUNDFILTER_H
@@ -621,112 +621,6 @@ void LAUBackgroundGLFilter::updateBuffer(LAUMemoryObject depth, LAUMemoryObject
     }
 }
 
-/****************************************************************************/
-/****************************************************************************/
-/****************************************************************************/
-void LAUBackgroundGLFilter::inPaint(LAUMemoryObject object, unsigned short fill)
-{
-    // MAKE LIST OF PIXELS CORRESPONDING TO HOLES
-    int numCols = object.width();
-    int numRows = object.height();
-    unsigned short *buffer = (unsigned short *)object.constPointer();
-
-#define USE_ZMAX_TO_INPAINT
-#ifdef USE_ZMAX_TO_INPAINT
-    // ITERATE THROUGH EACH PIXEL AND ADD TO LIST IF ITS EMPTY
-    for (int row = 0; row < numRows; row++) {
-        for (int col = 0; col < numCols; col++) {
-            if (buffer[row * numCols + col] == 0) {
-                buffer[row * numCols + col] = fill;
-            }
-        }
-    }
-#else
-    // MAKE LIST OF PIXELS CORRESPONDING TO HOLES
-    QList<QPoint> pixels;
-
-    // ITERATE THROUGH EACH PIXEL AND ADD TO LIST IF ITS EMPTY
-    for (int row = 0; row < numRows; row++) {
-        for (int col = 0; col < numCols; col++) {
-            if (buffer[row * numCols + col] == 0) {
-                pixels.append(QPoint(col, row));
-            }
-        }
-    }
-
-    // MAKE SURE WE HAVE AT LEAST ONE VALID PIXEL TO BUILD FROM
-    if (pixels.count() < (numRows * numCols)) {
-        // CONTINUOUSLY ITERATE THROUGH THE PIXEL LIST UNTIL WE'VE WIDDLED IT AWAY COMPLETELY
-        QList<QPoint> inPixels;
-        QList<QPoint> otPixels;
-        while (pixels.count() > 0) {
-            while (pixels.count() > 0) {
-                QPoint pixel = pixels.takeFirst();
-
-                // TEST PIXEL TO SEE IF ONE OF ITS FOUR NEIGHBORS EXIST
-                unsigned short cumSum = 0xffff;
-
-                // TEST THE LEFT-NEIGHBOR
-                if (pixel.x() > 0) {
-                    unsigned short val = buffer[(pixel.y() + 0) * numCols + (pixel.x() - 1)];
-                    if (val) {
-                        cumSum = (unsigned short)qMin(cumSum, val);
-                    }
-                }
-
-                // TEST THE RIGHT-NEIGHBOR
-                if (pixel.x() + 1 < numCols) {
-                    unsigned short val = buffer[(pixel.y() + 0) * numCols + (pixel.x() + 1)];
-                    if (val) {
-                        cumSum = (unsigned short)qMin(cumSum, val);
-                    }
-                }
-
-                // TEST THE ABOVE-NEIGHBOR
-                if (pixel.y() > 0) {
-                    unsigned short val = buffer[(pixel.y() - 1) * numCols + (pixel.x() + 0)];
-                    if (val) {
-                        cumSum = (unsigned short)qMin(cumSum, val);
-                    }
-                }
-
-                // TEST THE BELOW-NEIGHBOR
-                if (pixel.y() + 1 < numRows) {
-                    unsigned short val = buffer[(pixel.y() + 1) * numCols + (pixel.x() + 0)];
-                    if (val) {
-                        cumSum = (unsigned short)qMin(cumSum, val);
-                    }
-                }
-
-                // IF IT DOES NOT HAVE A NEIGHBOR, ADD IT TO THE END OF THE LIST AND WE WILL TRY AGAIN
-                // DURING THE NEXT TIME THROUGH THE PIXEL LIST OTHERWISE UPDATE THE PIXEL IN THE MEMORY OBJECT
-                if (cumSum != 0xffff) {
-                    otPixels.append(QPoint(pixel.y()*numCols + pixel.x(), (int)cumSum));
-                } else {
-                    inPixels.append(pixel);
-                }
-            }
-
-            // NOW THAT WE HAVE A LIST OF PIXELS THAT CAN BE IN-FILLED, LET'S FILL THEM IN
-            while (otPixels.count() > 0) {
-                QPoint point = otPixels.takeFirst();
-                buffer[point.x()] = (unsigned short)point.y();
-            }
-
-            // NOW COPY THE LIST OF PIXELS THAT STILL NEED IN-FILLING BACK
-            // TO OUR PIXELS LIST AND REMOVE THEM FORM THE SEPARATE LIST
-            pixels = inPixels;
-            inPixels.clear();
-        }
-    }
-#endif
-    //QString tempFileString = QStandardPaths::writableLocation(QStandardPaths::TempLocation).append("/background.tif");
-    //object.save(tempFileString);
-    //qDebug() << tempFileString;
-
-    return;
-}
-
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -750,7 +644,7 @@ void LAUBackgroundGLFilter::onEmitBackground()
         glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_SHORT, object.pointer());
 
         // PEFORM IN-PLACE INPAINTING
-        inPaint(object, (unsigned short)maxDistance);
+        LAUBackgroundFilter::inPaint(object, (unsigned short)maxDistance);
 
         // SET THE JETR VECTOR IN THE MEMORY OBJECT
         int localChannel = qMax(0, channel);
@@ -784,7 +678,7 @@ void LAUBackgroundGLFilter::onPreserveBackgroundToSettings()
         glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_SHORT, object.pointer());
 
         // PEFORM IN-PLACE INPAINTING
-        inPaint(object, (unsigned short)maxDistance);
+        LAUBackgroundFilter::inPaint(object, (unsigned short)maxDistance);
 
         // SET THE JETR VECTOR IN THE MEMORY OBJECT
         int localChannel = qMax(0, channel);
@@ -28,6 +28,7 @@
 #include "lau3dvideowidget.h"
 #endif
 #include "lauabstractfilter.h"
+#include "laubackgroundfilter.h"
 
 /****************************************************************************/
 /****************************************************************************/
@@ -90,7 +91,6 @@ private:
     QOpenGLShaderProgram minPixelProgram;      // THIS SHADER PROGRAM HOLDS THE PROGRAM FOR KEEPING THE MAXIMUM PIXEL VALUE
     QOpenGLFramebufferObject *maxPixelFBO[4];  // THIS FRAME BUFFER OBJECT HOLDS THE INTERMEDIATE MAXIMUM PIXEL BUFFER
 
-    static void inPaint(LAUMemoryObject object, unsigned short fill);
 };
 
 #ifndef HEADLESS
@@ -33,8 +33,19 @@ using namespace libtiff;
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-LAUSaveToDiskFilter::LAUSaveToDiskFilter(QString dirString, QObject *parent) : LAUAbstractFilter(0, 0, parent), frameCounter(0), file(nullptr), directoryString(dirString), recordFlag(false)
+LAUSaveToDiskFilter::LAUSaveToDiskFilter(QString dirString, QObject *parent) : LAUAbstractFilter(0, 0, parent), frameCounter(0), file(nullptr), writer(nullptr), directoryString(dirString), recordFlag(false)
 {
+    // CREATE THE WRITER THREAD THAT DOES THE ACTUAL COMPRESSION AND DISK I/O
+    writer = new LAUSaveToDiskWriter(NUMBER_QUEUED_FRAMES);
+    writer->setRowsPerStrip(QSettings().value("LAUSaveToDiskFilter::rowsPerStrip", LAUMEMORYOBJECTROWSPERSTRIP).toInt());
+    writer->setCompressionThreads(QSettings().value("LAUSaveToDiskFilter::compressionThreads", QThread::idealThreadCount()).toInt());
+    writer->start();
+
+    // EACH MODALITY CAN USE ITS OWN LOSSLESS CODEC, FOR EXAMPLE "DEFLATE:1" OR "ZSTD:3"
+    depthCodecObject = LAUMemoryObjectCodec::fromString(QSettings().value("LAUSaveToDiskFilter::depthCodec", QString("lzw")).toString());
+    colorCodecObject = LAUMemoryObjectCodec::fromString(QSettings().value("LAUSaveToDiskFilter::colorCodec", QString("lzw")).toString());
+    mappingCodecObject = LAUMemoryObjectCodec::fromString(QSettings().value("LAUSaveToDiskFilter::mappingCodec", QString("lzw")).toString());
+
     if (directoryString.isEmpty()) {
         QSettings settings;
         QString directory = settings.value("LAUSaveToDiskFilter::lastUsedDirectory", QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)).toString();
@@ -49,6 +60,20 @@ LAUSaveToDiskFilter::LAUSaveToDiskFilter(QString dirString, QObject *parent) : L
     }
 }
 
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUSaveToDiskFilter::~LAUSaveToDiskFilter()
+{
+    // MAKE SURE THE WRITER HAS FLUSHED EVERYTHING TO DISK BEFORE DELETING IT
+    if (writer) {
+        writer->stop();
+        writer->wait();
+        delete writer;
+    }
+    qDebug() << QString("LAUSaveToDiskFilter::~LAUSaveToDiskFilter()");
+}
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -109,8 +134,13 @@ void LAUSaveToDiskFilter::onFinish()
         closeOldFile(frameCounter);
     }
 
+    // WAIT FOR THE WRITER TO DRAIN ITS QUEUE BEFORE SHUTTING DOWN
+    writer->stop();
+    writer->wait();
+
     // OUTPUT TO STANDARD OUTPUT
     logTS << "LAUSaveToDiskFilter::onFinish()\n";
+    logTS << "Frames written: " << writer->writtenFrames() << ", dropped: " << writer->droppedFrames() << ", queue high-water mark: " << writer->highWaterMark() << "\n";
     logTS.flush();
 
     // CLOSE THE LOG FILE
@@ -128,6 +158,7 @@ void LAUSaveToDiskFilter::updateBuffer(LAUMemoryObject depth, LAUMemoryObject co
     static int updateBufferCounter = 0;
     if ((updateBufferCounter++)%1000 == 0){
         logTS << "Inside LAUSaveToDiskFilter::updateBuffer()" << updateBufferCounter << "\n";
+        logTS << "Write queue depth " << writer->depth() << ", high-water mark " << writer->highWaterMark() << ", dropped " << writer->droppedFrames() << "\n";
         logTS.flush();
     }
 
@@ -162,23 +193,11 @@ void LAUSaveToDiskFilter::updateBuffer(LAUMemoryObject depth, LAUMemoryObject co
 
     // WE ALWAYS WANT TO HAVE A COPY OF THE MOST RECENT FRAMES OF VIDEO FOR WHEN WE CLOSE A FILE AND START A NEW RECORDING
     if (depth.isValid()){
-        // COPY OVER THE DEPTH MEMORY OBJECT
-        frame.depth.setConstRFID(depth.rfid());
-        frame.depth.setConstXML(depth.xml());
-        frame.depth.setConstTransform(depth.transform());
-        frame.depth.setConstAnchor(depth.anchor());
-        frame.depth.setConstElapsed(depth.elapsed());
-        memcpy(frame.depth.constPointer(), depth.constPointer(), qMin(frame.depth.length(), depth.length()));
+        copyFrame(frame.depth, depth);
     }
 
     if (color.isValid()){
-        // COPY OVER THE COLOR MEMORY OBJECT
-        frame.color.setConstRFID(color.rfid());
-        frame.color.setConstXML(color.xml());
-        frame.color.setConstTransform(color.transform());
-        frame.color.setConstAnchor(color.anchor());
-        frame.color.setConstElapsed(color.elapsed());
-        memcpy(frame.color.constPointer(), color.constPointer(), qMin(frame.color.length(), color.length()));
+        copyFrame(frame.color, color);
     }
 
     // ADD THE FRAME TO THE END OF THE LIST AS THE NEWEST FRAME
@@ -195,23 +214,8 @@ void LAUSaveToDiskFilter::updateBuffer(LAUMemoryObject depth, LAUMemoryObject co
             }
         }
 
-        // RECORD THE INCOMING DEPTH VIDEO TO DISK IF IT EXISTS
-        if (depth.isValid()) {
-            depth.save(file, frameCounter);
-            frameCounter++;
-        }
-
-        // RECORD THE INCOMING RGB VIDEO TO DISK IF IT EXISTS
-        if (color.isValid()) {
-            color.save(file, frameCounter);
-            frameCounter++;
-        }
-
-        // RECORD THE INCOMING MAPPING VIDEO TO DISK IF IT EXISTS
-        if (mapping.isValid()) {
-            mapping.save(file, frameCounter);
-            frameCounter++;
-        }
+        // HAND THE INCOMING DEPTH, RGB, AND MAPPING VIDEO TO THE WRITER THREAD
+        writeFrame(depth, color, mapping);
 
         // CHECK TO SEE IF WE NEED TO SWITCH TO A NEW RAW DATA FILE
         if (frameCounter >= 500) {
@@ -245,23 +249,8 @@ void LAUSaveToDiskFilter::updateBuffer(LAUMemoryObject depth, LAUMemoryObject co
 
     // IF WE DON'T HAVE AN OPEN FILE HERE, THEN SKIP THE REST OF THIS LOOP
     if (file != nullptr) {
-        // RECORD THE INCOMING DEPTH VIDEO TO DISK IF IT EXISTS
-        if (depth.isValid()) {
-            depth.save(file, frameCounter);
-            frameCounter++;
-        }
-
-        // RECORD THE INCOMING RGB VIDEO TO DISK IF IT EXISTS
-        if (color.isValid()) {
-            color.save(file, frameCounter);
-            frameCounter++;
-        }
-
-        // RECORD THE INCOMING MAPPING VIDEO TO DISK IF IT EXISTS
-        if (mapping.isValid()) {
-            mapping.save(file, frameCounter);
-            frameCounter++;
-        }
+        // HAND THE INCOMING DEPTH, RGB, AND MAPPING VIDEO TO THE WRITER THREAD
+        writeFrame(depth, color, mapping);
 
         // CHECK TO SEE IF WE NEED TO SWITCH TO A NEW RAW DATA FILE
         if (frameCounter >= 500) {
@@ -322,23 +311,8 @@ void LAUSaveToDiskFilter::updateBuffer(LAUMemoryObject depth, LAUMemoryObject co
                 logTS << "file pointer is valid\n";
                 logTS.flush();
 
-                // RECORD THE INCOMING DEPTH VIDEO TO DISK IF IT EXISTS
-                if (depth.isValid()) {
-                    depth.save(file, frameCounter);
-                    frameCounter++;
-                }
-
-                // RECORD THE INCOMING RGB VIDEO TO DISK IF IT EXISTS
-                if (color.isValid()) {
-                    color.save(file, frameCounter);
-                    frameCounter++;
-                }
-
-                // RECORD THE INCOMING MAPPING VIDEO TO DISK IF IT EXISTS
-                if (mapping.isValid()) {
-                    mapping.save(file, frameCounter);
-                    frameCounter++;
-                }
+                // HAND THE INCOMING DEPTH, RGB, AND MAPPING VIDEO TO THE WRITER THREAD
+                writeFrame(depth, color, mapping);
 
                 // CHECK TO SEE IF WE NEED TO SWITCH TO A NEW RAW DATA FILE
                 if (frameCounter >= 500) {
@@ -369,22 +343,10 @@ void LAUSaveToDiskFilter::updateBuffer(LAUMemoryObject depth, LAUMemoryObject co
 
                 // IF WE ARE NOT RECORDING, THEN COPY THE INCOMING MEMORY OBJECTS TO THE HEADER FRAMES LIST
                 if (depth.isValid()){
-                    // COPY OVER THE DEPTH MEMORY OBJECT
-                    frame.depth.setConstRFID(depth.rfid());
-                    frame.depth.setConstXML(depth.xml());
-                    frame.depth.setConstTransform(depth.transform());
-                    frame.depth.setConstAnchor(depth.anchor());
-                    frame.depth.setConstElapsed(depth.elapsed());
-                    memcpy(frame.depth.constPointer(), depth.constPointer(), qMin(frame.depth.length(), depth.length()));
+                    copyFrame(frame.depth, depth);
                 }
                 if (color.isValid()){
-                    // COPY OVER THE COLOR MEMORY OBJECT
-                    frame.color.setConstRFID(color.rfid());
-                    frame.color.setConstXML(color.xml());
-                    frame.color.setConstTransform(color.transform());
-                    frame.color.setConstAnchor(color.anchor());
-                    frame.color.setConstElapsed(color.elapsed());
-                    memcpy(frame.color.constPointer(), color.constPointer(), qMin(frame.color.length(), color.length()));
+                    copyFrame(frame.color, color);
                 }
 
                 // ADD THE FRAME TO THE END OF THE LIST AS THE NEWEST FRAME
@@ -397,6 +359,28 @@ void LAUSaveToDiskFilter::updateBuffer(LAUMemoryObject depth, LAUMemoryObject co
 #endif
 }
 
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUSaveToDiskFilter::copyFrame(LAUMemoryObject &target, const LAUMemoryObject &source)
+{
+    // REFILL A SLOT WHOSE BUFFER WAS HANDED TO THE WRITER WHEN THE LAST FILE WAS CLOSED,
+    // RESETTING THE FIELDS WE DON'T COPY SO THEY MATCH A FRESHLY ALLOCATED OBJECT
+    if (target.isNull()) {
+        target = writer->recycledObject(source);
+        target.setConstProjection(QMatrix4x4());
+        target.setConstJetr(QVector<double>(37, NAN));
+    }
+
+    // COPY OVER THE MEMORY OBJECT
+    target.setConstRFID(source.rfid());
+    target.setConstXML(source.xml());
+    target.setConstTransform(source.transform());
+    target.setConstAnchor(source.anchor());
+    target.setConstElapsed(source.elapsed());
+    memcpy(target.pointer(), source.constPointer(), qMin(target.length(), source.length()));
+}
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -422,8 +406,8 @@ bool LAUSaveToDiskFilter::openNewFile()
         }
 
         // SAVE ANY HEADER FRAMES
-        if (header.isValid()) {
-            header.save(file, 0);
+        if (file && header.isValid()) {
+            writer->enqueueFrames(file, QList<LAUMemoryObject>() << header, true);
         }
         frameCounter = (header.frames() > 0);
     } else {
@@ -457,40 +441,38 @@ bool LAUSaveToDiskFilter::closeOldFile(int frames)
         // IF WE SHOULD DELETE THE FILE BECAUSE ITS TOO SMALL
         if (frames > -1){
             if (frames < 3) {
-                // CLOSE TIFF FILE
-                TIFFClose(file);
-
-                // SEE IF WE NEED TO DELETE THIS FILE
-                if (QFile::exists(currentFileString)) {
-#if QT_VERSION >= 0x060000
-                    QFile(currentFileString).moveToTrash();
-#else
-                    QFile(currentFileString).remove();
-#endif
-                    logTS << "Deleting file:" << currentFileString << "\n";
-                    logTS.flush();
-                }
+                // HAVE THE WRITER CLOSE THE TIFF FILE AND THEN DELETE IT
+                writer->enqueueClose(file, currentFileString, true);
+                logTS << "Deleting file:" << currentFileString << "\n";
+                logTS.flush();
             } else {
 #ifdef SAVE_HEADER_FRAMES
-                // SAVE THE HEADER FRAMES AT THE END OF THE VIDEO JUST BEFORE CLOSING
-                // AND CLEAR THE ELAPSED TIME FIELD SO WE KNOW THE FRAME IS NOT VALID
+                // SAVE THE HEADER FRAMES AT THE END OF THE VIDEO JUST BEFORE CLOSING BY HANDING
+                // THE BUFFERS THEMSELVES TO THE WRITER AS ONE JOB, SO CLOSING COSTS THE FILTER
+                // THREAD THE SAME NO MATTER HOW MANY FRAMES ARE BUFFERED. THE EMPTY SLOTS LEFT
+                // BEHIND ARE REFILLED ONE AT A TIME FROM THE WRITER'S RECYCLE LIST BY COPYFRAME()
+                QList<LAUMemoryObject> objects;
+                QList<LAUMemoryObjectCodec> codecs;
                 for (int n = 0; n < headerFrames.count(); n++){
-                    LAUFrame frame = headerFrames.takeFirst();
+                    LAUFrame &frame = headerFrames[n];
                     if (frame.depth.isValid() && frame.depth.isElapsedValid()){
-                        frame.depth.save(file, frameCounter++);
+                        objects << frame.depth;
+                        codecs << depthCodecObject;
+                        frame.depth = LAUMemoryObject();
                     }
-                    frame.depth.constMakeElapsedInvalid();
                     if (frame.color.isValid() && frame.color.isElapsedValid()){
-                        frame.color.save(file, frameCounter++);
+                        objects << frame.color;
+                        codecs << colorCodecObject;
+                        frame.color = LAUMemoryObject();
                     }
-                    frame.color.constMakeElapsedInvalid();
-
-                    // APPEND THIS NOW INVALID VIDEO FRAME BACK TO OUR HEADER LIST
-                    headerFrames << frame;
                 }
+                writer->adoptFrames(file, objects, codecs);
+                frameCounter += objects.count();
 #endif
-                TIFFClose(file);
+                writer->enqueueClose(file, currentFileString);
             }
+        } else {
+            writer->enqueueClose(file, currentFileString);
         }
         file = nullptr;
         return (true);
@@ -498,6 +480,42 @@ bool LAUSaveToDiskFilter::closeOldFile(int frames)
     return (false);
 }
 
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUSaveToDiskFilter::writeFrame(LAUMemoryObject depth, LAUMemoryObject color, LAUMemoryObject mapping)
+{
+    // COLLECT THE VALID MEMORY OBJECTS SO THEY ARE QUEUED OR DROPPED TOGETHER
+    QList<LAUMemoryObject> objects;
+    QList<LAUMemoryObjectCodec> codecs;
+    if (depth.isValid()) {
+        objects << depth;
+        codecs << depthCodecObject;
+    }
+    if (color.isValid()) {
+        objects << color;
+        codecs << colorCodecObject;
+    }
+    if (mapping.isValid()) {
+        objects << mapping;
+        codecs << mappingCodecObject;
+    }
+
+    if (objects.isEmpty()) {
+        return (false);
+    }
+
+    // HAND THE FRAME TO THE WRITER AND ONLY COUNT IT IF IT WAS ACCEPTED
+    if (writer->enqueueFrames(file, objects, false, codecs)) {
+        frameCounter += objects.count();
+        return (true);
+    }
+
+    logTS << "Write queue full, dropped frame " << depth.elapsed() << " (" << writer->droppedFrames() << " dropped so far)\n";
+    logTS.flush();
+    return (false);
+}
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -526,3 +544,210 @@ QString LAUSaveToDiskFilter::getNextFilestring()
     // IF WE MAKE IT THIS FAR, SOMETHING IS REALLY WRONG
     return (QString());
 }
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUSaveToDiskWriter::LAUSaveToDiskWriter(int depth, QObject *parent) : QThread(parent), queueCapacity(qMax(1, depth)), queueHighWaterMark(0), queueDroppedFrames(0), queueWrittenFrames(0), stripRows(LAUMEMORYOBJECTROWSPERSTRIP), compressionThreadCount(qMax(1, QThread::idealThreadCount())), stopFlag(false)
+{
+    ;
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUSaveToDiskWriter::~LAUSaveToDiskWriter()
+{
+    stop();
+    wait();
+    qDebug() << QString("LAUSaveToDiskWriter::~LAUSaveToDiskWriter()");
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUSaveToDiskWriter::stop()
+{
+    QMutexLocker locker(&mutex);
+    stopFlag = true;
+    jobAvailable.wakeAll();
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUSaveToDiskWriter::enqueueFrames(libtiff::TIFF *file, QList<LAUMemoryObject> objects, bool keepFlag, QList<LAUMemoryObjectCodec> codecs)
+{
+    if (file == nullptr) {
+        return (false);
+    }
+
+    // LIVE FRAMES ARE DROPPED, BUT COUNTED, WHEN THE QUEUE IS ALREADY FULL
+    if (keepFlag == false) {
+        QMutexLocker locker(&mutex);
+        if (jobs.count() >= queueCapacity) {
+            queueDroppedFrames++;
+            return (false);
+        }
+    }
+
+    // THE INCOMING BUFFERS ARE RECYCLED UPSTREAM SO WE NEED OUR OWN COPY
+    LAUWriteJob job;
+    job.file = file;
+    job.closeFlag = false;
+    job.deleteFlag = false;
+    for (int n = 0; n < objects.count(); n++) {
+        if (objects.at(n).isValid()) {
+            job.objects << copyObject(objects.at(n));
+            job.codecs << codecs.value(n, LAUMemoryObjectCodec());
+        }
+    }
+    pushJob(job);
+
+    return (true);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUSaveToDiskWriter::adoptFrames(libtiff::TIFF *file, QList<LAUMemoryObject> objects, QList<LAUMemoryObjectCodec> codecs)
+{
+    if (file == nullptr) {
+        return (false);
+    }
+
+    // THE CALLER GIVES UP THESE BUFFERS SO WE CAN QUEUE THEM WITHOUT MAKING OUR OWN COPY
+    LAUWriteJob job;
+    job.file = file;
+    job.closeFlag = false;
+    job.deleteFlag = false;
+    for (int n = 0; n < objects.count(); n++) {
+        if (objects.at(n).isValid()) {
+            job.objects << objects.at(n);
+            job.codecs << codecs.value(n, LAUMemoryObjectCodec());
+        }
+    }
+    pushJob(job);
+
+    return (true);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUSaveToDiskWriter::enqueueClose(libtiff::TIFF *file, QString filename, bool deleteFlag)
+{
+    if (file == nullptr) {
+        return;
+    }
+
+    LAUWriteJob job;
+    job.file = file;
+    job.filename = filename;
+    job.closeFlag = true;
+    job.deleteFlag = deleteFlag;
+    pushJob(job);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUSaveToDiskWriter::pushJob(const LAUWriteJob &job)
+{
+    QMutexLocker locker(&mutex);
+    jobs.enqueue(job);
+    queueHighWaterMark = qMax(queueHighWaterMark, jobs.count());
+    jobAvailable.wakeOne();
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObject LAUSaveToDiskWriter::recycledObject(const LAUMemoryObject &object)
+{
+    // SEE IF WE HAVE A PREVIOUSLY WRITTEN BUFFER OF THE SAME SIZE TO REUSE
+    LAUMemoryObject buffer;
+    mutex.lock();
+    for (int n = 0; n < recycledObjects.count(); n++) {
+        const LAUMemoryObject &candidate = recycledObjects.at(n);
+        if (candidate.width() == object.width() && candidate.height() == object.height() && candidate.colors() == object.colors() && candidate.depth() == object.depth() && candidate.frames() == object.frames()) {
+            buffer = recycledObjects.takeAt(n);
+            break;
+        }
+    }
+    mutex.unlock();
+
+    if (buffer.isNull()) {
+        buffer = LAUMemoryObject(object.width(), object.height(), object.colors(), object.depth(), object.frames());
+    }
+    return (buffer);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObject LAUSaveToDiskWriter::copyObject(const LAUMemoryObject &object)
+{
+    LAUMemoryObject copy = recycledObject(object);
+
+    // COPY OVER THE PIXELS AND ALL OF THE METADATA THAT SAVE() WRITES TO DISK
+    memcpy(copy.pointer(), object.constPointer(), object.length());
+    copy.setConstRFID(object.rfid());
+    copy.setConstXML(object.xml());
+    copy.setConstTransform(object.transform());
+    copy.setConstProjection(object.projection());
+    copy.setConstAnchor(object.anchor());
+    copy.setConstElapsed(object.elapsed());
+    copy.setConstJetr(object.jetr());
+
+    return (copy);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUSaveToDiskWriter::run()
+{
+    forever {
+        // WAIT FOR THE NEXT JOB OR FOR THE STOP FLAG ONCE THE QUEUE IS EMPTY
+        mutex.lock();
+        while (jobs.isEmpty() && stopFlag == false) {
+            jobAvailable.wait(&mutex);
+        }
+        if (jobs.isEmpty()) {
+            mutex.unlock();
+            break;
+        }
+        LAUWriteJob job = jobs.dequeue();
+        int rows = stripRows;
+        int threads = compressionThreadCount;
+        mutex.unlock();
+
+        // WRITE EACH FRAME INTO THE NEXT DIRECTORY OF ITS FILE
+        for (int n = 0; n < job.objects.count(); n++) {
+            job.objects.at(n).save(job.file, rows, threads, job.codecs.at(n));
+        }
+
+        if (job.closeFlag) {
+            TIFFClose(job.file);
+
+            // SEE IF WE NEED TO DELETE THIS FILE
+            if (job.deleteFlag && QFile::exists(job.filename)) {
+#if QT_VERSION >= 0x060000
+                QFile(job.filename).moveToTrash();
+#else
+                QFile(job.filename).remove();
+#endif
+            }
+            emit emitFileClosed(job.filename);
+        }
+
+        // RETURN THE WRITTEN BUFFERS TO THE RECYCLE LIST FOR THE NEXT COPY
+        mutex.lock();
+        queueWrittenFrames += job.objects.count();
+        while (job.objects.isEmpty() == false && recycledObjects.count() < 3 * queueCapacity) {
+            recycledObjects << job.objects.takeFirst();
+        }
+        mutex.unlock();
+    }
+}
@@ -23,24 +23,133 @@
 #ifndef LAUSAVETODISKFILTER_H
 #define LAUSAVETODISKFILTER_H
 
+#include <QMutex>
+#include <QQueue>
+#include <QWaitCondition>
+
 #include "lauabstractfilter.h"
 
 #define NUMBER_HEADER_FRAMES 30
+#define NUMBER_QUEUED_FRAMES 32
 
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-class LAUSaveToDiskFilter : public LAUAbstractFilter
+// WRITES VIDEO FRAMES TO DISK ON ITS OWN THREAD SO THAT COMPRESSION AND
+// DISK LATENCY NEVER STALL THE FILTER CHAIN. LIVE FRAMES GO INTO A BOUNDED
+// QUEUE AND ARE COUNTED AS DROPPED WHEN THE QUEUE IS FULL, WHILE HEADER AND
+// TRAILER FRAMES AND FILE CLOSURES ARE ALWAYS ACCEPTED
+class LAUSaveToDiskWriter : public QThread
 {
     Q_OBJECT
 
 public:
-    explicit LAUSaveToDiskFilter(QString dirString, QObject *parent = NULL);
-    ~LAUSaveToDiskFilter()
+    explicit LAUSaveToDiskWriter(int depth = NUMBER_QUEUED_FRAMES, QObject *parent = nullptr);
+    ~LAUSaveToDiskWriter();
+
+    int capacity() const
+    {
+        return (queueCapacity);
+    }
+
+    int depth() const
+    {
+        QMutexLocker locker(&mutex);
+        return (jobs.count());
+    }
+
+    int highWaterMark() const
     {
-        qDebug() << QString("LAUSaveToDiskFilter::~LAUSaveToDiskFilter()");
+        QMutexLocker locker(&mutex);
+        return (queueHighWaterMark);
     }
 
+    int droppedFrames() const
+    {
+        QMutexLocker locker(&mutex);
+        return (queueDroppedFrames);
+    }
+
+    int writtenFrames() const
+    {
+        QMutexLocker locker(&mutex);
+        return (queueWrittenFrames);
+    }
+
+    int rowsPerStrip() const
+    {
+        QMutexLocker locker(&mutex);
+        return (stripRows);
+    }
+
+    void setRowsPerStrip(int rows)
+    {
+        QMutexLocker locker(&mutex);
+        stripRows = qMax(1, rows);
+    }
+
+    int compressionThreads() const
+    {
+        QMutexLocker locker(&mutex);
+        return (compressionThreadCount);
+    }
+
+    void setCompressionThreads(int threads)
+    {
+        QMutexLocker locker(&mutex);
+        compressionThreadCount = qMax(1, threads);
+    }
+
+    bool enqueueFrames(libtiff::TIFF *file, QList<LAUMemoryObject> objects, bool keepFlag = false, QList<LAUMemoryObjectCodec> codecs = QList<LAUMemoryObjectCodec>());
+    bool adoptFrames(libtiff::TIFF *file, QList<LAUMemoryObject> objects, QList<LAUMemoryObjectCodec> codecs = QList<LAUMemoryObjectCodec>());
+    LAUMemoryObject recycledObject(const LAUMemoryObject &object);
+    void enqueueClose(libtiff::TIFF *file, QString filename = QString(), bool deleteFlag = false);
+    void stop();
+
+protected:
+    void run();
+
+private:
+    typedef struct {
+        libtiff::TIFF *file;
+        QList<LAUMemoryObject> objects;
+        QList<LAUMemoryObjectCodec> codecs;
+        QString filename;
+        bool closeFlag;
+        bool deleteFlag;
+    } LAUWriteJob;
+
+    mutable QMutex mutex;
+    QWaitCondition jobAvailable;
+    QQueue<LAUWriteJob> jobs;
+    QList<LAUMemoryObject> recycledObjects;
+
+    int queueCapacity;
+    int queueHighWaterMark;
+    int queueDroppedFrames;
+    int queueWrittenFrames;
+    int stripRows;
+    int compressionThreadCount;
+    bool stopFlag;
+
+    LAUMemoryObject copyObject(const LAUMemoryObject &object);
+    void pushJob(const LAUWriteJob &job);
+
+signals:
+    void emitFileClosed(QString filename);
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+class LAUSaveToDiskFilter : public LAUAbstractFilter
+{
+    Q_OBJECT
+
+public:
+    explicit LAUSaveToDiskFilter(QString dirString, QObject *parent = NULL);
+    ~LAUSaveToDiskFilter();
+
     bool isValid()
     {
         return (directoryString.isEmpty() == false);
@@ -61,6 +170,51 @@ public:
         return (newFileList);
     }
 
+    int queueDepth() const
+    {
+        return (writer->depth());
+    }
+
+    int queueHighWaterMark() const
+    {
+        return (writer->highWaterMark());
+    }
+
+    int droppedFrames() const
+    {
+        return (writer->droppedFrames());
+    }
+
+    LAUMemoryObjectCodec depthCodec() const
+    {
+        return (depthCodecObject);
+    }
+
+    void setDepthCodec(LAUMemoryObjectCodec codec)
+    {
+        depthCodecObject = codec;
+    }
+
+    LAUMemoryObjectCodec colorCodec() const
+    {
+        return (colorCodecObject);
+    }
+
+    void setColorCodec(LAUMemoryObjectCodec codec)
+    {
+        colorCodecObject = codec;
+    }
+
+    LAUMemoryObjectCodec mappingCodec() const
+    {
+        return (mappingCodecObject);
+    }
+
+    void setMappingCodec(LAUMemoryObjectCodec codec)
+    {
+        mappingCodecObject = codec;
+    }
+
 public slots:
     void onRecordButtonClicked(bool flag)
     {
@@ -76,10 +230,14 @@ private:
     bool recordFlag;
     int frameCounter;
     libtiff::TIFF *file;
+    LAUSaveToDiskWriter *writer;
     QString currentFileString;
     LAUMemoryObject header;
     QStringList newFileList;
     QString directoryString;
+    LAUMemoryObjectCodec depthCodecObject;
+    LAUMemoryObjectCodec colorCodecObject;
+    LAUMemoryObjectCodec mappingCodecObject;
 
     typedef struct {
         LAUMemoryObject depth;
@@ -89,8 +247,10 @@ private:
     QList<LAUFrame> headerFrames;
     QList<LAUFrame> trailerFrames;
 
+    void copyFrame(LAUMemoryObject &target, const LAUMemoryObject &source);
     bool closeOldFile(int frames = -1);
     bool openNewFile();
+    bool writeFrame(LAUMemoryObject depth, LAUMemoryObject color, LAUMemoryObject mapping);
     QString getNextFilestring();
 
     QFile logFile;
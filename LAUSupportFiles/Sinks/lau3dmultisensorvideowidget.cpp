@@ -174,15 +174,11 @@ LAU3DMultiSensorVideoWidget::LAU3DMultiSensorVideoWidget(QList<LAUVideoPlaybackD
         qDebug() << "Created LUT cache directory:" << lutCachePath;
     }
 
-    // CLEAN UP OLD LUT FILES (OLDER THAN 24 HOURS)
+    // CLEAN UP LEGACY TIFF LUT CACHE FILES NOW THAT THE CACHE IS VALIDATED BY HASH
     QFileInfoList lutFiles = lutCacheDir.entryInfoList(QStringList() << "*.tif", QDir::Files);
-    QDateTime now = QDateTime::currentDateTime();
     for (const QFileInfo &fileInfo : lutFiles) {
-        qint64 ageInSeconds = fileInfo.lastModified().secsTo(now);
-        if (ageInSeconds > 86400) {  // 24 hours = 86400 seconds
-            QFile::remove(fileInfo.absoluteFilePath());
-            qDebug() << "Removed old LUT cache file:" << fileInfo.fileName() << "(" << (ageInSeconds / 3600) << "hours old)";
-        }
+        QFile::remove(fileInfo.absoluteFilePath());
+        qDebug() << "Removed legacy LUT cache file:" << fileInfo.fileName();
     }
 
     // BUILD LIST OF LOOKUP TABLES FROM ALL CAMERA SENSORS
@@ -204,21 +200,24 @@ LAU3DMultiSensorVideoWidget::LAU3DMultiSensorVideoWidget(QList<LAUVideoPlaybackD
             QString serialNumber = camera->sensorSerial(sensorIndex);
             qDebug() << "Sensor" << n << "serial number:" << serialNumber;
 
-            QString lutCacheFile = lutCachePath + "/" + serialNumber + ".tif";
+            QString lutCacheFile = lutCachePath + "/" + serialNumber + ".lut";
             qDebug() << "  Looking for cache file:" << lutCacheFile;
             qDebug() << "  Cache file exists:" << QFile::exists(lutCacheFile);
 
+            // THE CACHE IS ONLY VALID IF IT WAS BUILT FROM THIS EXACT CALIBRATION
+            QByteArray lutCacheKey = LAULookUpTable::cacheKey(camera->jetr(sensorIndex), camera->sensorMake(sensorIndex), camera->sensorModel(sensorIndex), camera->depthWidth(), camera->depthHeight());
+
             LAULookUpTable lut;
 
-            // TRY TO LOAD FROM CACHE
+            // TRY TO MEMORY MAP THE TABLE FROM CACHE
             if (QFile::exists(lutCacheFile)) {
                 qDebug() << "  Loading cached LUT for sensor" << n << "serial" << serialNumber << "from" << lutCacheFile;
-                lut = LAULookUpTable(lutCacheFile);
+                lut = LAULookUpTable::loadFromCache(lutCacheFile, lutCacheKey);
                 qDebug() << "  Loaded LUT, isValid():" << lut.isValid();
                 if (lut.isValid()) {
                     qDebug() << "  Successfully loaded cached LUT for sensor" << n;
                 } else {
-                    qDebug() << "  Cached LUT invalid, regenerating...";
+                    qDebug() << "  Cached LUT stale or invalid, regenerating...";
                     lut = LAULookUpTable();
                 }
             } else {
@@ -234,7 +233,7 @@ LAU3DMultiSensorVideoWidget::LAU3DMultiSensorVideoWidget(QList<LAUVideoPlaybackD
                 // SAVE TO CACHE IF VALID
                 if (lut.isValid()) {
                     qDebug() << "  Attempting to save LUT to cache:" << lutCacheFile;
-                    if (lut.save(lutCacheFile)) {
+                    if (lut.saveToCache(lutCacheFile, lutCacheKey)) {
                         qDebug() << "  Successfully saved LUT to cache:" << lutCacheFile;
                         // VERIFY FILE WAS ACTUALLY CREATED
                         if (QFile::exists(lutCacheFile)) {
@@ -307,7 +307,7 @@ bool LAU3DVideoPlayerWidget::saveRecordedVideoToDisk()
                     // CREATE A LAUSCAN OBJECT TO WRAP AROUND THE PACKET
                     LAUScan scan(packet, playbackColor);
                     scan.setFilename(string);
-                    scan.save(outputTiff, n);
+                    scan.save(outputTiff);
                 }
                 // CLOSE TIFF FILE
                 TIFFClose(outputTiff);
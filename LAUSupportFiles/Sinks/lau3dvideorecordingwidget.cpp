@@ -30,7 +30,7 @@
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-LAU3DVideoRecordingWidget::LAU3DVideoRecordingWidget(LAUVideoPlaybackColor color, LAUVideoPlaybackDevice device, QWidget *parent) : LAU3DVideoWidget(color, device, parent), videoLabel(nullptr), snapShotModeFlag(false), videoRecordingFlag(false), scannerModeFlag(false), scannerModeTriggerFlag(false)
+LAU3DVideoRecordingWidget::LAU3DVideoRecordingWidget(LAUVideoPlaybackColor color, LAUVideoPlaybackDevice device, QWidget *parent) : LAU3DVideoWidget(color, device, parent), videoLabel(nullptr), framePool(nullptr), snapShotModeFlag(false), videoRecordingFlag(false), scannerModeFlag(false), scannerModeTriggerFlag(false)
 #ifndef EXCLUDE_LAUVELMEXWIDGET
     , velmexWidget(nullptr)
 #endif
@@ -48,21 +48,9 @@ LAU3DVideoRecordingWidget::LAU3DVideoRecordingWidget(LAUVideoPlaybackColor color
         // CREATE A FILTER TO RECORD RAW VIDEO TO DISK
         filter = new LAUSaveToDiskFilter(QString());
 #endif
-        // ALLOCATE FRAME BUFFER MANAGER TO MANAGE MEMORY FOR US
-        frameBufferManager = new LAUMemoryObjectManager(camera->width(), camera->height(), colors(), sizeof(float), camera->sensors(), nullptr);
-
-        // CONNECT SIGNALS AND SLOTS BETWEEN THIS AND THE FRAME BUFFER MANAGER
-        connect(this, SIGNAL(emitGetFrame()), frameBufferManager, SLOT(onGetFrame()), Qt::QueuedConnection);
-        connect(this, SIGNAL(emitReleaseFrame(LAUMemoryObject)), frameBufferManager, SLOT(onReleaseFrame(LAUMemoryObject)), Qt::QueuedConnection);
-        connect(frameBufferManager, SIGNAL(emitFrame(LAUMemoryObject)), this, SLOT(onReceiveFrameBuffer(LAUMemoryObject)), Qt::QueuedConnection);
-
-        // SPIN THE FRAME BUFFER MANAGER INTO ITS OWN THREAD
-        frameBufferManagerController = new LAUController(frameBufferManager);
-
-        // NOW ASK THE FRAME BUFFER MANAGER TO GIVE US A SMALL STASH OF 10 OR SO FRAMES
-        for (int n = videoFramesBufferList.count(); n < 4; n++) {
-            emit emitGetFrame();
-        }
+        // PRE-ALLOCATE A POOL OF FRAME BUFFERS SO RECORDING NEVER WAITS ON THE ALLOCATOR
+        // OR ON A QUEUED SIGNAL ROUND TRIP TO A MANAGER THREAD
+        framePool = new LAUMemoryObjectPool(camera->width(), camera->height(), colors(), sizeof(float), camera->sensors());
     }
 
     // ADD A VIDEO LABEL TO THE BOTTOM OF THE WINDOW
@@ -91,9 +79,9 @@ LAU3DVideoRecordingWidget::LAU3DVideoRecordingWidget(LAUVideoPlaybackColor color
 /****************************************************************************/
 LAU3DVideoRecordingWidget::~LAU3DVideoRecordingWidget()
 {
-    // DELETE ALL ACCUMULATED VIDEO FRAME BUFFERS
-    while (videoFramesBufferList.isEmpty() == false) {
-        emit emitReleaseFrame(videoFramesBufferList.takeFirst());
+    // DELETE THE FRAME BUFFER POOL
+    if (framePool) {
+        delete framePool;
     }
 
 #ifndef EXCLUDE_LAUVELMEXWIDGET
@@ -245,27 +233,15 @@ void LAU3DVideoRecordingWidget::onReceiveVideoFrames(QList<LAUMemoryObject> fram
     }
 }
 
-/****************************************************************************/
-/****************************************************************************/
-/****************************************************************************/
-void LAU3DVideoRecordingWidget::onReceiveFrameBuffer(LAUMemoryObject buffer)
-{
-    videoFramesBufferList << buffer;
-}
-
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
 LAUMemoryObject LAU3DVideoRecordingWidget::getPacket()
 {
-    LAUMemoryObject packet;
-    if (!videoFramesBufferList.isEmpty()) {
-        packet = videoFramesBufferList.takeFirst();
-    }
-    for (int n = videoFramesBufferList.count(); n < 4; n++) {
-        emit emitGetFrame();
+    if (framePool) {
+        return (framePool->acquire());
     }
-    return (packet);
+    return (LAUMemoryObject());
 }
 
 /****************************************************************************/
@@ -287,9 +263,8 @@ void LAU3DVideoRecordingWidget::keyPressEvent(QKeyEvent *event)
 /****************************************************************************/
 void LAU3DVideoRecordingWidget::releasePacket(LAUMemoryObject packet)
 {
-    videoFramesBufferList << packet;
-    while (videoFramesBufferList.count() > 4) {
-        emit emitReleaseFrame(videoFramesBufferList.takeFirst());
+    if (framePool) {
+        framePool->release(packet);
     }
 }
 
@@ -73,7 +73,6 @@ public slots:
 #endif
     void onRecordButtonClicked(bool state = true);
     void onTriggerScanner(float pos, int n, int N);
-    void onReceiveFrameBuffer(LAUMemoryObject buffer);
     void onReceiveVideoFrames(LAUMemoryObject frame);
     void onReceiveVideoFrames(QList<LAUMemoryObject> frameList);
 
@@ -90,7 +89,7 @@ private:
     QElapsedTimer timeStamp;
     QVector4D scannerPosition;
 
-    QList<LAUMemoryObject> videoFramesBufferList;
+    LAUMemoryObjectPool *framePool;
     QList<LAUMemoryObject> recordedVideoFramesBufferList;
 
     bool snapShotModeFlag, videoRecordingFlag, scannerModeFlag, scannerModeTriggerFlag;
@@ -99,10 +98,8 @@ private:
     void releasePacket(LAUMemoryObject packet);
 
 signals:
-    void emitGetFrame();
     void emitVideoFrames(LAUMemoryObject frame);
     void emitVideoFrames(QList<LAUMemoryObject> frameList);
-    void emitReleaseFrame(LAUMemoryObject frame);
     void emitTriggerScanner(float pos, int n, int N);
 };
 
@@ -72,6 +72,10 @@
 #include "lauvzensecamera.h"
 #endif
 
+#if defined(REPLAY)
+#include "laureplaycamera.h"
+#endif
+
 LAU3DCamera *LAU3DCameras::getCamera(LAUVideoPlaybackColor color, LAUVideoPlaybackDevice device)
 {
     LAU3DCamera *camera = nullptr;
@@ -260,11 +264,15 @@ LAU3DCamera *LAU3DCameras::getCamera(LAUVideoPlaybackColor color, LAUVideoPlayba
         idsFilter = NULL;
         idsController = NULL;
         camera = new LAUIDSCamera(color);
+#endif
+        break;
+    case DeviceDemo:
+#if defined(REPLAY)
+        camera = new LAUReplayCamera(QString(), color);
 #endif
         break;
     case Device2DCamera:
     case DeviceUndefined:
-    case DeviceDemo:
         break;
     }
 
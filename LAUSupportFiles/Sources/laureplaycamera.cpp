@@ -0,0 +1,406 @@
+/*********************************************************************************
+ *                                                                               *
+ * Copyright (C) 2025 Dr. Daniel L. Lau                                          *
+ *                                                                               *
+ * This file is part of LAU 3D Video Inspection System.                         *
+ *                                                                               *
+ * LAU 3D Video Inspection System is free software: you can redistribute it     *
+ * and/or modify it under the terms of the GNU Lesser General Public License    *
+ * as published by the Free Software Foundation, either version 3 of the        *
+ * License, or (at your option) any later version.                              *
+ *                                                                               *
+ * LAU 3D Video Inspection System is distributed in the hope that it will be    *
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser      *
+ * General Public License for more details.                                     *
+ *                                                                               *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with LAU 3D Video Inspection System. If not, see                       *
+ * <https://www.gnu.org/licenses/>.                                             *
+ *                                                                               *
+ *********************************************************************************/
+
+#include "laureplaycamera.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+#ifndef HEADLESS
+#include <QFileDialog>
+#endif
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUReplayCamera::LAUReplayCamera(QString filename, LAUVideoPlaybackColor color, QObject *parent) : LAU3DCamera(color, parent), reader(nullptr), replayMode(ModeRealTime), framesPerSecond(LAUREPLAYDEFAULTFRAMERATE), loopFlag(true), firstFrameIndex(0), frameStride(1), numberOfFrames(0), currentFrame(0), endOfRecordingFlag(false), replayCounter(0), scheduledCounter(0), loopOffset(0), anchorElapsed(-1), firstElapsed(0), lastElapsed(0)
+{
+    // LOAD THE REPLAY SETTINGS FROM THE LAST TIME THE CAMERA WAS USED
+    QSettings settings;
+    replayMode = static_cast<ReplayMode>(settings.value("LAUReplayCamera::mode", static_cast<int>(ModeRealTime)).toInt());
+    framesPerSecond = qMax(settings.value("LAUReplayCamera::framesPerSecond", LAUREPLAYDEFAULTFRAMERATE).toDouble(), 0.001);
+    loopFlag = settings.value("LAUReplayCamera::loop", true).toBool();
+
+    // IF THE CALLER DIDN'T GIVE US A RECORDING, TRY THE LAST ONE WE REPLAYED
+    if (filename.isEmpty()) {
+        filename = settings.value("LAUReplayCamera::filename", QString()).toString();
+    }
+
+#ifndef HEADLESS
+    // LET THE USER SELECT A RECORDING FROM THE FILE DIALOG
+    if (filename.isEmpty() || QFile::exists(filename) == false) {
+        QString directory = settings.value("LAUMemoryObject::lastUsedDirectory", QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)).toString();
+        if (QDir().exists(directory) == false) {
+            directory = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+        }
+        filename = QFileDialog::getOpenFileName(nullptr, QString("Load recording to replay (*.tif)"), directory, QString("*.tif;*.tiff"));
+        if (filename.isEmpty() == false) {
+            settings.setValue("LAUMemoryObject::lastUsedDirectory", QFileInfo(filename).absolutePath());
+        }
+    }
+#endif
+
+    if (filename.isEmpty() || QFile::exists(filename) == false) {
+        errorString = QString("No recording selected for replay.");
+        return;
+    }
+
+    // OPEN THE RECORDING ONCE AND KEEP IT OPEN FOR THE LIFE OF THE CAMERA
+    reader = new LAUMemoryObjectReader(filename);
+    if (reader->isNull()) {
+        errorString = QString("Unable to open recording %1.").arg(filename);
+        return;
+    }
+
+    // THE SAVE TO DISK FILTER WRITES THE BACKGROUND AS THE FIRST DIRECTORY
+    // SO TREAT IT AS A HEADER WHENEVER THERE IS MORE THAN ONE DIRECTORY
+    int directories = reader->directories();
+    if (directories > 1) {
+        backgroundObject = reader->read(0);
+        firstFrameIndex = 1;
+    }
+
+    // READ THE FIRST FRAME TO LEARN THE SHAPE OF THE RECORDED VIDEO
+    LAUMemoryObject frameA = reader->read(firstFrameIndex);
+    if (frameA.isNull()) {
+        errorString = QString("Recording %1 has no video frames.").arg(filename);
+        return;
+    }
+
+    // DEPTH IS RECORDED AS SINGLE CHANNEL 16-BIT VIDEO, AND IF THE NEXT DIRECTORY HAS
+    // A DIFFERENT PIXEL FORMAT THEN COLOR FRAMES ARE INTERLEAVED WITH THE DEPTH FRAMES
+    if (frameA.colors() == 1 && frameA.depth() == sizeof(unsigned short)) {
+        depthBuffer = frameA;
+        hasDepthVideo = true;
+        if (firstFrameIndex + 1 < directories) {
+            LAUMemoryObject frameB = reader->read(firstFrameIndex + 1);
+            if (frameB.isValid() && (frameB.colors() != frameA.colors() || frameB.depth() != frameA.depth())) {
+                colorBuffer = frameB;
+                hasColorVideo = true;
+                frameStride = 2;
+            }
+        }
+    } else {
+        colorBuffer = frameA;
+        hasColorVideo = true;
+    }
+    numberOfFrames = (directories - firstFrameIndex) / frameStride;
+    firstElapsed = frameA.elapsed();
+    lastElapsed = firstElapsed;
+
+    // GRAB THE JETR VECTORS THAT WERE STORED WITH THE RECORDING
+    if (frameA.hasValidJETRVector()) {
+        jetrVector = frameA.jetr();
+    } else if (backgroundObject.hasValidJETRVector()) {
+        jetrVector = backgroundObject.jetr();
+    }
+
+    // PULL THE RANGE LIMITS AND SCALE FACTOR OUT OF THE FIRST JETR VECTOR
+    if (jetrVector.count() >= LAUREPLAYJETRLENGTH) {
+        if (std::isfinite(jetrVector.at(34))) {
+            localScaleFactor = jetrVector.at(34);
+        }
+        if (std::isfinite(jetrVector.at(35)) && std::isfinite(jetrVector.at(36))) {
+            zMinDistance = static_cast<unsigned short>(qBound(0.0, jetrVector.at(35), 65535.0));
+            zMaxDistance = static_cast<unsigned short>(qBound(0.0, jetrVector.at(36), 65535.0));
+        }
+    }
+
+    // MULTI-SENSOR RECORDINGS STACK THE SENSORS VERTICALLY IN ONE DIRECTORY WITH ONE JETR
+    // VECTOR PER SENSOR, SO SPLIT THE HEIGHT BACK INTO FRAMES FOR PER-SENSOR LOOK UP TABLES
+    int sensorCount = jetrVector.count() / LAUREPLAYJETRLENGTH;
+    if (hasDepthVideo && sensorCount > 1 && depthBuffer.height() % sensorCount == 0) {
+        depthBuffer = LAUMemoryObject(depthBuffer.width(), depthBuffer.height() / sensorCount, depthBuffer.colors(), depthBuffer.depth(), sensorCount);
+        if (reader->readInto(depthBuffer, firstFrameIndex) == false) {
+            errorString = QString("Unable to split recording %1 into %2 sensors.").arg(filename).arg(sensorCount);
+            return;
+        }
+    }
+
+    // THE MAKE AND MODEL SELECT CAMERA SPECIFIC LOOK UP TABLES, SO LOOK FOR THEM IN THE TIFF
+    // TAGS FIRST, THEN IN THE XML PACKET WHERE THE RECORDER STORES THEM, AND FINALLY FALL BACK
+    // TO THE ONES CONFIGURED FOR REPLAY SO OLDER RECORDINGS CAN STILL BE REPLAYED CORRECTLY
+    makeString = reader->tagString(firstFrameIndex, TIFFTAG_MAKE);
+    modelString = reader->tagString(firstFrameIndex, TIFFTAG_MODEL);
+    QList<QHash<QString, QString> > hashTables;
+    hashTables << LAUMemoryObject::xmlToHash(frameA.xml()) << LAUMemoryObject::xmlToHash(backgroundObject.xml());
+    for (int n = 0; n < hashTables.count(); n++) {
+        if (makeString.isEmpty()) {
+            makeString = hashTables.at(n).value("make");
+        }
+        if (modelString.isEmpty()) {
+            modelString = hashTables.at(n).value("model");
+        }
+    }
+    if (makeString.isEmpty()) {
+        makeString = settings.value("LAUReplayCamera::make", QString()).toString();
+    }
+    if (modelString.isEmpty()) {
+        modelString = settings.value("LAUReplayCamera::model", QString()).toString();
+    }
+    serialString = QFileInfo(filename).completeBaseName();
+    bitsPerPixel = 16;
+
+    // REMEMBER THIS RECORDING FOR THE NEXT TIME
+    settings.setValue("LAUReplayCamera::filename", filename);
+
+    isConnected = true;
+    restart();
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUReplayCamera::~LAUReplayCamera()
+{
+    // SAVE THE REPLAY SETTINGS FOR THE NEXT TIME
+    QSettings settings;
+    settings.setValue("LAUReplayCamera::mode", static_cast<int>(replayMode));
+    settings.setValue("LAUReplayCamera::framesPerSecond", framesPerSecond);
+    settings.setValue("LAUReplayCamera::loop", loopFlag);
+
+    if (reader) {
+        delete reader;
+    }
+    qDebug() << QString("LAUReplayCamera::~LAUReplayCamera()") << replayCounter << "frames replayed";
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUReplayCamera::reset()
+{
+    // REWIND TO THE FIRST FRAME OF THE RECORDING
+    currentFrame = 0;
+    loopOffset = 0;
+    lastElapsed = firstElapsed;
+    endOfRecordingFlag = false;
+    restart();
+
+    return (isValid());
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUReplayCamera::restart()
+{
+    LAU3DCamera::restart();
+
+    // START A NEW SCHEDULE FOR THE FIXED RATE AND REAL TIME MODES
+    replayTimer.restart();
+    scheduledCounter = 0;
+    anchorElapsed = -1;
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUReplayCamera::waitForFrame(qint64 recordedElapsed)
+{
+    qint64 target = 0;
+    if (replayMode == ModeFreeRunning) {
+        // HAND OUT FRAMES AS FAST AS THE DOWNSTREAM PIPELINE RETURNS BUFFERS
+        return;
+    } else if (replayMode == ModeFixedRate) {
+        // SPACE FRAMES EVENLY ACCORDING TO THE REQUESTED FRAME RATE
+        target = qRound64(static_cast<double>(scheduledCounter++) * 1000.0 / framesPerSecond);
+    } else {
+        // SPACE FRAMES ACCORDING TO THE ELAPSED TIMES STORED IN THE RECORDING
+        if (anchorElapsed < 0 || recordedElapsed < anchorElapsed) {
+            anchorElapsed = recordedElapsed;
+            replayTimer.restart();
+        }
+        target = recordedElapsed - anchorElapsed;
+    }
+
+    // SLEEP THE CAMERA THREAD UNTIL IT IS TIME FOR THIS FRAME, THE SAME WAY A
+    // LIVE CAMERA BLOCKS WHILE IT WAITS FOR THE SENSOR TO DELIVER A FRAME
+    qint64 remaining = target - replayTimer.elapsed();
+    if (remaining > 0) {
+        QThread::msleep(static_cast<unsigned long>(remaining));
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUReplayCamera::onUpdateBuffer(LAUMemoryObject depth, LAUMemoryObject color, LAUMemoryObject mapping)
+{
+    depth.constMakeElapsedInvalid();
+    color.constMakeElapsedInvalid();
+    mapping.constMakeElapsedInvalid();
+
+    if (isNull() || numberOfFrames < 1) {
+        emit emitBuffer(depth, color, mapping);
+        return;
+    }
+
+    // SEE IF WE HAVE REACHED THE END OF THE RECORDING
+    if (currentFrame >= numberOfFrames) {
+        if (loopFlag) {
+            // SHIFT THE ELAPSED TIMES OF THE NEXT LAP SO THEY KEEP INCREASING
+            qint64 period = (lastElapsed - firstElapsed) / qMax(1, numberOfFrames - 1);
+            loopOffset += (lastElapsed - firstElapsed) + qMax(period, (qint64)1);
+            currentFrame = 0;
+            anchorElapsed = -1;
+        } else {
+            if (endOfRecordingFlag == false) {
+                endOfRecordingFlag = true;
+                emit emitEndOfRecording();
+            }
+            emit emitBuffer(depth, color, mapping);
+            return;
+        }
+    }
+
+    // SEND THE BACKGROUND OUT AT THE START OF EACH LAP
+    if (currentFrame == 0 && backgroundObject.isValid()) {
+        emit emitBackgroundTexture(backgroundObject);
+    }
+
+    // LOAD THE NEXT FRAME FROM DISK INTO OUR SCRATCH BUFFERS
+    int index = firstFrameIndex + currentFrame * frameStride;
+    bool okay = true;
+    if (hasDepthVideo) {
+        okay = reader->readInto(depthBuffer, index);
+        if (okay && hasColorVideo) {
+            okay = reader->readInto(colorBuffer, index + 1);
+        }
+    } else {
+        okay = reader->readInto(colorBuffer, index);
+    }
+    currentFrame++;
+
+    if (okay == false) {
+        errorString = QString("Unable to read frame %1 from %2.").arg(index).arg(filename());
+        emit emitError(errorString);
+        emit emitBuffer(depth, color, mapping);
+        return;
+    }
+
+    // WAIT UNTIL IT IS TIME TO DELIVER THIS FRAME
+    qint64 recordedElapsed = hasDepthVideo ? depthBuffer.elapsed() : colorBuffer.elapsed();
+    lastElapsed = qMax(lastElapsed, recordedElapsed);
+    waitForFrame(recordedElapsed);
+
+    unsigned int elapsedTime = static_cast<unsigned int>(recordedElapsed + loopOffset);
+
+    // COPY THE RECORDED FRAMES INTO THE CALLER'S BUFFERS ALONG WITH THEIR JETR VECTORS
+    if (depth.isValid() && depthBuffer.isValid()) {
+        memcpy(depth.constPointer(), depthBuffer.constPointer(), qMin(depth.length(), depthBuffer.length()));
+        if (depthBuffer.hasValidJETRVector()) {
+            depth.setConstJetr(depthBuffer.jetr());
+        }
+        depth.setConstElapsed(elapsedTime);
+    }
+
+    if (color.isValid() && colorBuffer.isValid()) {
+        memcpy(color.constPointer(), colorBuffer.constPointer(), qMin(color.length(), colorBuffer.length()));
+        color.setConstElapsed(elapsedTime);
+    }
+
+    replayCounter++;
+    emit emitBuffer(depth, color, mapping);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObject LAUReplayCamera::colorMemoryObject() const
+{
+    if (hasColorVideo) {
+        return (LAUMemoryObject(colorBuffer.width(), colorBuffer.height(), colorBuffer.colors(), colorBuffer.depth(), colorBuffer.frames()));
+    }
+    return (LAUMemoryObject());
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObject LAUReplayCamera::depthMemoryObject() const
+{
+    if (hasDepthVideo) {
+        return (LAUMemoryObject(depthBuffer.width(), depthBuffer.height(), depthBuffer.colors(), depthBuffer.depth(), depthBuffer.frames()));
+    }
+    return (LAUMemoryObject());
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObject LAUReplayCamera::mappiMemoryObject() const
+{
+    return (LAUMemoryObject());
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+QVector<double> LAUReplayCamera::jetr(int chn) const
+{
+    // EACH SENSOR CONTRIBUTES ITS OWN JETR VECTOR TO THE CONCATENATED RECORDED VECTOR
+    if (chn >= 0 && jetrVector.count() >= (chn + 1) * LAUREPLAYJETRLENGTH) {
+        return (jetrVector.mid(chn * LAUREPLAYJETRLENGTH, LAUREPLAYJETRLENGTH));
+    }
+    return (LAU3DCamera::jetr(chn));
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+QList<LAUVideoPlaybackColor> LAUReplayCamera::playbackColors()
+{
+    QList<LAUVideoPlaybackColor> list;
+    if (hasDepthVideo) {
+        list << ColorXYZ;
+    }
+    if (hasColorVideo) {
+        if (colorBuffer.colors() == 1) {
+            list << ColorGray;
+            if (hasDepthVideo) {
+                list << ColorXYZG;
+            }
+        } else {
+            list << ColorRGB;
+            if (hasDepthVideo) {
+                list << ColorXYZRGB;
+            }
+        }
+    }
+    return (list);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAULookUpTable LAUReplayCamera::lut(int chn, QWidget *widget) const
+{
+    // REBUILD THE LOOK UP TABLE FROM THE JETR VECTOR STORED WITH THE RECORDING
+    QVector<double> vector = jetr(chn);
+    if (hasDepthVideo == false || std::isfinite(vector.at(0)) == false) {
+        return (LAULookUpTable());
+    }
+    return (LAULookUpTable::generateTableFromJETR(depthWidth(), depthHeight(), vector, make(), model(), widget));
+}
@@ -0,0 +1,197 @@
+/*********************************************************************************
+ *                                                                               *
+ * Copyright (C) 2025 Dr. Daniel L. Lau                                          *
+ *                                                                               *
+ * This file is part of LAU 3D Video Inspection System.                         *
+ *                                                                               *
+ * LAU 3D Video Inspection System is free software: you can redistribute it     *
+ * and/or modify it under the terms of the GNU Lesser General Public License    *
+ * as published by the Free Software Foundation, either version 3 of the        *
+ * License, or (at your option) any later version.                              *
+ *                                                                               *
+ * LAU 3D Video Inspection System is distributed in the hope that it will be    *
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser      *
+ * General Public License for more details.                                     *
+ *                                                                               *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with LAU 3D Video Inspection System. If not, see                       *
+ * <https://www.gnu.org/licenses/>.                                             *
+ *                                                                               *
+ *********************************************************************************/
+
+#ifndef LAUREPLAYCAMERA_H
+#define LAUREPLAYCAMERA_H
+
+#include <QList>
+#include <QString>
+#include <QObject>
+#include <QDebug>
+#include <QSettings>
+#include <QElapsedTimer>
+
+#include "lau3dcamera.h"
+
+#define LAUREPLAYJETRLENGTH        37
+#define LAUREPLAYDEFAULTFRAMERATE  30.0
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+class LAUReplayCamera : public LAU3DCamera
+{
+    Q_OBJECT
+
+public:
+    enum ReplayMode { ModeRealTime, ModeFixedRate, ModeFreeRunning };
+
+    explicit LAUReplayCamera(QString filename = QString(), LAUVideoPlaybackColor color = ColorXYZ, QObject *parent = nullptr);
+    ~LAUReplayCamera();
+
+    bool reset();
+
+    LAUVideoPlaybackDevice device() const
+    {
+        return (DeviceDemo);
+    }
+
+    QString filename() const
+    {
+        if (reader) {
+            return (reader->filename());
+        }
+        return (QString());
+    }
+
+    unsigned int depthWidth() const
+    {
+        return (depthBuffer.width());
+    }
+
+    unsigned int depthHeight() const
+    {
+        return (depthBuffer.height());
+    }
+
+    unsigned int colorWidth() const
+    {
+        if (colorBuffer.isValid()) {
+            return (colorBuffer.width());
+        }
+        return (depthBuffer.width());
+    }
+
+    unsigned int colorHeight() const
+    {
+        if (colorBuffer.isValid()) {
+            return (colorBuffer.height());
+        }
+        return (depthBuffer.height());
+    }
+
+    unsigned int sensors() const
+    {
+        if (isValid()) {
+            return (qMax(depthBuffer.frames(), colorBuffer.frames()));
+        }
+        return (0);
+    }
+
+    unsigned short maxIntensityValue() const
+    {
+        return (zMaxDistance);
+    }
+
+    ReplayMode mode() const
+    {
+        return (replayMode);
+    }
+
+    void setMode(ReplayMode mode, double fps = LAUREPLAYDEFAULTFRAMERATE)
+    {
+        replayMode = mode;
+        framesPerSecond = qMax(fps, 0.001);
+        restart();
+    }
+
+    bool looping() const
+    {
+        return (loopFlag);
+    }
+
+    void setLooping(bool state)
+    {
+        loopFlag = state;
+    }
+
+    int frameCount() const
+    {
+        return (numberOfFrames);
+    }
+
+    qint64 framesReplayed() const
+    {
+        return (replayCounter);
+    }
+
+    LAUMemoryObject background() const
+    {
+        return (backgroundObject);
+    }
+
+    void restart();
+
+    LAUMemoryObject colorMemoryObject() const;
+    LAUMemoryObject depthMemoryObject() const;
+    LAUMemoryObject mappiMemoryObject() const;
+
+    QVector<double> jetr(int chn = 0) const;
+    QList<LAUVideoPlaybackColor> playbackColors();
+    LAULookUpTable lut(int chn = 0, QWidget *widget = nullptr) const;
+
+public slots:
+    void onUpdateExposure(int microseconds)
+    {
+        Q_UNUSED(microseconds);
+    }
+
+    void onUpdateBuffer(LAUMemoryObject depth = LAUMemoryObject(), LAUMemoryObject color = LAUMemoryObject(), LAUMemoryObject mapping = LAUMemoryObject());
+    void onUpdateBuffer(LAUMemoryObject buffer, int index, void *userData)
+    {
+        emit emitBuffer(buffer, index, userData);
+    }
+
+signals:
+    void emitBackgroundTexture(LAUMemoryObject buffer);
+    void emitEndOfRecording();
+
+private:
+    LAUMemoryObjectReader *reader;
+    LAUMemoryObject backgroundObject;
+    LAUMemoryObject depthBuffer;
+    LAUMemoryObject colorBuffer;
+    QVector<double> jetrVector;
+
+    ReplayMode replayMode;
+    double framesPerSecond;
+    bool loopFlag;
+
+    int firstFrameIndex;
+    int frameStride;
+    int numberOfFrames;
+    int currentFrame;
+    bool endOfRecordingFlag;
+
+    qint64 replayCounter;
+    qint64 scheduledCounter;
+    qint64 loopOffset;
+    qint64 anchorElapsed;
+    qint64 firstElapsed;
+    qint64 lastElapsed;
+
+    QElapsedTimer replayTimer;
+
+    void waitForFrame(qint64 recordedElapsed);
+};
+
+#endif // LAUREPLAYCAMERA_H
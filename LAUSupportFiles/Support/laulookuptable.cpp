@@ -30,12 +30,45 @@
 #include <QThreadPool>
 #endif
 
+#include <QSaveFile>
+#include <QCryptographicHash>
+
 #include <locale.h>
 #include <stdint.h>
 #include <math.h>
 
 int LAULookUpTableData::instanceCounter = 0;
 
+// Fixed header at the front of a binary look up table cache file; the phase
+// correction table and the table itself follow at page aligned offsets
+typedef struct {
+    char magic[8];
+    quint32 version;
+    quint32 headerSize;
+    char key[32];
+    quint32 numCols;
+    quint32 numRows;
+    quint32 numChns;
+    quint32 style;
+    float scaleFactor;
+    float xMin, xMax, yMin, yMax, zMin, zMax, pMin, pMax;
+    float horizontalFieldOfView;
+    float verticalFieldOfView;
+    LookUpTableIntrinsics intrinsics;
+    LookUpTableBoundingBox boundingBox;
+    float transform[16];
+    float projection[16];
+    char makeString[64];
+    char modelString[64];
+    char serialString[64];
+    quint64 phaseOffset;
+    quint64 bufferOffset;
+    quint64 fileSize;
+} LAULookUpTableCacheHeader;
+
+#define LAULOOKUPTABLECACHEMAGIC    "LAULUTC1"
+#define LAULOOKUPTABLECACHEPAGESIZE 4096
+
 using namespace libtiff;
 
 // Structure to hold parameters for concurrent row processing
@@ -49,48 +82,96 @@ struct RowProcessingParams {
     double sclFactor;
     LAUMemoryObject* idealWorldCoordinates;
     float* buffer;
-    float* xMinPtr;
-    float* xMaxPtr;
-    float* yMinPtr;
-    float* yMaxPtr;
+    float xMin;
+    float xMax;
+    float yMin;
+    float yMax;
     double zMin;
     double zMax;
 };
 
+// Plain copy of the camera intrinsics so the inner loop avoids Qt containers
+struct DistortionModel {
+    double fx, fy, cx, cy;
+    double k[6];
+    double p[2];
+};
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-QPointF getDistortedCoordinates(QVector3D point, QMatrix3x3 intParameters, QVector<double> rdlParameters, QVector<double> tngParameters)
+static inline void distortNormalizedCoordinates(const DistortionModel &model, double x, double y, double *xd, double *yd, double *jacobian)
 {
-    // CREATE A QPOINTF TO RETURN TO THE USER
-    QPointF distortedCoodinates;
-
-    // NORMALIZE THE INCOMING WORLD COORDINATE BY Z
-    point = point / point.z();
-
     // CALCULATE THE INTERMEDIATE DISTORTION PARAMETER R AND GAMMA
-    double r = point.x()*point.x() + point.y()*point.y();
-    double g = (1.0 + rdlParameters[0]*r + rdlParameters[1]*r*r + rdlParameters[2]*r*r*r) / (1.0 + rdlParameters[3]*r + rdlParameters[4]*r*r + rdlParameters[5]*r*r*r);
-
-    // CALCULATE THE NORMALIZED WORLD COORDINATES AFTER RADIAL DISTORTION
-    double x = point.x()*g + 2.0*tngParameters[0]*point.x()*point.y() + tngParameters[1]*(r + 2.0*point.x()*point.x());
-    double y = point.y()*g + 2.0*tngParameters[1]*point.x()*point.y() + tngParameters[0]*(r + 2.0*point.y()*point.y());
-
-    // NOW PROJECT DISTORTED WORLD COORDINATE TO CAMERA COORDINATE USING PIN HOLE CAMERA MODEL
-    distortedCoodinates.setX(intParameters(0, 0)*x + intParameters(0, 2));
-    distortedCoodinates.setY(intParameters(1, 1)*y + intParameters(1, 2));
-
-    return(distortedCoodinates);
+    double r = x*x + y*y;
+    double num = 1.0 + r*(model.k[0] + r*(model.k[1] + r*model.k[2]));
+    double den = 1.0 + r*(model.k[3] + r*(model.k[4] + r*model.k[5]));
+    double g = num / den;
+
+    // CALCULATE THE NORMALIZED WORLD COORDINATES AFTER RADIAL AND TANGENTIAL DISTORTION
+    *xd = x*g + 2.0*model.p[0]*x*y + model.p[1]*(r + 2.0*x*x);
+    *yd = y*g + 2.0*model.p[1]*x*y + model.p[0]*(r + 2.0*y*y);
+
+    // CALCULATE THE 2X2 JACOBIAN OF THE DISTORTION WITH RESPECT TO X AND Y
+    if (jacobian) {
+        double dNum = model.k[0] + r*(2.0*model.k[1] + r*3.0*model.k[2]);
+        double dDen = model.k[3] + r*(2.0*model.k[4] + r*3.0*model.k[5]);
+        double dg = (dNum*den - num*dDen) / (den*den);
+
+        jacobian[0] = g + 2.0*x*x*dg + 2.0*model.p[0]*y + 6.0*model.p[1]*x;
+        jacobian[1] = 2.0*x*y*dg + 2.0*model.p[0]*x + 2.0*model.p[1]*y;
+        jacobian[2] = 2.0*x*y*dg + 2.0*model.p[1]*y + 2.0*model.p[0]*x;
+        jacobian[3] = g + 2.0*y*y*dg + 2.0*model.p[1]*x + 6.0*model.p[0]*y;
+    }
 }
 
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-double distanceBetweenTwoPoints(QPointF pointA, QPointF pointB)
+static inline double undistortNormalizedCoordinates(const DistortionModel &model, double xt, double yt, double *x, double *y)
 {
-    QPointF pointC = pointA - pointB;
-
-    return(sqrt(pointC.x()*pointC.x() + pointC.y()*pointC.y()));
+    // USE DAMPED NEWTON ITERATIONS TO FIND THE UNDISTORTED COORDINATE THAT
+    // DISTORTS ONTO THE TARGET, RETURNING THE RESIDUAL ERROR IN PIXELS
+    double xd, yd, jacobian[4];
+    distortNormalizedCoordinates(model, *x, *y, &xd, &yd, jacobian);
+    double ex = xd - xt;
+    double ey = yd - yt;
+    double error = ex*ex*model.fx*model.fx + ey*ey*model.fy*model.fy;
+
+    for (int iter = 0; iter < 20 && error > 1e-12; iter++) {
+        double det = jacobian[0]*jacobian[3] - jacobian[1]*jacobian[2];
+        if (fabs(det) < 1e-12) {
+            break;
+        }
+        double dx = (jacobian[3]*ex - jacobian[1]*ey) / det;
+        double dy = (jacobian[0]*ey - jacobian[2]*ex) / det;
+
+        // BACK OFF THE STEP UNTIL THE RESIDUAL ACTUALLY DECREASES
+        bool improved = false;
+        for (double step = 1.0; step > 1.0/64.0; step *= 0.5) {
+            double xn = *x - step*dx;
+            double yn = *y - step*dy;
+            double xdn, ydn, jacobianN[4];
+            distortNormalizedCoordinates(model, xn, yn, &xdn, &ydn, jacobianN);
+            double exn = xdn - xt;
+            double eyn = ydn - yt;
+            double errorN = exn*exn*model.fx*model.fx + eyn*eyn*model.fy*model.fy;
+            if (errorN < error) {
+                *x = xn;
+                *y = yn;
+                ex = exn;
+                ey = eyn;
+                error = errorN;
+                memcpy(jacobian, jacobianN, sizeof(jacobian));
+                improved = true;
+                break;
+            }
+        }
+        if (improved == false) {
+            break;
+        }
+    }
+    return (sqrt(error));
 }
 
 /****************************************************************************/
@@ -100,6 +181,19 @@ void processRow(RowProcessingParams& params) {
     int row = params.row;
     unsigned int width = params.width;
     float* buffer = params.buffer + (row * width * 12); // 12 channels per pixel
+    double* ideal = (double*)params.idealWorldCoordinates->constScanLine(row);
+
+    // Copy the intrinsics into plain doubles once per row
+    DistortionModel model;
+    model.fx = params.intParameters(0, 0);
+    model.fy = params.intParameters(1, 1);
+    model.cx = params.intParameters(0, 2);
+    model.cy = params.intParameters(1, 2);
+    for (int n = 0; n < 6; n++) {
+        model.k[n] = params.rdlParameters[n];
+    }
+    model.p[0] = params.tngParameters[0];
+    model.p[1] = params.tngParameters[1];
 
     // Local min/max values for this row
     float localXMin = +1e10;
@@ -108,59 +202,28 @@ void processRow(RowProcessingParams& params) {
     float localYMax = -1e10;
 
     double errorOpt = 1e6;
-    double xw = 0.0, yw = 0.0, zw = 0.0;
+    double xn = 0.0, yn = 0.0, zw = 0.0;
 
     for (int col = 0; col < (int)width; col++) {
-        double xi = (double) col;
-        double yi = (double) row;
+        // Target pixel in normalized camera coordinates
+        double xt = ((double)col - model.cx) / model.fx;
+        double yt = ((double)row - model.cy) / model.fy;
 
-        // If this is the first column in a row, then set the position
+        // Start from the ideal pin hole position unless the previous column converged
+        zw = ideal[3*col + 2];
         if (errorOpt > 1.0) {
-            xw = ((double*)params.idealWorldCoordinates->scanLine(row))[3*col + 0];
-            yw = ((double*)params.idealWorldCoordinates->scanLine(row))[3*col + 1];
-            zw = ((double*)params.idealWorldCoordinates->scanLine(row))[3*col + 2];
-        }
-
-        for (int k = 0; k < 4; k++) {
-            double dlt = 1.0;
-            switch (k) {
-            case 0: dlt = 1.0; break;
-            case 1: dlt = 0.5; break;
-            case 2: dlt = 0.25; break;
-            case 3: dlt = 0.125; break;
-            }
-
-            while (1) {
-                QPointF cO = getDistortedCoordinates(QVector3D(xw+0.0, yw+0.0, zw), params.intParameters, params.rdlParameters, params.tngParameters);
-                QPointF cA = getDistortedCoordinates(QVector3D(xw-dlt, yw+0.0, zw), params.intParameters, params.rdlParameters, params.tngParameters);
-                QPointF cB = getDistortedCoordinates(QVector3D(xw+dlt, yw+0.0, zw), params.intParameters, params.rdlParameters, params.tngParameters);
-                QPointF cC = getDistortedCoordinates(QVector3D(xw+0.0, yw-dlt, zw), params.intParameters, params.rdlParameters, params.tngParameters);
-                QPointF cD = getDistortedCoordinates(QVector3D(xw+0.0, yw+dlt, zw), params.intParameters, params.rdlParameters, params.tngParameters);
-
-                double eO = distanceBetweenTwoPoints(cO, QPointF(xi, yi));
-                double eA = distanceBetweenTwoPoints(cA, QPointF(xi, yi));
-                double eB = distanceBetweenTwoPoints(cB, QPointF(xi, yi));
-                double eC = distanceBetweenTwoPoints(cC, QPointF(xi, yi));
-                double eD = distanceBetweenTwoPoints(cD, QPointF(xi, yi));
-
-                errorOpt = qMin(eO, qMin(eA, qMin(eB, qMin(eC, eD))));
-                if (eA == errorOpt) {
-                    xw = xw - dlt;
-                } else if (eB == errorOpt) {
-                    xw = xw + dlt;
-                } else if (eC == errorOpt) {
-                    yw = yw - dlt;
-                } else if (eD == errorOpt) {
-                    yw = yw + dlt;
-                } else {
-                    break;
-                }
-            }
+            xn = ideal[3*col + 0] / zw;
+            yn = ideal[3*col + 1] / zw;
         }
 
-        ((double*)params.idealWorldCoordinates->scanLine(row))[3*col + 0] = xw;
-        ((double*)params.idealWorldCoordinates->scanLine(row))[3*col + 1] = yw;
-        ((double*)params.idealWorldCoordinates->scanLine(row))[3*col + 2] = zw;
+        errorOpt = undistortNormalizedCoordinates(model, xt, yt, &xn, &yn);
+
+        double xw = xn * zw;
+        double yw = yn * zw;
+
+        ideal[3*col + 0] = xw;
+        ideal[3*col + 1] = yw;
+        ideal[3*col + 2] = zw;
 
         int index = col * 12;
 
@@ -196,15 +259,11 @@ void processRow(RowProcessingParams& params) {
         buffer[index++] = NAN;
     }
 
-    // Update global min/max values atomically
-    if (localXMin < 1e9) {
-        static QMutex mutex;
-        QMutexLocker locker(&mutex);
-        *(params.xMinPtr) = qMin(*(params.xMinPtr), localXMin);
-        *(params.xMaxPtr) = qMax(*(params.xMaxPtr), localXMax);
-        *(params.yMinPtr) = qMin(*(params.yMinPtr), localYMin);
-        *(params.yMaxPtr) = qMax(*(params.yMaxPtr), localYMax);
-    }
+    // Keep the limits with this row; they are merged once all rows finish
+    params.xMin = localXMin;
+    params.xMax = localXMax;
+    params.yMin = localYMin;
+    params.yMax = localYMax;
 }
 
 /****************************************************************************/
@@ -241,6 +300,7 @@ LAULookUpTableData::LAULookUpTableData()
 
     buffer = nullptr;
     phaseCorrectionBuffer = nullptr;
+    mappedFile = nullptr;
     transformMatrix = nullptr;
     projectionMatrix = nullptr;
 }
@@ -290,7 +350,13 @@ LAULookUpTableData::LAULookUpTableData(const LAULookUpTableData &other) : LAULoo
 LAULookUpTableData::~LAULookUpTableData()
 {
     qDebug() << QString("LAULookUpTableData::~LAULookUpTableData() %1").arg(--instanceCounter);
-    if (buffer != nullptr) {
+    if (mappedFile != nullptr) {
+        // THE BUFFERS POINT INTO A MEMORY MAPPED CACHE FILE SO JUST CLOSE IT
+        mappedFile->close();
+        delete mappedFile;
+        delete transformMatrix;
+        delete projectionMatrix;
+    } else if (buffer != nullptr) {
         _mm_free(buffer);
         _mm_free(phaseCorrectionBuffer);
         delete transformMatrix;
@@ -298,6 +364,77 @@ LAULookUpTableData::~LAULookUpTableData()
     }
 }
 
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAULookUpTableData::mapBuffer(const QString &flnm, const QByteArray &key)
+{
+    QFile *file = new QFile(flnm);
+    if (file->open(QIODevice::ReadOnly) == false || file->size() < (qint64)sizeof(LAULookUpTableCacheHeader)) {
+        delete file;
+        return (false);
+    }
+
+    // MAP THE WHOLE FILE PRIVATELY SO ANY EDITS TO THE TABLE STAY IN THIS PROCESS
+    uchar *pointer = file->map(0, file->size(), QFileDevice::MapPrivateOption);
+    if (pointer == nullptr) {
+        delete file;
+        return (false);
+    }
+
+    // VALIDATE THE HEADER BEFORE TRUSTING ANY OF THE OFFSETS INSIDE IT
+    const LAULookUpTableCacheHeader *header = (const LAULookUpTableCacheHeader *)pointer;
+    unsigned long long samples = (unsigned long long)header->numRows * (unsigned long long)header->numCols * (unsigned long long)header->numChns;
+    bool valid = (memcmp(header->magic, LAULOOKUPTABLECACHEMAGIC, 8) == 0);
+    valid = valid && (header->version == LAULOOKUPTABLECACHEVERSION);
+    valid = valid && (header->headerSize == sizeof(LAULookUpTableCacheHeader));
+    valid = valid && (key.length() == (int)sizeof(header->key)) && (memcmp(header->key, key.constData(), sizeof(header->key)) == 0);
+    valid = valid && (header->fileSize == (quint64)file->size());
+    valid = valid && (samples > 0);
+    valid = valid && (header->phaseOffset + LENGTHPHASECORRECTIONTABLE * sizeof(float) <= header->fileSize);
+    valid = valid && (header->bufferOffset + samples * sizeof(float) <= header->fileSize);
+    if (valid == false) {
+        file->close();
+        delete file;
+        return (false);
+    }
+
+    filename = flnm;
+    makeString = QString::fromUtf8(header->makeString, (int)strnlen(header->makeString, sizeof(header->makeString)));
+    modelString = QString::fromUtf8(header->modelString, (int)strnlen(header->modelString, sizeof(header->modelString)));
+    serialString = QString::fromUtf8(header->serialString, (int)strnlen(header->serialString, sizeof(header->serialString)));
+    style = (LAULookUpTableStyle)header->style;
+    scaleFactor = header->scaleFactor;
+    xMin = header->xMin;
+    xMax = header->xMax;
+    yMin = header->yMin;
+    yMax = header->yMax;
+    zMin = header->zMin;
+    zMax = header->zMax;
+    pMin = header->pMin;
+    pMax = header->pMax;
+    horizontalFieldOfView = header->horizontalFieldOfView;
+    verticalFieldOfView = header->verticalFieldOfView;
+    intrinsics = header->intrinsics;
+    boundingBox = header->boundingBox;
+
+    numRows = header->numRows;
+    numCols = header->numCols;
+    numChns = header->numChns;
+    numSmps = samples;
+
+    // POINT THE BUFFERS STRAIGHT AT THE MAPPED FILE INSTEAD OF ALLOCATING AND COPYING
+    mappedFile = file;
+    buffer = (void *)(pointer + header->bufferOffset);
+    phaseCorrectionBuffer = (void *)(pointer + header->phaseOffset);
+    transformMatrix = new QMatrix4x4();
+    projectionMatrix = new QMatrix4x4();
+    memcpy((void *)transformMatrix->data(), (void *)header->transform, sizeof(header->transform));
+    memcpy((void *)projectionMatrix->data(), (void *)header->projection, sizeof(header->projection));
+
+    return (true);
+}
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -864,10 +1001,10 @@ LAULookUpTable::LAULookUpTable(unsigned int cols, unsigned int rows, QMatrix3x3
         params.sclFactor = sclFactor;
         params.idealWorldCoordinates = &idealWorldCoordinates;
         params.buffer = buffer;
-        params.xMinPtr = &data->xMin;
-        params.xMaxPtr = &data->xMax;
-        params.yMinPtr = &data->yMin;
-        params.yMaxPtr = &data->yMax;
+        params.xMin = +1e10;
+        params.xMax = -1e10;
+        params.yMin = +1e10;
+        params.yMax = -1e10;
         params.zMin = zMin;
         params.zMax = zMax;
         rowParams.append(params);
@@ -938,6 +1075,16 @@ LAULookUpTable::LAULookUpTable(unsigned int cols, unsigned int rows, QMatrix3x3
 #else
     QtConcurrent::blockingMap(rowParams, processRow);
 #endif
+
+    // MERGE THE PER ROW LIMITS NOW THAT ALL THE WORKERS HAVE FINISHED
+    for (int row = 0; row < rowParams.count(); row++) {
+        if (rowParams.at(row).xMin < 1e9) {
+            data->xMin = qMin(data->xMin, rowParams.at(row).xMin);
+            data->xMax = qMax(data->xMax, rowParams.at(row).xMax);
+            data->yMin = qMin(data->yMin, rowParams.at(row).yMin);
+            data->yMax = qMax(data->yMax, rowParams.at(row).yMax);
+        }
+    }
     //idealWorldCoordinates.save(QString("C:/Users/Public/Pictures/idealDistorted.tif"));
 #else
     QVector<double> k(3), p(2);
@@ -2367,3 +2514,98 @@ void LAULookUpTableLoader::run()
         }
     }
 }
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+QByteArray LAULookUpTable::cacheKey(QVector<double> justEnoughToReconstructVector, const QString &make, const QString &model, unsigned int cols, unsigned int rows)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QByteArray((const char *)justEnoughToReconstructVector.constData(), justEnoughToReconstructVector.count() * (int)sizeof(double)));
+    hash.addData(make.toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(model.toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(QByteArray((const char *)&cols, sizeof(cols)));
+    hash.addData(QByteArray((const char *)&rows, sizeof(rows)));
+    return (hash.result());
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAULookUpTable LAULookUpTable::loadFromCache(const QString &filename, const QByteArray &key)
+{
+    LAULookUpTable table;
+    if (QFile::exists(filename)) {
+        if (table.data->mapBuffer(filename, key) == false) {
+            return (LAULookUpTable());
+        }
+    }
+    return (table);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAULookUpTable::saveToCache(const QString &filename, const QByteArray &key) const
+{
+    if (isNull() || key.length() != 32) {
+        return (false);
+    }
+
+    // BUILD THE HEADER WITH THE PAYLOADS AT PAGE ALIGNED OFFSETS
+    LAULookUpTableCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LAULOOKUPTABLECACHEMAGIC, 8);
+    header.version = LAULOOKUPTABLECACHEVERSION;
+    header.headerSize = sizeof(LAULookUpTableCacheHeader);
+    memcpy(header.key, key.constData(), sizeof(header.key));
+    header.numCols = data->numCols;
+    header.numRows = data->numRows;
+    header.numChns = data->numChns;
+    header.style = (quint32)data->style;
+    header.scaleFactor = data->scaleFactor;
+    header.xMin = data->xMin;
+    header.xMax = data->xMax;
+    header.yMin = data->yMin;
+    header.yMax = data->yMax;
+    header.zMin = data->zMin;
+    header.zMax = data->zMax;
+    header.pMin = data->pMin;
+    header.pMax = data->pMax;
+    header.horizontalFieldOfView = data->horizontalFieldOfView;
+    header.verticalFieldOfView = data->verticalFieldOfView;
+    header.intrinsics = data->intrinsics;
+    header.boundingBox = data->boundingBox;
+    memcpy(header.transform, transform().constData(), sizeof(header.transform));
+    memcpy(header.projection, projection().constData(), sizeof(header.projection));
+    strncpy(header.makeString, data->makeString.toUtf8().constData(), sizeof(header.makeString) - 1);
+    strncpy(header.modelString, data->modelString.toUtf8().constData(), sizeof(header.modelString) - 1);
+    strncpy(header.serialString, data->serialString.toUtf8().constData(), sizeof(header.serialString) - 1);
+
+    quint64 phaseBytes = LENGTHPHASECORRECTIONTABLE * sizeof(float);
+    quint64 tableBytes = data->numSmps * sizeof(float);
+    header.phaseOffset = LAULOOKUPTABLECACHEPAGESIZE;
+    header.bufferOffset = header.phaseOffset + ((phaseBytes + LAULOOKUPTABLECACHEPAGESIZE - 1) / LAULOOKUPTABLECACHEPAGESIZE) * LAULOOKUPTABLECACHEPAGESIZE;
+    header.fileSize = header.bufferOffset + tableBytes;
+
+    // WRITE TO A TEMPORARY FILE AND ONLY REPLACE THE OLD CACHE WHEN COMPLETE
+    QSaveFile file(filename);
+    if (file.open(QIODevice::WriteOnly) == false) {
+        return (false);
+    }
+
+    QByteArray padding(LAULOOKUPTABLECACHEPAGESIZE, '\0');
+    bool flag = (file.write((const char *)&header, sizeof(header)) == (qint64)sizeof(header));
+    flag = flag && (file.write(padding.constData(), (qint64)(header.phaseOffset - sizeof(header))) == (qint64)(header.phaseOffset - sizeof(header)));
+    flag = flag && (file.write((const char *)data->phaseCorrectionBuffer, (qint64)phaseBytes) == (qint64)phaseBytes);
+    flag = flag && (file.write(padding.constData(), (qint64)(header.bufferOffset - header.phaseOffset - phaseBytes)) == (qint64)(header.bufferOffset - header.phaseOffset - phaseBytes));
+    flag = flag && (file.write((const char *)data->buffer, (qint64)tableBytes) == (qint64)tableBytes);
+
+    if (flag == false) {
+        file.cancelWriting();
+        return (false);
+    }
+    return (file.commit());
+}
@@ -38,6 +38,7 @@
 #endif
 
 #define LENGTHPHASECORRECTIONTABLE  4096
+#define LAULOOKUPTABLECACHEVERSION  1
 
 using namespace LAU3DVideoParameters;
 
@@ -92,6 +93,7 @@ public:
 
     void *buffer;
     void *phaseCorrectionBuffer;
+    QFile *mappedFile;
 
     QMatrix4x4 *transformMatrix;
     QMatrix4x4 *projectionMatrix;
@@ -108,6 +110,7 @@ public:
     static int instanceCounter;
 
     void allocateBuffer();
+    bool mapBuffer(const QString &filename, const QByteArray &key);
 };
 
 /****************************************************************************/
@@ -142,6 +145,12 @@ public:
     static bool saveLookUpTables(QList<LAULookUpTable> tables, QString filename = QString());
     static QList<LAULookUpTable> LAULookUpTableX(QString filename);
 
+    // BINARY CACHE FILES THAT ARE MEMORY MAPPED ON LOAD AND VALIDATED AGAINST A
+    // HASH OF THE JETR VECTOR, CAMERA MAKE AND MODEL, AND TABLE RESOLUTION
+    static QByteArray cacheKey(QVector<double> justEnoughToReconstructVector, const QString &make, const QString &model, unsigned int cols, unsigned int rows);
+    static LAULookUpTable loadFromCache(const QString &filename, const QByteArray &key);
+    bool saveToCache(const QString &filename, const QByteArray &key) const;
+
     LAULookUpTable convertToStyle(LAULookUpTableStyle stl) const;
     LAUMemoryObject createRangeMasks(float xmn, float xmx, float ymn, float ymx, float zmn, float zmx) const;
 
@@ -22,11 +22,16 @@
 
 #include <stdio.h>
 
+#include <QDir>
 #include <QFile>
 #include <QtMath>
 #include <QBuffer>
 #include <QDateTime>
 #include <QXmlStreamReader>
+#include <QtConcurrent>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDataStream>
 
 #ifndef HEADLESS
 #include <QSettings>
@@ -36,12 +41,40 @@
 
 #include "laumemoryobject.h"
 
+#if defined(LAUMEMORYOBJECTAVXDISPATCH) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 using namespace libtiff;
 
 int LAUMemoryObjectData::instanceCounter = 0;
 
-QString LAUMemoryObject::lastTiffWarningString;
-QString LAUMemoryObject::lastTiffErrorString;
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// REGISTER OUR PRIVATE TIFF TAGS WITH EVERY TIFF FILE LIBTIFF OPENS SO THEY CAN
+// BE READ AND WRITTEN LIKE ANY OTHER TAG, CHAINING TO ANY EARLIER EXTENDER
+static TIFFExtendProc parentTagExtender = nullptr;
+
+static void lauTagExtender(TIFF *tiff)
+{
+    static const TIFFFieldInfo fieldInfo[] = {
+        { LAUMEMORYOBJECTTIFFTAG_BITSHIFT, 1, 1, TIFF_SHORT, FIELD_CUSTOM, 1, 0, const_cast<char *>("LAUBitShift") }
+    };
+    TIFFMergeFieldInfo(tiff, fieldInfo, sizeof(fieldInfo) / sizeof(fieldInfo[0]));
+
+    if (parentTagExtender) {
+        (*parentTagExtender)(tiff);
+    }
+}
+
+static bool lauTagExtenderRegistered = (parentTagExtender = TIFFSetTagExtender(lauTagExtender), true);
+
+// VECTOR INSTRUCTION LEVEL USED BY THE DISPATCHING KERNELS, OR -1 UNTIL THE CPU HAS BEEN QUERIED
+static QAtomicInt lauSimdLevel(-1);
+
+thread_local QString LAUMemoryObject::lastTiffWarningString;
+thread_local QString LAUMemoryObject::lastTiffErrorString;
 
 /****************************************************************************/
 /****************************************************************************/
@@ -54,7 +87,7 @@ void myTIFFWarningHandler(const char *stringA, const char *stringB, va_list args
 #ifdef Q_OS_WIN
     int length = vsprintf_s(buffer, (char *)stringB, args);
 #else
-    int length = vsprintf(buffer, (char *)stringB, args);
+    int length = qMin(vsnprintf(buffer, sizeof(buffer), (char *)stringB, args), (int)sizeof(buffer) - 1);
 #endif
     LAUMemoryObject::lastTiffWarningString = QString(QByteArray(buffer, length));
 }
@@ -70,7 +103,7 @@ void myTIFFErrorHandler(const char *stringA, const char *stringB, va_list args)
 #ifdef Q_OS_WIN
     int length = vsprintf_s(buffer, (char *)stringB, args);
 #else
-    int length = vsprintf(buffer, (char *)stringB, args);
+    int length = qMin(vsnprintf(buffer, sizeof(buffer), (char *)stringB, args), (int)sizeof(buffer) - 1);
 #endif
     LAUMemoryObject::lastTiffErrorString = QString(QByteArray(buffer, length));
 }
@@ -219,33 +252,23 @@ LAUMemoryObjectData::LAUMemoryObjectData(const LAUMemoryObjectData &other) : LAU
     numByts = other.numByts;
     numFrms = other.numFrms;
 
-    // SET THESE VARIABLES TO ZERO AND LET THEM BE MODIFIED IN THE ALLOCATION METHOD
-    buffer = nullptr;
-    xmlByteArray = nullptr;
-    rfidString = nullptr;
-    transformMatrix = nullptr;
-    projectionMatrix = nullptr;
-    anchorPt = nullptr;
-    elapsedTime = nullptr;
-    jetr = nullptr;
-
-    stepBytes = 0;
-    frameBytes = 0;
-    numBytesTotal = 0;
+    stepBytes = other.stepBytes;
+    frameBytes = other.frameBytes;
+    numBytesTotal = other.numBytesTotal;
 
-    allocateBuffer();
+    // SHARE THE PIXELS WITH THE SUPPLIED OBJECT AND ONLY COPY THE METADATA, LEAVING
+    // IT TO DETACHBUFFER() TO COPY THE PIXELS IF EITHER OBJECT WRITES TO THEM LATER
+    pixels = other.pixels;
+    buffer = other.buffer;
     if (buffer) {
-        memcpy(buffer, other.buffer, numBytesTotal);
-        xmlByteArray->clear();
-        xmlByteArray->append(*(other.xmlByteArray));
-        rfidString->clear();
-        rfidString->append(*(other.rfidString));
-        memcpy((void *)transformMatrix->constData(), (void *)other.transformMatrix->constData(), sizeof(QMatrix4x4));
-        memcpy((void *)projectionMatrix->constData(), (void *)other.projectionMatrix->constData(), sizeof(QMatrix4x4));
-        anchorPt->setX(other.anchorPt->x());
-        anchorPt->setY(other.anchorPt->y());
+        xmlByteArray = new QByteArray(*(other.xmlByteArray));
+        rfidString = new QString(*(other.rfidString));
+        transformMatrix = new QMatrix4x4(*(other.transformMatrix));
+        projectionMatrix = new QMatrix4x4(*(other.projectionMatrix));
+        anchorPt = new QPoint(*(other.anchorPt));
+        elapsedTime = new unsigned int;
         *elapsedTime = *other.elapsedTime;
-        *jetr = *other.jetr;
+        jetr = new QVector<double>(*(other.jetr));
     }
 }
 
@@ -254,11 +277,9 @@ LAUMemoryObjectData::LAUMemoryObjectData(const LAUMemoryObjectData &other) : LAU
 /****************************************************************************/
 LAUMemoryObjectData::~LAUMemoryObjectData()
 {
+    // THE PIXELS ARE RELEASED BY THE LAST OBJECT HOLDING ON TO THEM
     if (buffer != NULL) {
-        instanceCounter = instanceCounter - 1;
-        qDebug() << QString("LAUMemoryObjectData::~LAUMemoryObjectData() %1").arg(instanceCounter) << numRows << numCols << numChns << numByts << numFrms << numBytesTotal;
-        _mm_free(buffer);
-
+        delete xmlByteArray;
         delete rfidString;
         delete transformMatrix;
         delete projectionMatrix;
@@ -281,16 +302,17 @@ void LAUMemoryObjectData::allocateBuffer()
     numBytesTotal *= (unsigned long long)numFrms;
 
     if (numBytesTotal > 0) {
-        instanceCounter = instanceCounter + 1;
-        qDebug() << QString("LAUMemoryObjectData::allocateBuffer() %1").arg(instanceCounter) << numRows << numCols << numChns << numByts << numFrms << numBytesTotal;
+        qDebug() << QString("LAUMemoryObjectData::allocateBuffer() %1").arg(instanceCounter + 1) << numRows << numCols << numChns << numByts << numFrms << numBytesTotal;
 
         stepBytes  = numCols * numChns * numByts;
         frameBytes = numCols * numChns * numByts * numRows;
-        buffer     = _mm_malloc(numBytesTotal + 128, 16);
+        pixels     = new LAUMemoryObjectBuffer(numBytesTotal);
+        buffer     = pixels->buffer;
         if (buffer == nullptr) {
             qDebug() << QString("LAUVideoBufferData::allocateBuffer() MAJOR ERROR DID NOT ALLOCATE SPACE!!!");
             qDebug() << QString("LAUVideoBufferData::allocateBuffer() MAJOR ERROR DID NOT ALLOCATE SPACE!!!");
             qDebug() << QString("LAUVideoBufferData::allocateBuffer() MAJOR ERROR DID NOT ALLOCATE SPACE!!!");
+            pixels.reset();
         } else {
             xmlByteArray = new QByteArray();
             rfidString = new QString();
@@ -306,6 +328,43 @@ void LAUMemoryObjectData::allocateBuffer()
     return;
 }
 
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObjectBuffer::LAUMemoryObjectBuffer(unsigned long long bytes) : numBytesTotal(bytes)
+{
+    buffer = _mm_malloc(numBytesTotal + 128, 16);
+    if (buffer) {
+        LAUMemoryObjectData::instanceCounter = LAUMemoryObjectData::instanceCounter + 1;
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObjectBuffer::LAUMemoryObjectBuffer(const LAUMemoryObjectBuffer &other) : QSharedData(), numBytesTotal(other.numBytesTotal)
+{
+    qDebug() << QString("LAUMemoryObjectBuffer::LAUMemoryObjectBuffer() %1").arg(LAUMemoryObjectData::instanceCounter + 1) << numBytesTotal;
+
+    buffer = _mm_malloc(numBytesTotal + 128, 16);
+    if (buffer) {
+        LAUMemoryObjectData::instanceCounter = LAUMemoryObjectData::instanceCounter + 1;
+        memcpy(buffer, other.buffer, numBytesTotal);
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObjectBuffer::~LAUMemoryObjectBuffer()
+{
+    if (buffer != NULL) {
+        LAUMemoryObjectData::instanceCounter = LAUMemoryObjectData::instanceCounter - 1;
+        qDebug() << QString("LAUMemoryObjectBuffer::~LAUMemoryObjectBuffer() %1").arg(LAUMemoryObjectData::instanceCounter) << numBytesTotal;
+        _mm_free(buffer);
+    }
+}
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -378,7 +437,7 @@ LAUMemoryObject::LAUMemoryObject(QImage image) : data(new LAUMemoryObjectData())
             data->allocateBuffer();
 
             for (unsigned int row = 0; row < height(); row++) {
-                memcpy(constScanLine(row), image.constScanLine(row), step());
+                memcpy(scanLine(row), image.constScanLine(row), step());
             }
 #if QT_VERSION >= 0x060000
         } else if (image.format() == QImage::Format_Grayscale16) {
@@ -390,7 +449,7 @@ LAUMemoryObject::LAUMemoryObject(QImage image) : data(new LAUMemoryObjectData())
             data->allocateBuffer();
 
             for (unsigned int row = 0; row < height(); row++) {
-                memcpy(constScanLine(row), image.constScanLine(row), step());
+                memcpy(scanLine(row), image.constScanLine(row), step());
             }
 #endif
         }
@@ -467,10 +526,10 @@ bool LAUMemoryObject::save(QString filename, QString *savedFilePath) const
         LAUMemoryObject object(width(), height(), colors(), depth(), 1);
         for (unsigned int n = 0; n < frames(); n++) {
             // COPY THE CURRENT FRAME INTO THE TEMPORARY FRAME BUFFER OBJECT
-            memcpy(object.constPointer(), constFrame(n), block());
+            memcpy(object.pointer(), constFrame(n), block());
 
             // SAVE THE CURRENT FRAME INTO ITS OWN DIRECTORY INSIDE THE NEW TIFF FILE
-            if (object.save(outputTiff, n) == false) {
+            if (object.save(outputTiff) == false) {
                 flag = false;
                 break;
             }
@@ -482,7 +541,7 @@ bool LAUMemoryObject::save(QString filename, QString *savedFilePath) const
         memcpy(object.constPointer(), constPointer(), length());
 
         // SAVE THE CURRENT FRAME INTO ITS OWN DIRECTORY INSIDE THE NEW TIFF FILE
-        if (object.save(outputTiff, 0) == false) {
+        if (object.save(outputTiff) == false) {
             flag = false;
         }
 #endif
@@ -540,7 +599,7 @@ bool LAUMemoryObject::saveObjectsToDisk(QList<LAUMemoryObject> objects, QString
     }
 
     for (int n = 0; n < objects.count(); n++){
-        if (objects.at(n).save(outputTiff, n) == false){
+        if (objects.at(n).save(outputTiff) == false){
             TIFFClose(outputTiff);
             return(false);
         }
@@ -554,8 +613,172 @@ bool LAUMemoryObject::saveObjectsToDisk(QList<LAUMemoryObject> objects, QString
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-bool LAUMemoryObject::save(TIFF *otTiff, int index) const
+// IN-MEMORY FILE STREAM HANDED TO TIFFCLIENTOPEN SO THAT STRIPS CAN BE
+// ENCODED BY LIBTIFF ON WORKER THREADS WITHOUT TOUCHING THE OUTPUT FILE
+typedef struct {
+    QByteArray buffer;
+    qint64 position;
+} LAUMemoryTiffStream;
+
+static tmsize_t memoryTiffRead(thandle_t handle, void *data, tmsize_t size)
+{
+    LAUMemoryTiffStream *stream = (LAUMemoryTiffStream *)handle;
+    tmsize_t length = (tmsize_t)qBound((qint64)0, (qint64)stream->buffer.size() - stream->position, (qint64)size);
+    memcpy(data, stream->buffer.constData() + stream->position, length);
+    stream->position += length;
+    return (length);
+}
+
+static tmsize_t memoryTiffWrite(thandle_t handle, void *data, tmsize_t size)
+{
+    LAUMemoryTiffStream *stream = (LAUMemoryTiffStream *)handle;
+    if (stream->position + size > stream->buffer.size()) {
+        stream->buffer.resize((int)(stream->position + size));
+    }
+    memcpy(stream->buffer.data() + stream->position, data, size);
+    stream->position += size;
+    return (size);
+}
+
+static toff_t memoryTiffSeek(thandle_t handle, toff_t offset, int whence)
+{
+    LAUMemoryTiffStream *stream = (LAUMemoryTiffStream *)handle;
+    if (whence == SEEK_CUR) {
+        stream->position += (qint64)offset;
+    } else if (whence == SEEK_END) {
+        stream->position = stream->buffer.size() + (qint64)offset;
+    } else {
+        stream->position = (qint64)offset;
+    }
+    return ((toff_t)stream->position);
+}
+
+static int memoryTiffClose(thandle_t handle)
+{
+    Q_UNUSED(handle);
+    return (0);
+}
+
+static toff_t memoryTiffSize(thandle_t handle)
+{
+    return ((toff_t)((LAUMemoryTiffStream *)handle)->buffer.size());
+}
+
+static int memoryTiffMap(thandle_t handle, void **base, toff_t *size)
+{
+    Q_UNUSED(handle);
+    Q_UNUSED(base);
+    Q_UNUSED(size);
+    return (0);
+}
+
+static void memoryTiffUnmap(thandle_t handle, void *base, toff_t size)
+{
+    Q_UNUSED(handle);
+    Q_UNUSED(base);
+    Q_UNUSED(size);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUMemoryObject::compressStrips(const unsigned char *pixels, int rowsPerStrip, int threads, LAUMemoryObjectCodec codec, QVector<QByteArray> &strips) const
+{
+    // SPLIT THE STRIPS INTO ONE CONTIGUOUS BLOCK PER THREAD
+    int numRows = (int)(height() * frames());
+    int numStrips = (numRows + rowsPerStrip - 1) / rowsPerStrip;
+    int stripsPerBlock = (numStrips + threads - 1) / threads;
+
+    QList<int> blocks;
+    for (int strip = 0; strip < numStrips; strip += stripsPerBlock) {
+        blocks << strip;
+    }
+
+    strips.resize(numStrips);
+    QAtomicInt failures(0);
+    QtConcurrent::blockingMap(blocks, [&](const int &firstStrip) {
+        int lastStrip = qMin(firstStrip + stripsPerBlock, numStrips);
+        int firstRow = firstStrip * rowsPerStrip;
+        int blockRows = qMin(lastStrip * rowsPerStrip, numRows) - firstRow;
+
+        // ENCODE THIS BLOCK AS ITS OWN SMALL TIFF WITH THE SAME CODEC SETTINGS AS THE OUTPUT FILE
+        LAUMemoryTiffStream stream;
+        stream.position = 0;
+        TIFF *tiff = TIFFClientOpen("memory", "w", (thandle_t)&stream, memoryTiffRead, memoryTiffWrite, memoryTiffSeek, memoryTiffClose, memoryTiffSize, memoryTiffMap, memoryTiffUnmap);
+        if (tiff == nullptr) {
+            failures.ref();
+            return;
+        }
+        TIFFSetField(tiff, TIFFTAG_IMAGEWIDTH, (unsigned int)width());
+        TIFFSetField(tiff, TIFFTAG_IMAGELENGTH, (unsigned int)blockRows);
+        TIFFSetField(tiff, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+        TIFFSetField(tiff, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_MINISBLACK);
+        TIFFSetField(tiff, TIFFTAG_SAMPLESPERPIXEL, (unsigned short)colors());
+        TIFFSetField(tiff, TIFFTAG_BITSPERSAMPLE, (unsigned short)(8 * depth()));
+        if (depth() == sizeof(float) || depth() == sizeof(double)) {
+            TIFFSetField(tiff, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_IEEEFP);
+        }
+        codec.apply(tiff);
+        TIFFSetField(tiff, TIFFTAG_ROWSPERSTRIP, (unsigned int)rowsPerStrip);
+
+        // ENCODE EACH STRIP STRAIGHT FROM OUR BUFFER SINCE LIBTIFF APPLIES THE PREDICTOR TO ITS OWN COPY
+        for (int strip = firstStrip; strip < lastStrip; strip++) {
+            int row = strip * rowsPerStrip;
+            int rows = qMin(rowsPerStrip, numRows - row);
+            if (TIFFWriteEncodedStrip(tiff, strip - firstStrip, (void *)(pixels + (qint64)row * step()), (tmsize_t)rows * step()) < 0) {
+                failures.ref();
+            }
+        }
+
+        // PULL THE COMPRESSED BYTES OF EACH STRIP BACK OUT OF THE MEMORY STREAM
+        uint64_t *offsets = nullptr;
+        uint64_t *counts = nullptr;
+        if (TIFFGetField(tiff, TIFFTAG_STRIPOFFSETS, &offsets) && TIFFGetField(tiff, TIFFTAG_STRIPBYTECOUNTS, &counts)) {
+            for (int strip = firstStrip; strip < lastStrip; strip++) {
+                strips[strip] = stream.buffer.mid((int)offsets[strip - firstStrip], (int)counts[strip - firstStrip]);
+            }
+        } else {
+            failures.ref();
+        }
+        TIFFClose(tiff);
+    });
+
+    return (failures.loadRelaxed() == 0);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// WRITES THE EXIF DIRECTORY HOLDING THE ELAPSED TIME STAMP AHEAD OF THE IMAGE
+// DIRECTORY THAT WILL POINT TO IT AND THEN STARTS A FRESH IMAGE DIRECTORY. THIS
+// WAY EACH IMAGE DIRECTORY IS WRITTEN EXACTLY ONCE, AFTER ITS STRIPS AND EXIF
+// DATA ARE ALREADY ON DISK, SO A RECORDING THAT IS CUT OFF BY A CRASH STILL HAS
+// AN INTACT DIRECTORY CHAIN UP TO ITS LAST COMPLETE FRAME. THE OLD APPROACH OF
+// UNLINKING AND REWRITING THE IMAGE DIRECTORY WITH TIFFREWRITEDIRECTORY ALSO
+// WALKED THE WHOLE CHAIN ON EVERY FRAME AND LEFT A DEAD COPY OF EACH DIRECTORY
+static uint64_t writeSubSecTimeDirectory(TIFF *otTiff, const QByteArray &subSecTime)
+{
+    uint64_t directoryOffset = 0;
+    TIFFCreateEXIFDirectory(otTiff);
+    TIFFSetField(otTiff, EXIFTAG_SUBSECTIME, subSecTime.constData());
+    if (TIFFWriteCustomDirectory(otTiff, &directoryOffset) == 0) {
+        directoryOffset = 0;
+    }
+    TIFFCreateDirectory(otTiff);
+    return (directoryOffset);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUMemoryObject::save(TIFF *otTiff, int rowsPerStrip, int threads, LAUMemoryObjectCodec codec) const
 {
+    // WRITE THE ELAPSED TIME STAMP FIRST SO THE IMAGE DIRECTORY CAN POINT TO IT
+    uint64_t exifOffset = 0;
+    if (elapsed() != 0) {
+        exifOffset = writeSubSecTimeDirectory(otTiff, QString("%1").arg(elapsed()).toLatin1());
+    }
+
     TIFFSetField(otTiff, TIFFTAG_SUBFILETYPE, FILETYPE_PAGE);
     TIFFSetField(otTiff, TIFFTAG_DATETIME, QDateTime::currentDateTime().toString("yyyy:MM:dd hh:mm:ss").toLatin1().data());
     TIFFSetField(otTiff, TIFFTAG_IMAGEWIDTH, (unsigned long)width());
@@ -582,11 +805,15 @@ bool LAUMemoryObject::save(TIFF *otTiff, int index) const
         TIFFSetField(otTiff, TIFFTAG_EXTRASAMPLES, colors() - 1, smples);
         delete [] smples;
     }
-    TIFFSetField(otTiff, TIFFTAG_COMPRESSION, COMPRESSION_LZW);
     TIFFSetField(otTiff, TIFFTAG_XPOSITION, qMax(0.0f, (float)anchor().x()));
     TIFFSetField(otTiff, TIFFTAG_YPOSITION, qMax(0.0f, (float)anchor().y()));
-    TIFFSetField(otTiff, TIFFTAG_PREDICTOR, PREDICTOR_HORIZONTAL);
-    TIFFSetField(otTiff, TIFFTAG_ROWSPERSTRIP, 1);
+    codec.apply(otTiff);
+
+    // GROUP ROWS INTO STRIPS SO EACH COMPRESSED STREAM HAS ENOUGH DATA TO COMPRESS WELL AND
+    // THE STRIPOFFSETS AND STRIPBYTECOUNTS ARRAYS STAY SHORT; READERS THAT USE
+    // TIFFREADSCANLINE HANDLE ANY STRIP HEIGHT, INCLUDING THE OLD ONE-ROW LAYOUT
+    rowsPerStrip = qBound(1, rowsPerStrip, (int)(height() * frames()));
+    TIFFSetField(otTiff, TIFFTAG_ROWSPERSTRIP, (unsigned int)rowsPerStrip);
 
     // LET'S SEE IF THERE ARE ANY VALID ENTRIES IN THE JETR VECTOR
     QVector<double> jetrVector = this->jetr();
@@ -605,28 +832,7 @@ bool LAUMemoryObject::save(TIFF *otTiff, int index) const
             }
             hashTable["jetrVector"] = jetrString;
 
-            // CREATE THE XML DATA PACKET USING QT'S XML STREAM OBJECTS
-            QByteArray xmlByteArray;
-            QBuffer buffer(&xmlByteArray);
-            buffer.open(QIODevice::WriteOnly);
-
-            QXmlStreamWriter writer(&buffer);
-            writer.setAutoFormatting(true);
-            writer.writeStartDocument();
-            writer.writeStartElement("scan");
-
-            QHashIterator<QString, QString> i(hashTable);
-            while (i.hasNext()) {
-                i.next();
-                writer.writeTextElement(i.key(), i.value());
-            }
-
-            // CLOSE OUT THE XML BUFFER
-            writer.writeEndElement();
-            writer.writeEndDocument();
-            buffer.close();
-
-            setConstXML(xmlByteArray);
+            setConstXML(hashToXml(hashTable));
 
             break;
         }
@@ -651,35 +857,344 @@ bool LAUMemoryObject::save(TIFF *otTiff, int index) const
         TIFFSetField(otTiff, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_IEEEFP);
     }
 
-    // MAKE TEMPORARY BUFFER TO HOLD CURRENT ROW BECAUSE COMPRESSION DESTROYS
-    // WHATS EVER INSIDE THE BUFFER
-    unsigned int cnt = 0;
-    unsigned char *tempBuffer = (unsigned char *)malloc(step());
-    for (unsigned int frm = 0; frm < frames(); frm++) {
-        for (unsigned int row = 0; row < height(); row++) {
-            memcpy(tempBuffer, constScanLine(row, frm), step());
-            TIFFWriteScanline(otTiff, tempBuffer, cnt++, 0);
+    // DROP THE LOW ORDER BITS THAT ARE ZERO IN EVERY SAMPLE IF THE CODEC ASKS FOR PACKING
+    // AND TAG THE DIRECTORY WITH THE SHIFT SO THAT LOAD() CAN PUT THEM BACK
+    const unsigned char *pixels = constPointer();
+    unsigned char *packedPixels = nullptr;
+    int bitShift = codec.pack() ? trailingZeroBits() : 0;
+    if (bitShift > 0) {
+        packedPixels = (unsigned char *)_mm_malloc(length() + 16, 16);
+        __m128i count = _mm_cvtsi32_si128(bitShift);
+        for (unsigned long long n = 0; n < length(); n += 16) {
+            _mm_store_si128((__m128i *)(packedPixels + n), _mm_srl_epi16(_mm_load_si128((const __m128i *)(pixels + n)), count));
+        }
+        pixels = packedPixels;
+        TIFFSetField(otTiff, LAUMEMORYOBJECTTIFFTAG_BITSHIFT, (unsigned short)bitShift);
+    }
+
+    // SEE IF WE SHOULD COMPRESS THE STRIPS ON SEVERAL THREADS AND WRITE THEM PRE-COMPRESSED
+    QVector<QByteArray> strips;
+    int numStrips = (int)((height() * frames() + rowsPerStrip - 1) / rowsPerStrip);
+    if (threads > 1 && numStrips > 1 && compressStrips(pixels, rowsPerStrip, qMin(threads, numStrips), codec, strips)) {
+        for (int strip = 0; strip < strips.count(); strip++) {
+            TIFFWriteRawStrip(otTiff, (unsigned int)strip, strips[strip].data(), strips.at(strip).size());
         }
+    } else {
+        // HAND EACH STRIP TO LIBTIFF STRAIGHT FROM OUR BUFFER; UNLIKE TIFFWRITESCANLINE,
+        // TIFFWRITEENCODEDSTRIP RUNS THE PREDICTOR ON ITS OWN WORKING COPY SO THE OBJECT IS
+        // NEVER MODIFIED, AND THE FRAMES ARE CONTIGUOUS SO A STRIP CAN SPAN TWO OF THEM
+        unsigned int numRows = height() * frames();
+        for (unsigned int row = 0; row < numRows; row += (unsigned int)rowsPerStrip) {
+            unsigned int rows = qMin((unsigned int)rowsPerStrip, numRows - row);
+            TIFFWriteEncodedStrip(otTiff, row / (unsigned int)rowsPerStrip, (void *)(pixels + (qint64)row * step()), (tmsize_t)rows * step());
+        }
+    }
+
+    if (packedPixels) {
+        _mm_free(packedPixels);
+    }
+
+    // POINT THE IMAGE DIRECTORY AT ITS EXIF DIRECTORY
+    if (exifOffset != 0) {
+        TIFFSetField(otTiff, TIFFTAG_EXIFIFD, exifOffset);
     }
-    free(tempBuffer);
 
     // WRITE THE CURRENT DIRECTORY AND PREPARE FOR THE NEW ONE
-    TIFFWriteDirectory(otTiff);
+    return (TIFFWriteDirectory(otTiff) != 0);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObjectCodec LAUMemoryObjectCodec::fromString(QString string)
+{
+    // PULL OFF THE OPTIONAL BIT PACKING SUFFIX
+    QString lowerString = string.trimmed().toLower();
+    bool pack = lowerString.endsWith(QString("+pack"));
+    if (pack) {
+        lowerString.chop(5);
+    }
+
+    // SPLIT THE STRING INTO ITS CODEC NAME AND OPTIONAL COMPRESSION LEVEL
+    QStringList fields = lowerString.split(":");
+    QString name = fields.first();
+
+    int level = -1;
+    if (fields.count() > 1) {
+        bool okay = false;
+        level = fields.at(1).toInt(&okay);
+        if (okay == false) {
+            level = -1;
+        }
+    }
+
+    LAUMemoryObjectCodec codec;
+    if (name == QString("none")) {
+        codec = LAUMemoryObjectCodec(SchemeNone, -1, pack);
+    } else if (name == QString("lzw") || name.isEmpty()) {
+        codec = LAUMemoryObjectCodec(SchemeLZW, -1, pack);
+    } else if (name == QString("deflate") || name == QString("zip")) {
+        codec = LAUMemoryObjectCodec(SchemeDeflate, level, pack);
+    } else if (name == QString("zstd")) {
+        codec = LAUMemoryObjectCodec(SchemeZSTD, level, pack);
+    } else {
+        qDebug() << "LAUMemoryObjectCodec::fromString() unknown codec" << string << "using lzw";
+    }
+
+    if (codec.isSupported() == false) {
+        qDebug() << "LAUMemoryObjectCodec::fromString() libtiff cannot encode" << string << "using lzw";
+        codec = LAUMemoryObjectCodec(SchemeLZW, -1, pack);
+    }
+    return (codec);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+QString LAUMemoryObjectCodec::toString() const
+{
+    QString string;
+    if (codecScheme == SchemeNone) {
+        string = QString("none");
+    } else if (codecScheme == SchemeDeflate) {
+        string = QString("deflate");
+    } else if (codecScheme == SchemeZSTD) {
+        string = QString("zstd");
+    } else {
+        string = QString("lzw");
+    }
+
+    if ((codecScheme == SchemeDeflate || codecScheme == SchemeZSTD) && codecLevel > 0) {
+        string.append(QString(":%1").arg(codecLevel));
+    }
+    if (packFlag) {
+        string.append(QString("+pack"));
+    }
+    return (string);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+unsigned short LAUMemoryObjectCodec::compression() const
+{
+    switch (codecScheme) {
+        case SchemeNone:
+            return (COMPRESSION_NONE);
+        case SchemeDeflate:
+            return (COMPRESSION_ADOBE_DEFLATE);
+#ifdef COMPRESSION_ZSTD
+        case SchemeZSTD:
+            return (COMPRESSION_ZSTD);
+#endif
+        default:
+            return (COMPRESSION_LZW);
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUMemoryObjectCodec::isSupported() const
+{
+#ifndef COMPRESSION_ZSTD
+    // OLDER LIBTIFF HEADERS DO NOT EVEN KNOW ABOUT ZSTANDARD
+    if (codecScheme == SchemeZSTD) {
+        return (false);
+    }
+#endif
+    return (TIFFIsCODECConfigured(compression()) != 0);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+QList<LAUMemoryObjectCodec> LAUMemoryObjectCodec::availableCodecs()
+{
+    // LIST THE CODECS WORTH COMPARING THAT THE LINKED LIBTIFF CAN ACTUALLY ENCODE
+    QList<LAUMemoryObjectCodec> candidates;
+    candidates << LAUMemoryObjectCodec(SchemeNone);
+    candidates << LAUMemoryObjectCodec(SchemeLZW);
+    candidates << LAUMemoryObjectCodec(SchemeDeflate, 1);
+    candidates << LAUMemoryObjectCodec(SchemeDeflate, 6);
+    candidates << LAUMemoryObjectCodec(SchemeDeflate, 9);
+    candidates << LAUMemoryObjectCodec(SchemeZSTD, 1);
+    candidates << LAUMemoryObjectCodec(SchemeZSTD, 3);
+    candidates << LAUMemoryObjectCodec(SchemeZSTD, 9);
+    candidates << LAUMemoryObjectCodec(SchemeLZW, -1, true);
+    candidates << LAUMemoryObjectCodec(SchemeDeflate, 6, true);
+    candidates << LAUMemoryObjectCodec(SchemeZSTD, 3, true);
+
+    QList<LAUMemoryObjectCodec> codecs;
+    for (int n = 0; n < candidates.count(); n++) {
+        if (candidates.at(n).isSupported()) {
+            codecs << candidates.at(n);
+        }
+    }
+    return (codecs);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectCodec::apply(TIFF *tiff) const
+{
+    // QUIETLY FALL BACK TO LZW SINCE FROMSTRING() HAS ALREADY WARNED THE USER
+    if (isSupported() == false) {
+        LAUMemoryObjectCodec(SchemeLZW, -1, packFlag).apply(tiff);
+        return;
+    }
+
+    // THE PREDICTOR AND LEVEL TAGS ONLY EXIST ONCE THE COMPRESSION TAG HAS BEEN SET
+    TIFFSetField(tiff, TIFFTAG_COMPRESSION, compression());
+    if (codecScheme != SchemeNone) {
+        TIFFSetField(tiff, TIFFTAG_PREDICTOR, PREDICTOR_HORIZONTAL);
+    }
+    if (codecScheme == SchemeDeflate && codecLevel > 0) {
+        TIFFSetField(tiff, TIFFTAG_ZIPQUALITY, qBound(1, codecLevel, 9));
+    }
+#ifdef COMPRESSION_ZSTD
+    if (codecScheme == SchemeZSTD && codecLevel > 0) {
+        TIFFSetField(tiff, TIFFTAG_ZSTD_LEVEL, qBound(1, codecLevel, 22));
+    }
+#endif
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObjectSimd::Level LAUMemoryObjectSimd::supportedLevel()
+{
+#ifdef LAUMEMORYOBJECTAVXDISPATCH
+#if defined(_MSC_VER)
+    // ASK THE CPU FOR ITS FEATURE FLAGS AND MAKE SURE THE OPERATING SYSTEM
+    // SAVES THE WIDE REGISTERS (XCR0) BEFORE TRUSTING THE AVX FLAGS
+    int info[4];
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) {
+        return (LevelSSE);
+    }
+    unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    bool avx2Flag = (info[1] & (1 << 5)) && (xcr0 & 0x06) == 0x06;
+    if (avx2Flag && (info[1] & (1 << 16)) && (info[1] & (1 << 30)) && (xcr0 & 0xE6) == 0xE6) {
+        return (LevelAVX512);
+    }
+    if (avx2Flag) {
+        return (LevelAVX2);
+    }
+#else
+    // THE COMPILER'S CPU CHECKS ALREADY TAKE OPERATING SYSTEM SUPPORT INTO ACCOUNT
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return (LevelAVX512);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return (LevelAVX2);
+    }
+#endif
+#endif
+    return (LevelSSE);
+}
 
-    // WRITE THE ELAPSED TIME STAMP TO AN EXIF TAG
-    if (elapsed() != 0){
-        uint64_t dir_offset;
-        TIFFCreateEXIFDirectory(otTiff);
-        TIFFSetField(otTiff, EXIFTAG_SUBSECTIME, QString("%1").arg(elapsed()).toLatin1().data());
-        TIFFWriteCustomDirectory(otTiff, &dir_offset);
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObjectSimd::Level LAUMemoryObjectSimd::level()
+{
+    // PICK THE WIDEST SUPPORTED LEVEL THE FIRST TIME WE ARE ASKED
+    int lvl = lauSimdLevel.loadAcquire();
+    if (lvl < 0) {
+        lauSimdLevel.testAndSetOrdered(-1, (int)supportedLevel());
+        lvl = lauSimdLevel.loadAcquire();
+    }
+    return ((Level)lvl);
+}
 
-        TIFFSetDirectory(otTiff, index);
-        TIFFSetField(otTiff, TIFFTAG_EXIFIFD, dir_offset);
-        TIFFRewriteDirectory(otTiff);
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUMemoryObjectSimd::setLevel(Level lvl)
+{
+    // REFUSE TO SELECT INSTRUCTIONS THAT THIS CPU CANNOT EXECUTE
+    if (lvl < LevelSSE || lvl > supportedLevel()) {
+        return (false);
     }
+    lauSimdLevel.storeRelease((int)lvl);
     return (true);
 }
 
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+QString LAUMemoryObjectSimd::toString(Level lvl)
+{
+    if (lvl == LevelAVX512) {
+        return (QString("avx512"));
+    } else if (lvl == LevelAVX2) {
+        return (QString("avx2"));
+    }
+    return (QString("sse"));
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+int LAUMemoryObject::trailingZeroBits() const
+{
+    if (isNull() || depth() != sizeof(unsigned short)) {
+        return (0);
+    }
+
+    // OR EVERY 16-BIT SAMPLE TOGETHER SO THE LOWEST SET BIT TELLS US HOW FAR WE CAN SHIFT
+    unsigned long long numBytes = length() - length() % 16;
+    __m128i bits = _mm_setzero_si128();
+    for (unsigned long long n = 0; n < numBytes; n += 16) {
+        bits = _mm_or_si128(bits, _mm_load_si128((const __m128i *)(constPointer() + n)));
+    }
+
+    unsigned short samples[8];
+    _mm_storeu_si128((__m128i *)samples, bits);
+    unsigned short value = 0;
+    for (int n = 0; n < 8; n++) {
+        value |= samples[n];
+    }
+    for (unsigned long long n = numBytes / 2; n < length() / 2; n++) {
+        value |= ((const unsigned short *)constPointer())[n];
+    }
+
+    // AN ALL ZERO FRAME HAS NOTHING TO GAIN FROM PACKING
+    int shift = 0;
+    if (value != 0) {
+        while ((value & 0x0001) == 0) {
+            value = value >> 1;
+            shift++;
+        }
+    }
+    return (shift);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObject::restoreBitShift(TIFF *inTiff)
+{
+    // PUT BACK THE LOW ORDER BITS DROPPED BY SAVE() WHEN WRITING WITH A "+PACK" CODEC
+    unsigned short bitShift = 0;
+    if (data->buffer == nullptr || depth() != sizeof(unsigned short)) {
+        return;
+    }
+    if (TIFFGetField(inTiff, LAUMEMORYOBJECTTIFFTAG_BITSHIFT, &bitShift) == 0 || bitShift == 0 || bitShift > 15) {
+        return;
+    }
+
+    __m128i count = _mm_cvtsi32_si128(bitShift);
+    unsigned char *buffer = pointer();
+    for (unsigned long long n = 0; n < length(); n += 16) {
+        _mm_store_si128((__m128i *)(buffer + n), _mm_sll_epi16(_mm_load_si128((const __m128i *)(buffer + n)), count));
+    }
+}
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -743,6 +1258,7 @@ bool LAUMemoryObject::load(TIFF *inTiff, int index)
                 TIFFReadScanline(inTiff, (unsigned char *)scanLine(row), static_cast<unsigned int>(row));
             }
         }
+        restoreBitShift(inTiff);
     }
 
     // LOAD THE XML FIELD OF THE TIFF FILE, IF PROVIDED
@@ -882,6 +1398,7 @@ bool LAUMemoryObject::loadInto(TIFF *inTiff, int index)
                 TIFFReadScanline(inTiff, (unsigned char *)scanLine(row), static_cast<unsigned int>(row));
             }
         }
+        restoreBitShift(inTiff);
     }
 
     // LOAD THE XML FIELD OF THE TIFF FILE, IF PROVIDED
@@ -936,16 +1453,131 @@ bool LAUMemoryObject::loadInto(TIFF *inTiff, int index)
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-LAUMemoryObject LAUMemoryObject::peakEnvelope(float dx, float dy, float radius) const
+static void peakEnvelopeScan(unsigned short *samples, int count, int stride, float dx, float dy, float radius, int pixelRadius, int lastOffset, float *scratch)
 {
-    // GET THE RADIUS IN TERMS OF PIXELS
-    int pixelRadius = (int)qFloor(radius / dx);
-
-    // CREATE A NEW COPY OF THIS MEMORY OBJECT
-    LAUMemoryObject object = *this;
-    object.triggerDeepCopy();
+    // EVERY CIRCLE TOUCHES THE COLUMNS AT OFFSETS -PIXELRADIUS THROUGH LASTOFFSET FROM ITS OWN COLUMN,
+    // SO WE TABULATE THE HEIGHT OF THE CIRCLE AT EACH OFFSET ONCE AND PAD BOTH ENDS OF THE SCAN WITH
+    // PIXELRADIUS EMPTY SAMPLES SO THAT FOUR NEIGHBORING OUTPUT COLUMNS CAN BE UPDATED TOGETHER
+    int span = pixelRadius + lastOffset + 1;
+    int padded = count + 2 * pixelRadius;
+    float *heights = scratch;
+    float *scan = heights + qMax(span, 0);
+    float *centers = scan + padded;
+    float *yVector = centers + padded;
+    float *xVector = yVector + count;
+
+    for (int deltaP = -pixelRadius; deltaP <= lastOffset; deltaP++) {
+        float deltaX = (float)deltaP * dx;
+        heights[deltaP + pixelRadius] = qSqrt((radius * radius) - (deltaX * deltaX));
+    }
+
+    // COPY THE SCAN INTO THE PADDED BUFFER WITH INVALID PIXELS AT MINUS INFINITY SO THEY NEVER WIN
+    for (int ind = 0; ind < padded; ind++) {
+        scan[ind] = -INFINITY;
+    }
+    for (int ind = 0; ind < count; ind++) {
+        unsigned short pixel = samples[ind * stride];
+        if (pixel != 0 && pixel != 65535) {
+            scan[ind + pixelRadius] = (float)pixel * dy;
+        }
+    }
 
-    // COPY METADATA
+    // FIND THE HIGHEST CIRCLE CENTER OVER EACH COLUMN, VISITING THE CIRCLES FROM LEFT TO RIGHT
+    // JUST LIKE THE SCALAR LOOP SO THAT NANS FROM THE SQUARE ROOT ARE TREATED THE SAME WAY
+    int ind = 0;
+    for (; ind + 4 <= count; ind += 4) {
+        __m128 vecY = _mm_set1_ps(-1e6f);
+        for (int deltaP = lastOffset; deltaP >= -pixelRadius; deltaP--) {
+            __m128 vecC = _mm_add_ps(_mm_loadu_ps(scan + ind - deltaP + pixelRadius), _mm_set1_ps(heights[deltaP + pixelRadius]));
+            vecY = _mm_max_ps(vecC, vecY);
+        }
+        _mm_storeu_ps(yVector + ind, vecY);
+    }
+    for (; ind < count; ind++) {
+        yVector[ind] = -1e6f;
+        for (int deltaP = lastOffset; deltaP >= -pixelRadius; deltaP--) {
+            float yCoord = scan[ind - deltaP + pixelRadius] + heights[deltaP + pixelRadius];
+            if (!qIsNaN(yCoord)) {
+                yVector[ind] = qMax(yVector[ind], yCoord);
+            }
+        }
+    }
+
+    // COPY THE CIRCLE CENTERS INTO THE SECOND PADDED BUFFER WITH EMPTY COLUMNS AT PLUS INFINITY
+    for (ind = 0; ind < padded; ind++) {
+        centers[ind] = INFINITY;
+    }
+    for (ind = 0; ind < count; ind++) {
+        if (yVector[ind] > -1e5) {
+            centers[ind + pixelRadius] = yVector[ind];
+        }
+    }
+
+    // PROJECT THE CIRCLES BACK ONTO THE LINE KEEPING THE LOWEST ONE OVER EACH COLUMN
+    __m128 vecInf = _mm_set1_ps(INFINITY);
+    for (ind = 0; ind + 4 <= count; ind += 4) {
+        __m128 vecX = _mm_set1_ps(+1e6f);
+        for (int deltaP = lastOffset; deltaP >= -pixelRadius; deltaP--) {
+            __m128 vecC = _mm_loadu_ps(centers + ind - deltaP + pixelRadius);
+            __m128 vecM = _mm_min_ps(vecX, _mm_sub_ps(vecC, _mm_set1_ps(heights[deltaP + pixelRadius])));
+            vecX = _mm_blendv_ps(vecX, vecM, _mm_cmpneq_ps(vecC, vecInf));
+        }
+        _mm_storeu_ps(xVector + ind, vecX);
+    }
+    for (; ind < count; ind++) {
+        xVector[ind] = +1e6f;
+        for (int deltaP = lastOffset; deltaP >= -pixelRadius; deltaP--) {
+            float center = centers[ind - deltaP + pixelRadius];
+            if (center != INFINITY) {
+                xVector[ind] = qMin(xVector[ind], center - heights[deltaP + pixelRadius]);
+            }
+        }
+    }
+
+    // CONVERT THE SCAN COORDINATE BACK TO A PIXEL VALUE
+    for (ind = 0; ind < count; ind++) {
+        unsigned short pixel = samples[ind * stride];
+        if (pixel != 0 && pixel != 65535) {
+            samples[ind * stride] = (unsigned short)qMax(0.0f, qMin(65535.0f, xVector[ind] / dy));
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static void peakEnvelopeLines(unsigned short *buffer, int lines, int lineStride, int count, int stride, float dx, float dy, float radius, int pixelRadius, int lastOffset)
+{
+    // SPLIT THE LINES INTO ONE CONTIGUOUS BLOCK PER THREAD
+    int threads = qMax(1, QThread::idealThreadCount());
+    int linesPerBlock = (lines + threads - 1) / threads;
+
+    QList<int> blocks;
+    for (int line = 0; line < lines; line += linesPerBlock) {
+        blocks << line;
+    }
+
+    QtConcurrent::blockingMap(blocks, [&](const int &firstLine) {
+        QVector<float> scratch(qMax(pixelRadius + lastOffset + 1, 0) + 2 * (count + 2 * pixelRadius) + 2 * count);
+        for (int line = firstLine; line < qMin(firstLine + linesPerBlock, lines); line++) {
+            peakEnvelopeScan(buffer + (qint64)line * lineStride, count, stride, dx, dy, radius, pixelRadius, lastOffset, scratch.data());
+        }
+    });
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObject LAUMemoryObject::peakEnvelope(float dx, float dy, float radius) const
+{
+    // GET THE RADIUS IN TERMS OF PIXELS
+    int pixelRadius = qMax(0, (int)qFloor(radius / dx));
+
+    // CREATE A NEW COPY OF THIS MEMORY OBJECT
+    LAUMemoryObject object = *this;
+    object.triggerDeepCopy();
+
+    // COPY METADATA
     object.setXML(xml());
     object.setRFID(rfid());
     object.setTransform(transform());
@@ -964,83 +1596,10 @@ LAUMemoryObject LAUMemoryObject::peakEnvelope(float dx, float dy, float radius)
                 // PROJECT EACH RADIUS ONTO THE VERTICAL AXIS AND SORT AS YOU
                 // GO ALONG. TAKE THE FIRST RADIUS FROM THE BOTTOM.
 
-                // ITERATURE THROUGH EACH ROW OF THE CURRENT VIDEO FRAME
-                for (unsigned int row = 0; row < height(); row++){
-                    // GRAB THE POINTER TO THE SCAN BUFFER THAT WE INTEND TO READ FROM
-                    unsigned short *fmBuffer = (unsigned short*)constScanLine(row, frm);
-
-                    // CREATE A VECTOR TO HOLD ALL THE CIRCLE CENTERS
-                    QVector<float> yVector((int)width(), -1e6);
-
-                    // ITERATE COLUMN BY COLUMN FROM LEFT TO RIGHT
-                    for (unsigned int col = 0; col < width(); col++){
-                        // SEE IF WE HAVE A VALID PIXEL
-                        if (fmBuffer[col] == 0 || fmBuffer[col] == 65535){
-                            continue;
-                        }
-
-                        // GET THE SCAN COORDINATE OF THE CURRENT PIXEL
-                        QPointF pointA((float)col*dx, (float)fmBuffer[col]*dy);
-
-                        // ONLY ITERATE THROUGH PIXELS WITHIN REACH OF THE RADIUS
-                        for (int deltaP = -pixelRadius; deltaP < pixelRadius; deltaP++){
-                            // DEFINE THE COLUMN PRIME
-                            unsigned int colP = qMin(width()-1, (unsigned int)qMax(0, (int)col + deltaP));
-
-                            // GET THE LINE COORDINATE OF THE CURRENT COLUMN
-                            float deltaX = (float)((int)colP - (int)col)*dx;
-
-                            // FIND THE POINT ON THE LINE THAT IS THE CENTER OF
-                            // THE CIRCLE GOING THROUGH OUR CURRENT SCAN POINT
-                            float yCoord = pointA.y() + qSqrt(radius * radius - deltaX * deltaX);
-
-                            // SEE IF THIS Y COORDINATE IS THE HIGHEST SO FAR
-                            yVector[colP] = qMax(yVector[colP], yCoord);
-                        }
-                    }
-
-                    // NOW THAT WE HAVE A LIST OF CIRCLES, WE NEED TO PROJECT THEM BACK
-                    // ONTO THE LINE SO LETS CREATE A BUFFER TO HOLD OUR RECONSTRUCTED SCAN
-                    QVector<float> xVector((int)width(), +1e6);
-
-                    // ITERATE COLUMN BY COLUMN FROM LEFT TO RIGHT
-                    for (unsigned int col = 0; col < width(); col++){
-                        // SEE IF WE HAVE A VALID PIXEL
-                        if (yVector[col] < -1e5){
-                            continue;
-                        }
-
-                        // GET THE CENTER COORDINATE OF THE CURRENT CIRCLE
-                        QPointF pointA((float)col*dx, yVector[col]);
-
-                        // ONLY ITERATE THROUGH PIXELS WITHIN REACH OF THE RADIUS
-                        for (int deltaP = -pixelRadius; deltaP < pixelRadius; deltaP++){
-                            // DEFINE THE COLUMN PRIME
-                            unsigned int colP = qMin(width()-1, (unsigned int)qMax(0, (int)col + deltaP));
-
-                            // GET THE X COORDINATE OF THE CURRENT COLUMN
-                            float deltaX = (float)((int)colP - (int)col)*dx;
-
-                            // FIND THE POINT ON THE LINE THAT IS THE CENTER OF
-                            // THE CIRCLE GOING THROUGH OUR CURRENT SCAN POINT
-                            float yCoord = pointA.y() - qSqrt(radius * radius - deltaX * deltaX);
-
-                            // SEE IF THIS Y COORDINATE IS THE LOWEST SO FAR
-                            xVector[colP] = qMin(xVector[colP], yCoord);
-                        }
-                    }
-
-                    // GRAB A POINTER TO THE INPUT AND OUTPUT BUFFER ROWS
-                    unsigned short *toBuffer = (unsigned short*)object.scanLine(row, frm);
-
-                    // ITERATE COLUMN BY COLUMN FROM LEFT TO RIGHT
-                    for (unsigned int col = 0; col < width(); col++){
-                        // CONVERT THE SCAN COORDINATE BACK TO A PIXEL VALUE
-                        if (toBuffer[col] != 0 && toBuffer[col] != 65535){
-                            toBuffer[col] = (unsigned short)qMax(0.0f, qMin(65535.0f, xVector[col] / dy));
-                        }
-                    }
-                }
+                // PROCESS THE ROWS OF THE CURRENT VIDEO FRAME IN PARALLEL, WHERE EACH CIRCLE
+                // REACHES FROM PIXELRADIUS COLUMNS TO ITS LEFT TO PIXELRADIUS-1 TO ITS RIGHT
+                unsigned short *buffer = (unsigned short*)object.scanLine(0, frm);
+                peakEnvelopeLines(buffer, (int)height(), (int)width(), (int)width(), 1, dx, dy, radius, pixelRadius, pixelRadius - 1);
             }
         }
     }
@@ -1053,7 +1612,7 @@ LAUMemoryObject LAUMemoryObject::peakEnvelope(float dx, float dy, float radius)
 void LAUMemoryObject::peakEnvelopeInPlace(float dx, float dy, float radius)
 {
     // GET THE RADIUS IN TERMS OF PIXELS
-    int pixelRadius = 0;
+    int pixelRadius = qMax(0, (int)qFloor(radius / dx));
 
     // FIGURE OUT HOW MANY COLORS WE NEED TO HANDLE
     if (colors() == 1){
@@ -1066,180 +1625,13 @@ void LAUMemoryObject::peakEnvelopeInPlace(float dx, float dy, float radius)
                 // Y COORDINATE AS THE CENTER OF THE CIRCLE. AND THEN GIVEN THE SET OF CIRCLES,
                 // PROJECT EACH RADIUS ONTO THE VERTICAL AXIS AND SORT AS YOU
                 // GO ALONG. TAKE THE FIRST RADIUS FROM THE BOTTOM.
+                unsigned short *fmBuffer = (unsigned short*)constScanLine(0, frm);
 
-                // CREATE A VECTOR TO HOLD THE INPUT PIXELS DEPENDING ON ROWWISE, COLUMNWISE, OR DIAGONAL
-                QVector<unsigned short> wVector;
-
-                // CREATE A VECTOR TO HOLD ALL THE CIRCLE CENTERS
-                QVector<float> yVector((int)width());
-                QVector<float> xVector((int)width());
-
-                // GET THE RADIUS IN TERMS OF PIXELS
-                pixelRadius = (int)qFloor(radius / dx);
-
-                // RESIZE THE W VECTOR TO HOLD EACH ROW OF THE INPUT IMAGE
-                wVector.resize(width());
-
-                // ITERATURE THROUGH EACH ROW OF THE CURRENT VIDEO FRAME
-                for (unsigned int row = 0; row < height(); row++){
-                    // GRAB THE POINTER TO THE SCAN BUFFER THAT WE INTEND TO READ FROM
-                    unsigned short *fmBuffer = (unsigned short*)constScanLine(row, frm);
-
-                    // COPY A ROW OF IMAGE PIXELS TO THE W VECTOR
-                    for (unsigned int col = 0; col < width(); col++){
-                        wVector[col] = fmBuffer[col];
-                    }
-
-                    // RESET OUR STORAGE VECTORS FOR A NEW ROW
-                    yVector.fill(-1e6);
-                    xVector.fill(+1e6);
-
-                    // ITERATE COLUMN BY COLUMN FROM LEFT TO RIGHT
-                    for (int ind = 0; ind < wVector.count(); ind++){
-                        // SEE IF WE HAVE A VALID PIXEL
-                        if (wVector[ind] != 0 && wVector[ind] != 65535){
-                            // GET THE SCAN COORDINATE OF THE CURRENT PIXEL
-                            QPointF pointA((float)ind * dx, (float)wVector[ind] * dy);
-
-                            // ONLY ITERATE THROUGH PIXELS WITHIN REACH OF THE RADIUS
-                            for (int deltaP = -pixelRadius; deltaP <= pixelRadius; deltaP++){
-                                // DEFINE THE COLUMN PRIME
-                                unsigned int indP = (unsigned int)qMin(wVector.count()-1, qMax(0, (int)ind + deltaP));
-
-                                // GET THE LINE COORDINATE OF THE CURRENT COLUMN
-                                float deltaX = (float)((int)indP - (int)ind) * dx;
-
-                                // FIND THE POINT ON THE LINE THAT IS THE CENTER OF
-                                // THE CIRCLE GOING THROUGH OUR CURRENT SCAN POINT
-                                float yCoord = pointA.y() + qSqrt((radius * radius) - (deltaX * deltaX));
-
-                                // SEE IF THIS Y COORDINATE IS THE HIGHEST SO FAR
-                                yVector[indP] = qMax(yVector[indP], yCoord);
-                            }
-                        }
-                    }
-
-                    // NOW THAT WE HAVE A LIST OF CIRCLES, WE NEED TO PROJECT THEM BACK
-                    // ONTO THE LINE SO LETS CREATE A BUFFER TO HOLD OUR RECONSTRUCTED SCAN
-                    for (int ind = 0; ind < wVector.count(); ind++){
-                        // SEE IF WE HAVE A VALID PIXEL
-                        if (yVector[ind] > -1e5){
-                            // GET THE CENTER COORDINATE OF THE CURRENT CIRCLE
-                            QPointF pointA((float)ind * dx, yVector[ind]);
-
-                            // ONLY ITERATE THROUGH PIXELS WITHIN REACH OF THE RADIUS
-                            for (int deltaP = -pixelRadius; deltaP <= pixelRadius; deltaP++){
-                                // DEFINE THE COLUMN PRIME
-                                unsigned int indP = qMin(width()-1, (unsigned int)qMax(0, (int)ind + deltaP));
-
-                                // GET THE X COORDINATE OF THE CURRENT COLUMN
-                                float deltaX = (float)((int)indP - (int)ind) * dx;
-
-                                // FIND THE POINT ON THE LINE THAT IS THE CENTER OF
-                                // THE CIRCLE GOING THROUGH OUR CURRENT SCAN POINT
-                                float yCoord = pointA.y() - qSqrt((radius * radius) - (deltaX * deltaX));
-
-                                // SEE IF THIS Y COORDINATE IS THE LOWEST SO FAR
-                                xVector[indP] = qMin(xVector[indP], yCoord);
-                            }
-                        }
-                    }
-
-                    // ITERATE COLUMN BY COLUMN FROM LEFT TO RIGHT
-                    for (int ind = 0; ind < wVector.count(); ind++){
-                        // CONVERT THE SCAN COORDINATE BACK TO A PIXEL VALUE
-                        if (wVector[ind] != 0 && wVector[ind] != 65535){
-                            wVector[ind] = (unsigned short)qMax(0.0f, qMin(65535.0f, xVector[ind] / dy));
-                        }
-                    }
-
-                    // COPY THE W VECTOR TO A ROW OF IMAGE PIXELS TO THE
-                    for (unsigned int col = 0; col < width(); col++){
-                        fmBuffer[col] = wVector[col];
-                    }
-                }
-
-                // RESIZE THE W VECTOR TO HOLD EACH COLUMN OF THE INPUT IMAGE
-                wVector.resize(height());
-
-                // ITERATURE THROUGH EACH ROW OF THE CURRENT VIDEO FRAME
-                for (unsigned int col = 0; col < width(); col++){
-                    // GRAB THE POINTER TO THE SCAN BUFFER THAT WE INTEND TO READ FROM
-                    unsigned short *fmBuffer = (unsigned short*)constScanLine(0, frm);
-
-                    // COPY A COLUMN OF IMAGE PIXELS TO THE W VECTOR
-                    for (unsigned int row = 0; row < height(); row++){
-                        wVector[row] = fmBuffer[row * step() + col];
-                    }
-
-                    // RESET OUR STORAGE VECTORS FOR A NEW ROW
-                    yVector.fill(-1e6);
-                    xVector.fill(+1e6);
-
-                    // ITERATE COLUMN BY COLUMN FROM LEFT TO RIGHT
-                    for (int ind = 0; ind < wVector.count(); ind++){
-                        // SEE IF WE HAVE A VALID PIXEL
-                        if (wVector[ind] != 0 && wVector[ind] != 65535){
-                            // GET THE SCAN COORDINATE OF THE CURRENT PIXEL
-                            QPointF pointA((float)ind * dx, (float)wVector[ind] * dy);
-
-                            // ONLY ITERATE THROUGH PIXELS WITHIN REACH OF THE RADIUS
-                            for (int deltaP = -pixelRadius; deltaP <= pixelRadius; deltaP++){
-                                // DEFINE THE COLUMN PRIME
-                                unsigned int indP = (unsigned int)qMin(wVector.count()-1, qMax(0, (int)ind + deltaP));
-
-                                // GET THE LINE COORDINATE OF THE CURRENT COLUMN
-                                float deltaX = (float)((int)indP - (int)ind) * dx;
-
-                                // FIND THE POINT ON THE LINE THAT IS THE CENTER OF
-                                // THE CIRCLE GOING THROUGH OUR CURRENT SCAN POINT
-                                float yCoord = pointA.y() + qSqrt((radius * radius) - (deltaX * deltaX));
-
-                                // SEE IF THIS Y COORDINATE IS THE HIGHEST SO FAR
-                                yVector[indP] = qMax(yVector[indP], yCoord);
-                            }
-                        }
-                    }
-
-                    // NOW THAT WE HAVE A LIST OF CIRCLES, WE NEED TO PROJECT THEM BACK
-                    // ONTO THE LINE SO LETS CREATE A BUFFER TO HOLD OUR RECONSTRUCTED SCAN
-                    for (int ind = 0; ind < wVector.count(); ind++){
-                        // SEE IF WE HAVE A VALID PIXEL
-                        if (yVector[ind] > -1e5){
-                            // GET THE CENTER COORDINATE OF THE CURRENT CIRCLE
-                            QPointF pointA((float)ind * dx, yVector[ind]);
-
-                            // ONLY ITERATE THROUGH PIXELS WITHIN REACH OF THE RADIUS
-                            for (int deltaP = -pixelRadius; deltaP <= pixelRadius; deltaP++){
-                                // DEFINE THE COLUMN PRIME
-                                unsigned int indP = qMin(width()-1, (unsigned int)qMax(0, (int)ind + deltaP));
-
-                                // GET THE X COORDINATE OF THE CURRENT COLUMN
-                                float deltaX = (float)((int)indP - (int)ind) * dx;
-
-                                // FIND THE POINT ON THE LINE THAT IS THE CENTER OF
-                                // THE CIRCLE GOING THROUGH OUR CURRENT SCAN POINT
-                                float yCoord = pointA.y() - qSqrt((radius * radius) - (deltaX * deltaX));
-
-                                // SEE IF THIS Y COORDINATE IS THE LOWEST SO FAR
-                                xVector[indP] = qMin(xVector[indP], yCoord);
-                            }
-                        }
-                    }
-
-                    // ITERATE COLUMN BY COLUMN FROM LEFT TO RIGHT
-                    for (int ind = 0; ind < wVector.count(); ind++){
-                        // CONVERT THE SCAN COORDINATE BACK TO A PIXEL VALUE
-                        if (wVector[ind] != 0 && wVector[ind] != 65535){
-                            wVector[ind] = (unsigned short)qMax(0.0f, qMin(65535.0f, xVector[ind] / dy));
-                        }
-                    }
+                // PROCESS THE ROWS OF THE CURRENT VIDEO FRAME IN PARALLEL
+                peakEnvelopeLines(fmBuffer, (int)height(), (int)width(), (int)width(), 1, dx, dy, radius, pixelRadius, pixelRadius);
 
-                    // COPY THE W VECTOR TO A COLUMN OF IMAGE PIXELS TO THE
-                    for (unsigned int row = 0; row < height(); row++){
-                        fmBuffer[row * step() + col] = wVector[row];
-                    }
-                }
+                // AND THEN THE COLUMNS, STEPPING ONE FULL ROW OF PIXELS BETWEEN SAMPLES
+                peakEnvelopeLines(fmBuffer, (int)width(), 1, (int)height(), (int)width(), dx, dy, radius, pixelRadius, pixelRadius);
 #ifdef DONTCOMPILE
                 // GET THE RADIUS IN TERMS OF PIXELS
                 pixelRadius = (int)qFloor(radius / (dx * qSqrt(2.0)));
@@ -1505,7 +1897,7 @@ LAUMemoryObject LAUMemoryObject::getFrame(int frm) const
 {
     // CREATE MEMORY OBJECT TO RETURN TO USER
     LAUMemoryObject object(width(), height(), colors(), depth(), 1);
-    memcpy(object.constPointer(), constFrame(frm), object.length());
+    memcpy(object.pointer(), constFrame(frm), object.length());
 
     // COPY METADATA
     object.setXML(xml());
@@ -1723,6 +2115,77 @@ QImage LAUMemoryObject::toImage(int frame) const
     return (image);
 }
 #endif
+#ifdef LAUMEMORYOBJECTAVXDISPATCH
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMEMORYOBJECTAVX2 static unsigned int zeroSamplesAVX2(const unsigned char *buffer, unsigned long long bytes, unsigned int depth, unsigned long long *offset)
+{
+    // COUNT THE ZERO SAMPLES THIRTY-TWO BYTES AT A TIME AND TELL THE CALLER
+    // WHERE WE STOPPED SO IT CAN FINISH THE LAST SIXTEEN BYTES WITH SSE
+    unsigned long long n = 0;
+    unsigned long long zeros = 0;
+    __m256i zeroVec = _mm256_setzero_si256();
+    __m256i acSum = _mm256_setzero_si256();
+    if (depth == sizeof(unsigned char)) {
+        for (; n + 32 <= bytes; n += 32) {
+            __m256i pixels = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(buffer + n)), zeroVec);
+            acSum = _mm256_add_epi64(acSum, _mm256_sad_epu8(pixels, zeroVec));
+        }
+        unsigned long long lanes[4];
+        _mm256_storeu_si256((__m256i *)lanes, acSum);
+        zeros = (lanes[0] + lanes[1] + lanes[2] + lanes[3]) / 255;
+    } else if (depth == sizeof(unsigned short)) {
+        __m256i oneVec = _mm256_set1_epi16(-1);
+        for (; n + 32 <= bytes; n += 32) {
+            __m256i pixels = _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *)(buffer + n)), zeroVec);
+            acSum = _mm256_add_epi32(acSum, _mm256_madd_epi16(pixels, oneVec));
+        }
+    } else if (depth == sizeof(float)) {
+        for (; n + 32 <= bytes; n += 32) {
+            __m256 pixels = _mm256_cmp_ps(_mm256_loadu_ps((const float *)(buffer + n)), _mm256_setzero_ps(), _CMP_EQ_OQ);
+            acSum = _mm256_sub_epi32(acSum, _mm256_castps_si256(pixels));
+        }
+    }
+
+    if (depth == sizeof(unsigned short) || depth == sizeof(float)) {
+        unsigned int lanes[8];
+        _mm256_storeu_si256((__m256i *)lanes, acSum);
+        for (int lane = 0; lane < 8; lane++) {
+            zeros += lanes[lane];
+        }
+    }
+    *offset = n;
+    return ((unsigned int)zeros);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMEMORYOBJECTAVX512 static unsigned int zeroSamplesAVX512(const unsigned char *buffer, unsigned long long bytes, unsigned int depth, unsigned long long *offset)
+{
+    // SAME AS THE AVX2 VERSION BUT SIXTY-FOUR BYTES AT A TIME, COUNTING THE BITS OF THE COMPARE MASKS
+    unsigned long long n = 0;
+    unsigned long long zeros = 0;
+    __m512i zeroVec = _mm512_setzero_si512();
+    if (depth == sizeof(unsigned char)) {
+        for (; n + 64 <= bytes; n += 64) {
+            zeros += _mm_popcnt_u64(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void *)(buffer + n)), zeroVec));
+        }
+    } else if (depth == sizeof(unsigned short)) {
+        for (; n + 64 <= bytes; n += 64) {
+            zeros += _mm_popcnt_u32(_mm512_cmpeq_epi16_mask(_mm512_loadu_si512((const void *)(buffer + n)), zeroVec));
+        }
+    } else if (depth == sizeof(float)) {
+        for (; n + 64 <= bytes; n += 64) {
+            zeros += _mm_popcnt_u32(_mm512_cmp_ps_mask(_mm512_loadu_ps((const void *)(buffer + n)), _mm512_setzero_ps(), _CMP_EQ_OQ));
+        }
+    }
+    *offset = n;
+    return ((unsigned int)zeros);
+}
+#endif
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -1734,15 +2197,27 @@ unsigned int LAUMemoryObject::nonZeroPixelsCount(int chn) const
     // CREATE A VECTOR TO HOLD THE ACCUMULATED SUM OF PIXELS
     __m128i acSum = _mm_set1_epi32(0);
 
+    // GRAB THE POINTER TO THE MEMORY OBJECT DATA
+    unsigned char *buffer = (unsigned char *)constFrame(chn % frames());
+
+    // LET THE WIDEST AVAILABLE KERNEL COUNT THE ZEROS IN AS MUCH OF THE BUFFER AS IT
+    // CAN AND THEN FINISH WHATEVER SIXTEEN BYTE BLOCKS ARE LEFT WITH THE SSE LOOPS
+    unsigned long long n = 0;
+    unsigned int zeroCount = 0;
+#ifdef LAUMEMORYOBJECTAVXDISPATCH
+    if (LAUMemoryObjectSimd::level() == LAUMemoryObjectSimd::LevelAVX512) {
+        zeroCount = zeroSamplesAVX512(buffer, length(), depth(), &n);
+    } else if (LAUMemoryObjectSimd::level() == LAUMemoryObjectSimd::LevelAVX2) {
+        zeroCount = zeroSamplesAVX2(buffer, length(), depth(), &n);
+    }
+#endif
+
     if (depth() == sizeof(unsigned char)) {
         // CREATE A ZERO VECTOR FOR THE COMPARE OPERATION
         __m128i zeros = _mm_set1_epi8(0);
 
-        // GRAB THE POINTER TO THE MEMORY OBJECT DATA
-        unsigned char *buffer = (unsigned char *)constFrame(chn % frames());
-
         // ITERATE THROUGH THE BUFFER 16 BYTES AT A TIME
-        for (unsigned int n = 0; n < length(); n += 16) {
+        for (; n < length(); n += 16) {
             __m128i pixels = _mm_cmpeq_epi8(_mm_load_si128((const __m128i *)(buffer + n)), zeros);
 
             // HORIZONTAL SUM THE BYTES INTO 64-BIT INTEGERS AND
@@ -1760,11 +2235,8 @@ unsigned int LAUMemoryObject::nonZeroPixelsCount(int chn) const
         // CREATE A ZERO VECTOR FOR THE COMPARE OPERATION
         __m128i zeros = _mm_set1_epi16(0);
 
-        // GRAB THE POINTER TO THE MEMORY OBJECT DATA
-        unsigned char *buffer = (unsigned char *)constFrame(chn % frames());
-
         // ITERATE THROUGH THE BUFFER 16 BYTES AT A TIME
-        for (unsigned int n = 0; n < length(); n += 16) {
+        for (; n < length(); n += 16) {
             __m128i pixels = _mm_cmpeq_epi16(_mm_load_si128((const __m128i *)(buffer + n)), zeros);
 
             // UNPACK FROM UNSIGNED SHORTS TO UNSIGNED INTS
@@ -1783,11 +2255,8 @@ unsigned int LAUMemoryObject::nonZeroPixelsCount(int chn) const
         // CREATE A ZERO VECTOR FOR THE COMPARE OPERATION
         __m128 zeros = _mm_set1_ps(0.0f);
 
-        // GRAB THE POINTER TO THE MEMORY OBJECT DATA
-        unsigned char *buffer = (unsigned char *)constFrame(chn % frames());
-
         // ITERATE THROUGH THE BUFFER 16 BYTES AT A TIME
-        for (unsigned int n = 0; n < length(); n += 16) {
+        for (; n < length(); n += 16) {
             __m128i pixels = _mm_castps_si128(_mm_cmpeq_ps(_mm_load_ps((const float *)(buffer + n)), zeros));
 
             // ACCUMULATE THE SUM OF THE VECTORS TO FORM A SUM OF INTS
@@ -1803,7 +2272,7 @@ unsigned int LAUMemoryObject::nonZeroPixelsCount(int chn) const
     // AT THIS POINT, THE SUM OF ZEROS RESULTS IN ADDING -1S TOGETHER
     // SO WE JUST NEED TO ADD THE NUMBER OF PIXELS TO GET THE NUMBER
     // OF NON-ZERO PIXELS IN THE BUFFER
-    pixels = (unsigned int)((int)(width() * height() * colors()) - (int)pixels);
+    pixels = (unsigned int)((int)(width() * height() * colors()) - (int)(pixels + zeroCount));
 
     // RETURN THE NUMBER OF NON-ZERO PIXELS
     return (pixels);
@@ -1915,16 +2384,52 @@ QHash<QString, QString> LAUMemoryObject::xmlToHash(QByteArray byteArray)
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-int LAUMemoryObject::howManyDirectoriesDoesThisTiffFileHave(QString filename)
+QByteArray LAUMemoryObject::hashToXml(QHash<QString, QString> hashTable)
 {
-    // GET A FILE TO OPEN FROM THE USER IF NOT ALREADY PROVIDED ONE
-    if (filename.isNull()) {
-        return (-1);
+    // CREATE THE XML DATA PACKET USING QT'S XML STREAM OBJECTS
+    QByteArray xmlByteArray;
+    QBuffer buffer(&xmlByteArray);
+    buffer.open(QIODevice::WriteOnly);
+
+    QXmlStreamWriter writer(&buffer);
+    writer.setAutoFormatting(true);
+    writer.writeStartDocument();
+    writer.writeStartElement("scan");
+
+    QHashIterator<QString, QString> i(hashTable);
+    while (i.hasNext()) {
+        i.next();
+        writer.writeTextElement(i.key(), i.value());
     }
 
-    // IF WE HAVE A VALID TIFF FILE, LOAD FROM DISK
-    // OTHERWISE TRY TO CONNECT TO SCANNER
+    // CLOSE OUT THE XML BUFFER
+    writer.writeEndElement();
+    writer.writeEndDocument();
+    buffer.close();
+
+    // RETURN THE XML PACKET TO THE USER
+    return(xmlByteArray);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+int LAUMemoryObject::howManyDirectoriesDoesThisTiffFileHave(QString filename)
+{
+    // GET A FILE TO OPEN FROM THE USER IF NOT ALREADY PROVIDED ONE
+    if (filename.isNull()) {
+        return (-1);
+    }
+
+    // IF WE HAVE A VALID TIFF FILE, LOAD FROM DISK
+    // OTHERWISE TRY TO CONNECT TO SCANNER
     if (QFile::exists(filename)) {
+        // AN UP TO DATE DIRECTORY INDEX ALREADY KNOWS THE ANSWER WITHOUT WALKING THE FILE
+        QVector<quint64> offsets = LAUMemoryObjectReader::cachedOffsets(filename);
+        if (offsets.isEmpty() == false) {
+            return (offsets.count());
+        }
+
         // OPEN INPUT TIFF FILE FROM DISK
         TIFF *inTiff = TIFFOpen(filename.toLatin1(), "r");
         if (!inTiff) {
@@ -2120,6 +2625,133 @@ void LAUMemoryObjectManager::onReleaseFrame(LAUMemoryObject frame)
     }
 }
 
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObjectPool::LAUMemoryObjectPool(unsigned int cols, unsigned int rows, unsigned int chns, unsigned int byts, unsigned int frms, int size) : numRows(rows), numCols(cols), numChns(chns), numByts(byts), numFrms(frms), mask(0), ring(nullptr), enqueuePosition(0), dequeuePosition(0), missCounter(0)
+{
+    // ROUND THE NUMBER OF CELLS UP TO A POWER OF TWO SO WE CAN WRAP WITH A MASK
+    int length = 2;
+    while (length < size) {
+        length *= 2;
+    }
+    mask = (quint32)(length - 1);
+
+    // SEED EACH CELL WITH ITS OWN INDEX AS ITS SEQUENCE NUMBER SO IT STARTS OUT EMPTY
+    cells = QVector<Cell>(length);
+    ring = cells.data();
+    for (int n = 0; n < length; n++) {
+        ring[n].sequence.storeRelease((quint32)n);
+    }
+
+    // PRE-ALLOCATE THE FRAME BUFFERS SO NO ALLOCATION HAPPENS WHILE RECORDING
+    if (isValid()) {
+        for (int n = 0; n < size; n++) {
+            push(LAUMemoryObject(numCols, numRows, numChns, numByts, numFrms));
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObjectPool::~LAUMemoryObjectPool()
+{
+    if (misses() > 0) {
+        qDebug() << QString("LAUMemoryObjectPool::~LAUMemoryObjectPool() %1 frames allocated outside the pool").arg(misses());
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObject LAUMemoryObjectPool::acquire()
+{
+    // TAKE THE NEXT FREE BUFFER AND ONLY FALL BACK TO THE HEAP IF THE POOL HAS RUN DRY
+    LAUMemoryObject object;
+    if (pop(object)) {
+        return (object);
+    }
+
+    if (isValid()) {
+        missCounter.fetchAndAddOrdered(1);
+        return (LAUMemoryObject(numCols, numRows, numChns, numByts, numFrms));
+    }
+    return (LAUMemoryObject());
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUMemoryObjectPool::release(LAUMemoryObject object)
+{
+    // ONLY KEEP BUFFERS OF OUR SHAPE AND LET EVERYTHING ELSE FREE ITSELF
+    if (object.isNull() || matches(object) == false) {
+        return (false);
+    }
+    return (push(object));
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUMemoryObjectPool::push(const LAUMemoryObject &object)
+{
+    // CLAIM A CELL BY ADVANCING THE ENQUEUE POSITION, WHICH WE CAN ONLY DO IF THE
+    // CELL'S SEQUENCE NUMBER SAYS IT WAS EMPTIED BY THE CONSUMER ON THE PREVIOUS LAP
+    quint32 position = enqueuePosition.loadAcquire();
+    Cell *cell = nullptr;
+    forever {
+        cell = &ring[position & mask];
+        qint32 difference = (qint32)(cell->sequence.loadAcquire() - position);
+        if (difference == 0) {
+            if (enqueuePosition.testAndSetOrdered(position, position + 1)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // THE RING IS FULL
+            return (false);
+        }
+        position = enqueuePosition.loadAcquire();
+    }
+
+    // STORE THE OBJECT AND PUBLISH THE CELL TO CONSUMERS
+    cell->object = object;
+    cell->sequence.storeRelease(position + 1);
+    return (true);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUMemoryObjectPool::pop(LAUMemoryObject &object)
+{
+    // CLAIM A CELL BY ADVANCING THE DEQUEUE POSITION, WHICH WE CAN ONLY DO IF THE
+    // CELL'S SEQUENCE NUMBER SAYS IT WAS FILLED BY A PRODUCER ON THIS LAP
+    quint32 position = dequeuePosition.loadAcquire();
+    Cell *cell = nullptr;
+    forever {
+        cell = &ring[position & mask];
+        qint32 difference = (qint32)(cell->sequence.loadAcquire() - (position + 1));
+        if (difference == 0) {
+            if (dequeuePosition.testAndSetOrdered(position, position + 1)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // THE RING IS EMPTY
+            return (false);
+        }
+        position = dequeuePosition.loadAcquire();
+    }
+
+    // MOVE THE OBJECT OUT SO THE POOL HOLDS NO REFERENCE WHILE IT IS IN USE, WHICH
+    // KEEPS THE CALLER'S NON-CONST ACCESSORS FROM TRIGGERING A DEEP COPY
+    object = cell->object;
+    cell->object = LAUMemoryObject();
+    cell->sequence.storeRelease(position + mask + 1);
+    return (true);
+}
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -2168,6 +2800,9 @@ void LAUMemoryObjectWriter::run()
         for (unsigned int frm = 0; frm < object.frames(); frm++) {
             qDebug() << "LAUMemoryObjectWriter::run()" << frm << object.frames();
 
+            // WRITE THE ELAPSED TIME STAMP FIRST SO THE IMAGE DIRECTORY CAN POINT TO IT
+            uint64_t exifOffset = writeSubSecTimeDirectory(tiff, QString("%1").arg(object.elapsed()).toLatin1());
+
             // WRITE FORMAT PARAMETERS TO CURRENT TIFF DIRECTORY
             TIFFSetField(tiff, TIFFTAG_SUBFILETYPE, FILETYPE_PAGE);
             TIFFSetField(tiff, TIFFTAG_IMAGEWIDTH, (unsigned long)object.width());
@@ -2182,7 +2817,7 @@ void LAUMemoryObjectWriter::run()
             TIFFSetField(tiff, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_MINISBLACK);
             TIFFSetField(tiff, TIFFTAG_COMPRESSION, COMPRESSION_LZW);
             TIFFSetField(tiff, TIFFTAG_PREDICTOR, PREDICTOR_HORIZONTAL);
-            TIFFSetField(tiff, TIFFTAG_ROWSPERSTRIP, 1);
+            TIFFSetField(tiff, TIFFTAG_ROWSPERSTRIP, (unsigned int)qBound(1, LAUMEMORYOBJECTROWSPERSTRIP, (int)object.height()));
 
             if (object.depth() == sizeof(float)) {
                 // SEE IF WE HAVE TO TELL THE TIFF READER THAT WE ARE STORING
@@ -2199,18 +2834,13 @@ void LAUMemoryObjectWriter::run()
             }
             free(tempBuffer);
 
+            // POINT THE IMAGE DIRECTORY AT ITS EXIF DIRECTORY
+            if (exifOffset != 0) {
+                TIFFSetField(tiff, TIFFTAG_EXIFIFD, exifOffset);
+            }
+
             // WRITE THE CURRENT DIRECTORY AND PREPARE FOR THE NEW ONE
             TIFFWriteDirectory(tiff);
-
-            // WRITE THE ELAPSED TIME STAMP TO AN EXIF TAG
-            uint64_t dir_offset;
-            TIFFCreateEXIFDirectory(tiff);
-            TIFFSetField(tiff, EXIFTAG_SUBSECTIME, QString("%1").arg(object.elapsed()).toLatin1().data());
-            TIFFWriteCustomDirectory(tiff, &dir_offset);
-
-            TIFFSetDirectory(tiff, (unsigned short)frm);
-            TIFFSetField(tiff, TIFFTAG_EXIFIFD, dir_offset);
-            TIFFRewriteDirectory(tiff);
         }
         TIFFClose(tiff);
     }
@@ -2220,7 +2850,7 @@ void LAUMemoryObjectWriter::run()
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-void LAUMemoryObject::flipUpDownInPlace() const
+void LAUMemoryObject::flipUpDownInPlace()
 {
     // ALLOCATE A BLOCK OF MEMORY FOR HOLDING AN INTERMEDIATE NUGGET OF DATA
     unsigned char *mdBuffer = (unsigned char *)_mm_malloc(step(), 16);
@@ -2229,8 +2859,8 @@ void LAUMemoryObject::flipUpDownInPlace() const
     for (unsigned int frm = 0; frm < frames(); frm++) {
         for (unsigned int row = 0; row < height() / 2; row++) {
             // GRAB POINTERS TO THE BEGINNING AND END OF THE CURRENT ROW
-            unsigned char *toBuffer = constScanLine(height() - 1 - row, frm);
-            unsigned char *fmBuffer = constScanLine(row, frm);
+            unsigned char *toBuffer = scanLine(height() - 1 - row, frm);
+            unsigned char *fmBuffer = scanLine(row, frm);
 
             // SWAP IMAGE ROWS
             memcpy(mdBuffer, fmBuffer, step());
@@ -2246,7 +2876,7 @@ void LAUMemoryObject::flipUpDownInPlace() const
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-void LAUMemoryObject::flipLeftRightInPlace() const
+void LAUMemoryObject::flipLeftRightInPlace()
 {
     // ALLOCATE A BLOCK OF MEMORY FOR HOLDING AN INTERMEDIATE NUGGET OF DATA
     unsigned char mdBuffer[1024];
@@ -2255,8 +2885,8 @@ void LAUMemoryObject::flipLeftRightInPlace() const
     for (unsigned int frm = 0; frm < frames(); frm++) {
         for (unsigned int row = 0; row < height(); row++) {
             // GRAB POINTERS TO THE BEGINNING AND END OF THE CURRENT ROW
-            unsigned char *toBuffer = constScanLine(row + 1, frm);
-            unsigned char *fmBuffer = constScanLine(row, frm);
+            unsigned char *toBuffer = scanLine(row + 1, frm);
+            unsigned char *fmBuffer = scanLine(row, frm);
 
             // ITERATE ACROSS THE ROW ONE NUGGET AT A TIME
             for (unsigned int col = 0; col < width() / 2; col++) {
@@ -2273,7 +2903,7 @@ void LAUMemoryObject::flipLeftRightInPlace() const
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-void LAUMemoryObject::rotate180InPlace() const
+void LAUMemoryObject::rotate180InPlace()
 {
     // ITERATE THROUGH EVERY ROW OF EVERY FRAME
     for (unsigned int frm = 0; frm < frames(); frm++) {
@@ -2284,14 +2914,14 @@ void LAUMemoryObject::rotate180InPlace() const
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-void LAUMemoryObject::rotateFrame180InPlace(int frm) const
+void LAUMemoryObject::rotateFrame180InPlace(int frm)
 {
     // ALLOCATE A BLOCK OF MEMORY FOR HOLDING AN INTERMEDIATE NUGGET OF DATA
     unsigned char mdBuffer[1024];
 
     // GRAB POINTERS TO THE BEGINNING AND END OF THE CURRENT FRAME
-    unsigned char *toBuffer = constScanLine(0, frm + 1);
-    unsigned char *fmBuffer = constScanLine(0, frm);
+    unsigned char *toBuffer = scanLine(0, frm + 1);
+    unsigned char *fmBuffer = scanLine(0, frm);
 
     // ITERATE THROUGH ALL PIXELS FROM LEFT TO RIGHT AND TOP TO BOTTOM
     for (unsigned int pxl = 0; pxl < height()*width() / 2; pxl++) {
@@ -2331,68 +2961,170 @@ LAUMemoryObject LAUMemoryObject::flipLeftRight() const
     return (object);
 }
 
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static void minAreaFilterMinimum(const unsigned char *inA, const unsigned char *inB, unsigned char *out, unsigned int bytes, unsigned int depth)
+{
+    // TAKE THE ELEMENT-WISE MINIMUM OF TWO SCAN LINES SIXTEEN BYTES AT A TIME
+    unsigned int byt = 0;
+    if (depth == sizeof(unsigned char)) {
+        for (; byt + 16 <= bytes; byt += 16) {
+            _mm_storeu_si128((__m128i *)(out + byt), _mm_min_epu8(_mm_loadu_si128((const __m128i *)(inA + byt)), _mm_loadu_si128((const __m128i *)(inB + byt))));
+        }
+        for (; byt < bytes; byt++) {
+            out[byt] = qMin(inA[byt], inB[byt]);
+        }
+    } else if (depth == sizeof(unsigned short)) {
+        for (; byt + 16 <= bytes; byt += 16) {
+            _mm_storeu_si128((__m128i *)(out + byt), _mm_min_epu16(_mm_loadu_si128((const __m128i *)(inA + byt)), _mm_loadu_si128((const __m128i *)(inB + byt))));
+        }
+        for (; byt < bytes; byt += sizeof(unsigned short)) {
+            ((unsigned short *)(out + byt))[0] = qMin(((const unsigned short *)(inA + byt))[0], ((const unsigned short *)(inB + byt))[0]);
+        }
+    } else if (depth == sizeof(float)) {
+        for (; byt + 16 <= bytes; byt += 16) {
+            _mm_storeu_ps((float *)(out + byt), _mm_min_ps(_mm_loadu_ps((const float *)(inA + byt)), _mm_loadu_ps((const float *)(inB + byt))));
+        }
+        for (; byt < bytes; byt += sizeof(float)) {
+            ((float *)(out + byt))[0] = qMin(((const float *)(inA + byt))[0], ((const float *)(inB + byt))[0]);
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+template<class T> static void minAreaFilterRow(T *buffer, int cols, int chns, int rad, T ceiling, T *fwd, T *bwd)
+{
+    // RUN THE SAME BLOCKED FORWARD AND BACKWARD MINIMUMS USED ON THE COLUMNS ALONG A SINGLE
+    // ROW, ONE CHANNEL AT A TIME, PADDING BOTH ENDS WITH THE LARGEST POSSIBLE VALUE
+    int span = 2 * rad + 1;
+    int length = cols + 2 * rad;
+    for (int chn = 0; chn < chns; chn++) {
+        for (int p = 0; p < length; p++) {
+            T val = (p >= rad && p < rad + cols) ? buffer[(p - rad) * chns + chn] : ceiling;
+            fwd[p] = (p % span == 0) ? val : qMin(fwd[p - 1], val);
+        }
+        for (int p = length - 1; p >= 0; p--) {
+            T val = (p >= rad && p < rad + cols) ? buffer[(p - rad) * chns + chn] : ceiling;
+            bwd[p] = (p % span == span - 1 || p == length - 1) ? val : qMin(bwd[p + 1], val);
+        }
+        for (int col = 0; col < cols; col++) {
+            buffer[col * chns + chn] = qMin(bwd[col], fwd[col + 2 * rad]);
+        }
+    }
+}
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
 LAUMemoryObject LAUMemoryObject::minAreaFilter(int rad) const
 {
     LAUMemoryObject object(*this);
+    if (rad < 1 || isNull()) {
+        return (object);
+    }
+
+    if (depth() != sizeof(unsigned char) && depth() != sizeof(unsigned short) && depth() != sizeof(float)) {
+        return (object);
+    }
+
+    // THE CLAMPED (2R+1)X(2R+1) WINDOW IS A CLAMPED COLUMN WINDOW TIMES A CLAMPED ROW WINDOW, SO WE
+    // TAKE A RUNNING MINIMUM DOWN THE COLUMNS USING WHOLE SCAN LINES AND THEN ONE ALONG EACH ROW.
+    // BOTH PASSES SPLIT THE PADDED SIGNAL INTO BLOCKS OF 2R+1 SAMPLES AND KEEP A FORWARD AND A
+    // BACKWARD MINIMUM INSIDE EACH BLOCK (VAN HERK/GIL-WERMAN) SO THAT ANY WINDOW IS THE MINIMUM
+    // OF ONE BACKWARD AND ONE FORWARD SAMPLE, MAKING THE COST PER PIXEL INDEPENDENT OF THE RADIUS
+    int rows = (int)height();
+    int cols = (int)width();
+    int span = 2 * rad + 1;
+    int length = rows + 2 * rad;
+    unsigned int bytes = step();
+
+    unsigned char *ceiling = (unsigned char *)_mm_malloc(bytes + 16, 16);
+    unsigned char *fwd = (unsigned char *)_mm_malloc((size_t)length * bytes + 16, 16);
+    unsigned char *bwd = (unsigned char *)_mm_malloc((size_t)length * bytes + 16, 16);
+    unsigned char *line = (unsigned char *)_mm_malloc((size_t)2 * (cols + 2 * rad) * depth() + 16, 16);
+
+    // FILL THE PADDING SCAN LINE WITH THE LARGEST VALUE OF THE PIXEL TYPE
+    if (depth() == sizeof(float)) {
+        for (unsigned int n = 0; n < bytes / sizeof(float); n++) {
+            ((float *)ceiling)[n] = INFINITY;
+        }
+    } else {
+        memset(ceiling, 0xff, bytes);
+    }
 
-    if (depth() == sizeof(unsigned char)) {
-        for (unsigned int frm = 0; frm < frames(); frm++) {
-            for (int row = 0; row < (int)height(); row++) {
-                unsigned char *toBuffer = object.scanLine(row, frm);
-                for (int col = 0; col < (int)width(); col++) {
-                    for (int dy = -rad; dy <= rad; dy++) {
-                        int rwp = qMin((int)height() - 1, qMax(0, row + dy));
-                        unsigned char *fmBuffer = constScanLine(rwp, frm);
-                        for (int dx = -rad; dx <= rad; dx++) {
-                            int clp = qMin((int)width() - 1, qMax(0, col + dx));
-                            for (unsigned int chn = 0; chn < colors(); chn++) {
-                                toBuffer[col * colors() + chn] = qMin(toBuffer[col * colors() + chn], fmBuffer[clp * colors() + chn]);
-                            }
-                        }
-                    }
+    for (unsigned int frm = 0; frm < frames(); frm++) {
+        if (depth() == sizeof(float)) {
+            // QMIN() KEEPS THE LATER SAMPLE ON TIES AND WHENEVER A NAN IS INVOLVED, SO A FRAME HOLDING
+            // NANS OR NEGATIVE ZEROS DEPENDS ON THE ORDER OF THE SCAN AND HAS TO BE SCANNED THE OLD WAY
+            bool orderedFlag = false;
+            const unsigned int *bits = (const unsigned int *)constFrame(frm);
+            for (unsigned int n = 0; n < (unsigned int)(rows * cols) * colors(); n++) {
+                if ((bits[n] & 0x7fffffff) > 0x7f800000 || bits[n] == 0x80000000) {
+                    orderedFlag = true;
+                    break;
                 }
             }
-        }
-    } else if (depth() == sizeof(unsigned short)) {
-        for (unsigned int frm = 0; frm < frames(); frm++) {
-            for (int row = 0; row < (int)height(); row++) {
-                unsigned short *toBuffer = (unsigned short *)object.scanLine(row, frm);
-                for (int col = 0; col < (int)width(); col++) {
-                    for (int dy = -rad; dy <= rad; dy++) {
-                        int rwp = qMin((int)height() - 1, qMax(0, row + dy));
-                        unsigned short *fmBuffer = (unsigned short *)constScanLine(rwp, frm);
-                        for (int dx = -rad; dx <= rad; dx++) {
-                            int clp = qMin((int)width() - 1, qMax(0, col + dx));
-                            for (unsigned int chn = 0; chn < colors(); chn++) {
-                                toBuffer[col * colors() + chn] = qMin(toBuffer[col * colors() + chn], fmBuffer[clp * colors() + chn]);
+
+            if (orderedFlag) {
+                for (int row = 0; row < rows; row++) {
+                    float *toBuffer = (float *)object.scanLine(row, frm);
+                    for (int col = 0; col < cols; col++) {
+                        for (int dy = -rad; dy <= rad; dy++) {
+                            int rwp = qMin(rows - 1, qMax(0, row + dy));
+                            float *fmBuffer = (float *)constScanLine(rwp, frm);
+                            for (int dx = -rad; dx <= rad; dx++) {
+                                int clp = qMin(cols - 1, qMax(0, col + dx));
+                                for (unsigned int chn = 0; chn < colors(); chn++) {
+                                    toBuffer[col * colors() + chn] = qMin(toBuffer[col * colors() + chn], fmBuffer[clp * colors() + chn]);
+                                }
                             }
                         }
                     }
                 }
+                continue;
             }
         }
-    } else if (depth() == sizeof(float)) {
-        for (unsigned int frm = 0; frm < frames(); frm++) {
-            for (int row = 0; row < (int)height(); row++) {
-                float *toBuffer = (float *)object.scanLine(row, frm);
-                for (int col = 0; col < (int)width(); col++) {
-                    for (int dy = -rad; dy <= rad; dy++) {
-                        int rwp = qMin((int)height() - 1, qMax(0, row + dy));
-                        float *fmBuffer = (float *)constScanLine(rwp, frm);
-                        for (int dx = -rad; dx <= rad; dx++) {
-                            int clp = qMin((int)width() - 1, qMax(0, col + dx));
-                            for (unsigned int chn = 0; chn < colors(); chn++) {
-                                toBuffer[col * colors() + chn] = qMin(toBuffer[col * colors() + chn], fmBuffer[clp * colors() + chn]);
-                            }
-                        }
-                    }
-                }
+
+        // FORWARD AND BACKWARD MINIMUMS DOWN THE PADDED COLUMNS, ONE WHOLE SCAN LINE AT A TIME
+        for (int p = 0; p < length; p++) {
+            const unsigned char *val = (p >= rad && p < rad + rows) ? constScanLine(p - rad, frm) : ceiling;
+            if (p % span == 0) {
+                memcpy(fwd + (size_t)p * bytes, val, bytes);
+            } else {
+                minAreaFilterMinimum(fwd + (size_t)(p - 1) * bytes, val, fwd + (size_t)p * bytes, bytes, depth());
+            }
+        }
+        for (int p = length - 1; p >= 0; p--) {
+            const unsigned char *val = (p >= rad && p < rad + rows) ? constScanLine(p - rad, frm) : ceiling;
+            if (p % span == span - 1 || p == length - 1) {
+                memcpy(bwd + (size_t)p * bytes, val, bytes);
+            } else {
+                minAreaFilterMinimum(bwd + (size_t)(p + 1) * bytes, val, bwd + (size_t)p * bytes, bytes, depth());
+            }
+        }
+
+        // COMBINE THE TWO HALVES OF EACH COLUMN WINDOW AND THEN FILTER ALONG THE ROWS IN PLACE
+        for (int row = 0; row < rows; row++) {
+            unsigned char *toBuffer = object.scanLine(row, frm);
+            minAreaFilterMinimum(bwd + (size_t)row * bytes, fwd + (size_t)(row + 2 * rad) * bytes, toBuffer, bytes, depth());
+            if (depth() == sizeof(unsigned char)) {
+                minAreaFilterRow<unsigned char>(toBuffer, cols, colors(), rad, 0xff, line, line + cols + 2 * rad);
+            } else if (depth() == sizeof(unsigned short)) {
+                minAreaFilterRow<unsigned short>((unsigned short *)toBuffer, cols, colors(), rad, 0xffff, (unsigned short *)line, (unsigned short *)line + cols + 2 * rad);
+            } else {
+                minAreaFilterRow<float>((float *)toBuffer, cols, colors(), rad, INFINITY, (float *)line, (float *)line + cols + 2 * rad);
             }
         }
     }
+
+    _mm_free(ceiling);
+    _mm_free(fwd);
+    _mm_free(bwd);
+    _mm_free(line);
+
     return (object);
 }
 
@@ -2515,3 +3247,426 @@ QList<LAUMemoryObject> LAUMemoryObject::loadStackedVideo(QString filename, int d
 
     return frameList;
 }
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObjectReader::LAUMemoryObjectReader(QString flnm, bool cacheFlag) : tiff(nullptr), fileString(flnm), currentIndex(0), fileSize(-1), fileTime(-1)
+{
+    if (fileString.isEmpty() || QFile::exists(fileString) == false) {
+        return;
+    }
+
+    // REMEMBER WHICH VERSION OF THE FILE THE DIRECTORY OFFSETS DESCRIBE
+    QFileInfo fileInfo(fileString);
+    fileSize = fileInfo.size();
+    fileTime = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    // OPEN THE INPUT TIFF FILE ONCE AND KEEP IT OPEN UNTIL THE READER IS CLOSED
+    tiff = TIFFOpen(fileString.toLatin1(), "r");
+    if (tiff == nullptr) {
+        return;
+    }
+
+    // USE THE SIDECAR INDEX IF IT IS CURRENT AND AGREES WITH THE FIRST DIRECTORY OF THE FILE
+    if (cacheFlag) {
+        offsets = cachedOffsets(fileString);
+        if (offsets.isEmpty() == false && offsets.first() != static_cast<quint64>(TIFFCurrentDirOffset(tiff))) {
+            offsets.clear();
+        }
+    }
+
+    // OTHERWISE WALK THE DIRECTORY CHAIN ONE TIME RECORDING THE OFFSET OF EACH
+    // DIRECTORY SO THAT WE CAN JUMP DIRECTLY TO ANY FRAME USING TIFFSETSUBDIRECTORY
+    if (offsets.isEmpty()) {
+        do {
+            offsets.append(static_cast<quint64>(TIFFCurrentDirOffset(tiff)));
+        } while (TIFFReadDirectory(tiff));
+
+        if (cacheFlag && saveOffsets(fileString, offsets) == false) {
+            qDebug() << "LAUMemoryObjectReader: unable to write directory index" << indexFilename(fileString);
+        }
+    }
+
+    // LEAVE THE FILE POINTING AT THE FIRST DIRECTORY
+    if (seek(0) == false) {
+        close();
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObjectReader::~LAUMemoryObjectReader()
+{
+    close();
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+QString LAUMemoryObjectReader::indexFilename(QString filename)
+{
+    // KEEP THE INDEX AS A HIDDEN SIDECAR FILE NEXT TO THE TIFF FILE IT DESCRIBES
+    QFileInfo fileInfo(filename);
+    return (fileInfo.absoluteDir().absoluteFilePath(QString(".%1.idx").arg(fileInfo.fileName())));
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+QVector<quint64> LAUMemoryObjectReader::cachedOffsets(QString filename)
+{
+    QFile file(indexFilename(filename));
+    if (file.open(QIODevice::ReadOnly) == false) {
+        return (QVector<quint64>());
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0, version = 0;
+    qint64 fileSize = -1, fileTime = -1;
+    QVector<quint64> offsets;
+    stream >> magic >> version >> fileSize >> fileTime >> offsets;
+
+    // THE INDEX IS STALE IF THE TIFF FILE HAS BEEN REWRITTEN OR APPENDED TO SINCE IT WAS BUILT
+    QFileInfo fileInfo(filename);
+    if (stream.status() != QDataStream::Ok || magic != LAUMEMORYOBJECTINDEXMAGIC || version != LAUMEMORYOBJECTINDEXVERSION) {
+        return (QVector<quint64>());
+    }
+    if (fileSize != fileInfo.size() || fileTime != fileInfo.lastModified().toMSecsSinceEpoch()) {
+        return (QVector<quint64>());
+    }
+    return (offsets);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUMemoryObjectReader::saveOffsets(QString filename, QVector<quint64> offsets)
+{
+    // WRITE TO A TEMPORARY FILE AND RENAME IT SO A READER NEVER SEES A HALF WRITTEN INDEX
+    QSaveFile file(indexFilename(filename));
+    if (offsets.isEmpty() || file.open(QIODevice::WriteOnly) == false) {
+        return (false);
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    QFileInfo fileInfo(filename);
+    stream << (quint32)LAUMEMORYOBJECTINDEXMAGIC << (quint32)LAUMEMORYOBJECTINDEXVERSION;
+    stream << (qint64)fileInfo.size() << (qint64)fileInfo.lastModified().toMSecsSinceEpoch() << offsets;
+
+    return (file.commit());
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUMemoryObjectReader::isCurrent() const
+{
+    // THE OFFSETS ARE ONLY GOOD FOR AS LONG AS NOBODY HAS REWRITTEN OR APPENDED TO THE FILE
+    if (tiff == nullptr) {
+        return (false);
+    }
+    QFileInfo fileInfo(fileString);
+    return (fileInfo.exists() && fileInfo.size() == fileSize && fileInfo.lastModified().toMSecsSinceEpoch() == fileTime);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectReader::close()
+{
+    if (tiff) {
+        TIFFClose(tiff);
+        tiff = nullptr;
+    }
+    offsets.clear();
+    currentIndex = 0;
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUMemoryObjectReader::seek(int index)
+{
+    if (tiff == nullptr || index < 0 || index >= offsets.count()) {
+        return (false);
+    }
+
+    // JUMP STRAIGHT TO THE REQUESTED DIRECTORY; THIS ALSO RESTORES THE MAIN
+    // DIRECTORY CHAIN AFTER LOAD() HAS WANDERED OFF INTO AN EXIF DIRECTORY
+    if (TIFFSetSubDirectory(tiff, offsets.at(index)) == 0) {
+        return (false);
+    }
+    currentIndex = index;
+    return (true);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObject LAUMemoryObjectReader::read(int index)
+{
+    if (seek(index) == false) {
+        return (LAUMemoryObject());
+    }
+
+    // LOAD THE CURRENT DIRECTORY AND ADVANCE TO THE NEXT FRAME
+    LAUMemoryObject object(tiff, -1);
+    currentIndex = index + 1;
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObject LAUMemoryObjectReader::readNext()
+{
+    if (atEnd()) {
+        return (LAUMemoryObject());
+    }
+    return (read(currentIndex));
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUMemoryObjectReader::readInto(LAUMemoryObject &object, int index)
+{
+    if (seek(index) == false) {
+        return (false);
+    }
+
+    // REUSE THE CALLER'S BUFFER IF IT MATCHES THE SIZE OF THE STORED FRAME, WHICH
+    // INCLUDES SENSORS STACKED AS FRAMES WHOSE ROWS ADD UP TO THE IMAGE LENGTH,
+    // OTHERWISE FALL BACK TO ALLOCATING A NEW OBJECT FOR THIS DIRECTORY
+    if (object.isNull() || object.loadInto(tiff, -1) == false) {
+        if (seek(index) == false) {
+            return (false);
+        }
+        object = LAUMemoryObject(tiff, -1);
+    }
+    currentIndex = index + 1;
+    return (object.isValid());
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+QString LAUMemoryObjectReader::tagString(int index, unsigned int tag)
+{
+    // READ AN ASCII TAG SUCH AS TIFFTAG_MAKE WITHOUT DECODING THE IMAGE DATA
+    // AND WITHOUT MOVING THE READ POSITION FOR READNEXT()
+    int previousIndex = currentIndex;
+    QString string;
+    if (seek(index)) {
+        char *buffer = nullptr;
+        if (TIFFGetField(tiff, tag, &buffer) == 1 && buffer != nullptr) {
+            string = QString::fromLatin1(buffer);
+        }
+    }
+    currentIndex = previousIndex;
+    return (string);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+QByteArray LAUMemoryObjectReader::xmlPacket(int index)
+{
+    // READ THE XML PACKET THE SAME WAY LOAD() DOES BUT WITHOUT DECODING THE IMAGE
+    // DATA AND WITHOUT MOVING THE READ POSITION FOR READNEXT()
+    int previousIndex = currentIndex;
+    QByteArray byteArray;
+    if (seek(index)) {
+        uint32_t length = 0;
+        char *buffer = nullptr;
+        if (TIFFGetField(tiff, TIFFTAG_XMLPACKET, &length, &buffer) == 1 && buffer != nullptr) {
+            byteArray = QByteArray(buffer, (int)length);
+            int last = byteArray.lastIndexOf(QByteArray("\n"));
+            if (last > -1) {
+                byteArray = byteArray.left(last + 1);
+            } else {
+                byteArray.clear();
+            }
+        }
+    }
+    currentIndex = previousIndex;
+    return (byteArray);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUMemoryObjectReader::copyDirectory(TIFF *otTiff, int index, QByteArray xml)
+{
+    if (otTiff == nullptr || seek(index) == false) {
+        return (false);
+    }
+
+    // GRAB THE ELAPSED TIME STRING FIRST BECAUSE READING THE EXIF
+    // DIRECTORY MOVES THE INPUT FILE OFF OF THE MAIN DIRECTORY CHAIN
+    QByteArray subSecTime;
+    uint64_t directoryOffset;
+    if (TIFFGetField(tiff, TIFFTAG_EXIFIFD, &directoryOffset)) {
+        char *buffer = nullptr;
+        TIFFReadEXIFDirectory(tiff, directoryOffset);
+        if (TIFFGetField(tiff, EXIFTAG_SUBSECTIME, &buffer) && buffer != nullptr) {
+            subSecTime = QByteArray(buffer);
+        }
+        if (seek(index) == false) {
+            return (false);
+        }
+    }
+
+    // WRITE THE ELAPSED TIME STAMP FIRST SO THE NEW IMAGE DIRECTORY CAN POINT TO IT
+    uint64_t exifOffset = 0;
+    if (subSecTime.length() > 0) {
+        exifOffset = writeSubSecTimeDirectory(otTiff, subSecTime);
+    }
+
+    // COPY THE TAGS WRITTEN BY SAVE(), SETTING COMPRESSION BEFORE PREDICTOR
+    // SINCE THE PREDICTOR TAG ONLY EXISTS ONCE THE CODEC HAS BEEN CHOSEN
+    static const unsigned int shortTags[] = { TIFFTAG_RESOLUTIONUNIT, TIFFTAG_ORIENTATION, TIFFTAG_PLANARCONFIG, TIFFTAG_SAMPLESPERPIXEL, TIFFTAG_BITSPERSAMPLE, TIFFTAG_PHOTOMETRIC, TIFFTAG_SAMPLEFORMAT, TIFFTAG_COMPRESSION, TIFFTAG_PREDICTOR, LAUMEMORYOBJECTTIFFTAG_BITSHIFT };
+    static const unsigned int longTags[] = { TIFFTAG_SUBFILETYPE, TIFFTAG_IMAGEWIDTH, TIFFTAG_IMAGELENGTH, TIFFTAG_ROWSPERSTRIP };
+    static const unsigned int floatTags[] = { TIFFTAG_XRESOLUTION, TIFFTAG_YRESOLUTION, TIFFTAG_XPOSITION, TIFFTAG_YPOSITION };
+    static const unsigned int stringTags[] = { TIFFTAG_DATETIME, TIFFTAG_IMAGEDESCRIPTION };
+
+    for (unsigned int tag : longTags) {
+        uint32_t value;
+        if (TIFFGetField(tiff, tag, &value)) {
+            TIFFSetField(otTiff, tag, value);
+        }
+    }
+    for (unsigned int tag : shortTags) {
+        uint16_t value;
+        if (TIFFGetField(tiff, tag, &value)) {
+            TIFFSetField(otTiff, tag, value);
+        }
+    }
+    for (unsigned int tag : floatTags) {
+        float value;
+        if (TIFFGetField(tiff, tag, &value)) {
+            TIFFSetField(otTiff, tag, value);
+        }
+    }
+    for (unsigned int tag : stringTags) {
+        char *value = nullptr;
+        if (TIFFGetField(tiff, tag, &value) && value != nullptr) {
+            TIFFSetField(otTiff, tag, value);
+        }
+    }
+
+    uint16_t extraCount = 0;
+    uint16_t *extraSamples = nullptr;
+    if (TIFFGetField(tiff, TIFFTAG_EXTRASAMPLES, &extraCount, &extraSamples) && extraCount > 0) {
+        TIFFSetField(otTiff, TIFFTAG_EXTRASAMPLES, extraCount, extraSamples);
+    }
+
+    // WRITE THE CALLER'S XML PACKET IN PLACE OF THE ORIGINAL ONE
+    if (xml.length() > 0) {
+        TIFFSetField(otTiff, TIFFTAG_XMLPACKET, xml.length(), xml.data());
+    }
+
+    // COPY THE COMPRESSED STRIPS BYTE FOR BYTE SO THE PIXELS ARE NEVER DECODED OR RE-ENCODED
+    QByteArray buffer;
+    tstrip_t numStrips = TIFFNumberOfStrips(tiff);
+    for (tstrip_t strip = 0; strip < numStrips; strip++) {
+        tmsize_t length = (tmsize_t)TIFFRawStripSize(tiff, strip);
+        if (length < 0) {
+            return (false);
+        }
+        buffer.resize((int)length);
+        if (TIFFReadRawStrip(tiff, strip, buffer.data(), length) != length) {
+            return (false);
+        }
+        if (TIFFWriteRawStrip(otTiff, strip, buffer.data(), length) != length) {
+            return (false);
+        }
+    }
+
+    // POINT THE IMAGE DIRECTORY AT ITS EXIF DIRECTORY
+    if (exifOffset != 0) {
+        TIFFSetField(otTiff, TIFFTAG_EXIFIFD, exifOffset);
+    }
+
+    // WRITE THE CURRENT DIRECTORY AND PREPARE FOR THE NEW ONE
+    currentIndex = index + 1;
+    return (TIFFWriteDirectory(otTiff) != 0);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMemoryObjectMetaData LAUMemoryObjectReader::metaData(int index)
+{
+    // READ EVERY TAG THAT LOAD() READS, WITH ONE DIRECTORY SEEK, BUT NEVER
+    // TOUCH THE PIXEL STRIPS AND NEVER MOVE THE READ POSITION FOR READNEXT()
+    int previousIndex = currentIndex;
+    LAUMemoryObjectMetaData object;
+    if (seek(index)) {
+        uint32_t uLongVariable;
+        uint16_t uShortVariable;
+        if (TIFFGetField(tiff, TIFFTAG_IMAGEWIDTH, &uLongVariable)) {
+            object.width = uLongVariable;
+        }
+        if (TIFFGetField(tiff, TIFFTAG_IMAGELENGTH, &uLongVariable)) {
+            object.height = uLongVariable;
+        }
+        if (TIFFGetField(tiff, TIFFTAG_SAMPLESPERPIXEL, &uShortVariable)) {
+            object.colors = uShortVariable;
+        }
+        if (TIFFGetField(tiff, TIFFTAG_BITSPERSAMPLE, &uShortVariable)) {
+            object.depth = uShortVariable / 8;
+        }
+
+        // LOAD THE ANCHOR POINT
+        float xPos = -1.0f, yPos = -1.0f;
+        TIFFGetField(tiff, TIFFTAG_XPOSITION, &xPos);
+        TIFFGetField(tiff, TIFFTAG_YPOSITION, &yPos);
+        object.anchor = QPoint(qRound(xPos), qRound(yPos));
+
+        // LOAD THE XML FIELD OF THE TIFF FILE, IF PROVIDED
+        uint32_t dataLength = 0;
+        char *dataString = nullptr;
+        if (TIFFGetField(tiff, TIFFTAG_XMLPACKET, &dataLength, &dataString) && dataString != nullptr) {
+            QByteArray byteArray(dataString, (int)dataLength);
+            int last = byteArray.lastIndexOf(QByteArray("\n"));
+            if (last > -1) {
+                object.xml = byteArray.left(last + 1);
+            }
+
+            // PARSE THE XML LOOKING FOR A JETR VECTOR OF DOUBLES
+            QHash<QString, QString> hashTable = LAUMemoryObject::xmlToHash(object.xml);
+            if (hashTable["jetrVector"].isNull() == false) {
+                QStringList doubleList = hashTable["jetrVector"].split(",");
+                object.jetr = QVector<double>(doubleList.count(), NAN);
+                for (int n = 0; n < doubleList.count(); n++) {
+                    object.jetr[n] = doubleList.at(n).toDouble();
+                }
+            }
+        }
+
+        // LOAD THE RFID STRING FROM THE IMAGE DESCRIPTION TIFFTAG
+        dataString = nullptr;
+        if (TIFFGetField(tiff, TIFFTAG_IMAGEDESCRIPTION, &dataString) && dataString != nullptr) {
+            object.rfid = QString(QByteArray(dataString));
+        }
+
+        // GET THE ELAPSED TIME VALUE FROM THE EXIF TAG FOR SUBSECOND TIME
+        uint64_t directoryOffset;
+        if (TIFFGetField(tiff, TIFFTAG_EXIFIFD, &directoryOffset)) {
+            char *byteArray = nullptr;
+            TIFFReadEXIFDirectory(tiff, directoryOffset);
+            if (TIFFGetField(tiff, EXIFTAG_SUBSECTIME, &byteArray) && byteArray != nullptr) {
+                object.elapsed = QString(QByteArray(byteArray)).toUInt();
+            }
+        }
+    }
+    currentIndex = previousIndex;
+    return (object);
+}
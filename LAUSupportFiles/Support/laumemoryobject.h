@@ -27,9 +27,14 @@
 #include <QImage>
 #include <QMatrix4x4>
 #else
+#include <QPoint>
+#include <QSize>
+#include <QRect>
+
 // Minimal Qt type replacements for headless mode (console applications)
 // These provide just enough interface for laumemoryobject to compile
 // LAUEncodeObjectIDFilter doesn't actually use these methods at runtime
+// QPoint, QSize and QRect come from QtCore because <QtConcurrent> pulls them in
 
 class QMatrix4x4 {
 public:
@@ -40,52 +45,6 @@ private:
     float m[16];
 };
 
-class QPoint {
-public:
-    QPoint() : xp(0), yp(0) {}
-    QPoint(int x, int y) : xp(x), yp(y) {}
-    int x() const { return xp; }
-    int y() const { return yp; }
-    void setX(int x) { xp = x; }
-    void setY(int y) { yp = y; }
-private:
-    int xp, yp;
-};
-
-class QPointF {
-public:
-    QPointF() : xp(0.0), yp(0.0) {}
-    QPointF(double x, double y) : xp(x), yp(y) {}
-    double x() const { return xp; }
-    double y() const { return yp; }
-private:
-    double xp, yp;
-};
-
-class QSize {
-public:
-    QSize() : wd(0), ht(0) {}
-    QSize(int width, int height) : wd(width), ht(height) {}
-    int width() const { return wd; }
-    int height() const { return ht; }
-private:
-    int wd, ht;
-};
-
-class QRect {
-public:
-    QRect() : x1(0), y1(0), x2(0), y2(0) {}
-    QRect(int left, int top, int width, int height) : x1(left), y1(top), x2(left+width-1), y2(top+height-1) {}
-    int left() const { return x1; }
-    int top() const { return y1; }
-    int right() const { return x2; }
-    int bottom() const { return y2; }
-    int width() const { return x2 - x1 + 1; }
-    int height() const { return y2 - y1 + 1; }
-private:
-    int x1, y1, x2, y2;
-};
-
 class QImage {
 public:
     QImage() : w(0), h(0) {}
@@ -98,6 +57,9 @@ private:
 #endif
 
 #include <QThread>
+#include <QVector>
+#include <QStringList>
+#include <QAtomicInteger>
 #include <QSharedData>
 #include <QSharedDataPointer>
 #include <QDateTime>
@@ -117,6 +79,25 @@ namespace libtiff
 #include "sse2neon.h"
 #endif
 
+// THE AVX2 AND AVX-512 KERNELS ARE ONLY BUILT FOR X86-64 AND ARE COMPILED FOR THEIR INSTRUCTION
+// SETS ONE FUNCTION AT A TIME SO THAT THE REST OF THE BINARY STILL RUNS ON SSE4.1 PROCESSORS.
+// GCC WOULD OTHERWISE FUSE MULTIPLIES AND ADDS INTO FMA INSTRUCTIONS, WHICH ROUND DIFFERENTLY
+// THAN THE SSE KERNELS, SO CONTRACTION IS TURNED OFF FOR THESE FUNCTIONS
+#if defined(Q_PROCESSOR_X86_64)
+#define LAUMEMORYOBJECTAVXDISPATCH
+#include "immintrin.h"
+#if defined(_MSC_VER)
+#define LAUMEMORYOBJECTAVX2
+#define LAUMEMORYOBJECTAVX512
+#elif defined(__clang__)
+#define LAUMEMORYOBJECTAVX2   __attribute__((target("avx2")))
+#define LAUMEMORYOBJECTAVX512 __attribute__((target("avx2,avx512f,avx512bw,popcnt")))
+#else
+#define LAUMEMORYOBJECTAVX2   __attribute__((target("avx2"), optimize("fp-contract=off")))
+#define LAUMEMORYOBJECTAVX512 __attribute__((target("avx2,avx512f,avx512bw,popcnt"), optimize("fp-contract=off")))
+#endif
+#endif
+
 namespace LAU3DVideoParameters
 {
     enum LAUVideoPlaybackState  { StateLiveVideo, StateVideoPlayback };
@@ -136,10 +117,104 @@ using namespace LAU3DVideoParameters;
 #define MINNUMBEROFFRAMESAVAILABLE        40
 #define MAXNUMBEROFFRAMESAVAILABLE        100
 #define LAUMEMORYOBJECTINVALIDELAPSEDTIME 0xFFFFFFFF
+#define LAUMEMORYOBJECTROWSPERSTRIP       16
+#define LAUMEMORYOBJECTINDEXMAGIC         0x4C415549
+#define LAUMEMORYOBJECTINDEXVERSION       1
+#define LAUMEMORYOBJECTTIFFTAG_BITSHIFT   65100
 
 void myTIFFWarningHandler(const char *stringA, const char *stringB, va_list args);
 void myTIFFErrorHandler(const char *stringA, const char *stringB, va_list args);
 
+class LAUMemoryObject;
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// RUNTIME CHOICE OF THE WIDEST VECTOR INSTRUCTIONS FOR THE PER-FRAME KERNELS OF LAUMEMORYOBJECT
+// AND LAUSCAN. THE SSE KERNELS, OR THEIR SSE2NEON TRANSLATIONS ON ARM, ARE ALWAYS AVAILABLE WHILE
+// THE AVX2 AND AVX-512 VARIANTS ARE USED WHEN BOTH THE CPU AND THE OPERATING SYSTEM SUPPORT THEM.
+// EVERY LEVEL GIVES BIT-IDENTICAL RESULTS, AND SETLEVEL() CAN FORCE ANY SUPPORTED LEVEL SO THAT
+// THE VARIANTS CAN BE COMPARED AGAINST EACH OTHER AND TIMED
+class LAUMemoryObjectSimd
+{
+public:
+    enum Level { LevelSSE, LevelAVX2, LevelAVX512 };
+
+    static Level supportedLevel();
+    static Level level();
+    static bool setLevel(Level lvl);
+    static QString toString(Level lvl);
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// LOSSLESS TIFF CODEC USED WHEN WRITING MEMORY OBJECTS TO DISK. THE STRING FORM
+// IS "NONE", "LZW", "DEFLATE:LEVEL" OR "ZSTD:LEVEL" WHERE THE LEVEL IS OPTIONAL.
+// CODECS THAT THE LINKED LIBTIFF CANNOT ENCODE FALL BACK TO LZW SO THAT A
+// RECORDING IS ALWAYS WRITTEN, AND EVERY CODEC EXCEPT NONE USES THE HORIZONTAL
+// PREDICTOR JUST LIKE THE ORIGINAL LZW FILES. APPENDING "+PACK" DROPS THE LOW
+// ORDER BITS THAT ARE ZERO IN EVERY SAMPLE OF A 16-BIT FRAME, SUCH AS THE TWO
+// BITS THE ORBBEC CAMERA SHIFTS IN, AND RECORDS THE SHIFT IN A PRIVATE TAG SO
+// THAT LOAD() CAN RESTORE THE ORIGINAL VALUES
+class LAUMemoryObjectCodec
+{
+public:
+    enum Scheme { SchemeNone, SchemeLZW, SchemeDeflate, SchemeZSTD };
+
+    LAUMemoryObjectCodec(Scheme schm = SchemeLZW, int lvl = -1, bool pck = false) : codecScheme(schm), codecLevel(lvl), packFlag(pck) { ; }
+
+    static LAUMemoryObjectCodec fromString(QString string);
+    static QList<LAUMemoryObjectCodec> availableCodecs();
+
+    bool operator == (const LAUMemoryObjectCodec &other) const
+    {
+        return (codecScheme == other.codecScheme && codecLevel == other.codecLevel && packFlag == other.packFlag);
+    }
+
+    Scheme scheme() const
+    {
+        return (codecScheme);
+    }
+
+    int level() const
+    {
+        return (codecLevel);
+    }
+
+    bool pack() const
+    {
+        return (packFlag);
+    }
+
+    bool isSupported() const;
+    unsigned short compression() const;
+    QString toString() const;
+    void apply(libtiff::TIFF *tiff) const;
+
+private:
+    Scheme codecScheme;
+    int codecLevel;
+    bool packFlag;
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// THE PIXELS OF A MEMORY OBJECT LIVE IN THEIR OWN SHARED BLOCK SO THAT CHANGING THE
+// METADATA OF AN IMPLICITLY SHARED OBJECT ONLY COPIES THE METADATA, WHILE THE PIXELS
+// ARE COPIED THE FIRST TIME SOMEONE ASKS FOR A WRITABLE SCAN LINE
+class LAUMemoryObjectBuffer : public QSharedData
+{
+public:
+    LAUMemoryObjectBuffer(unsigned long long bytes);
+    LAUMemoryObjectBuffer(const LAUMemoryObjectBuffer &other);
+    ~LAUMemoryObjectBuffer();
+
+    unsigned long long numBytesTotal;
+    void *buffer;
+};
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -159,6 +234,7 @@ public:
     unsigned int stepBytes, frameBytes;
     unsigned long long numBytesTotal;
     void *buffer;
+    QExplicitlySharedDataPointer<LAUMemoryObjectBuffer> pixels;
 
     QString *rfidString;
     QByteArray *xmlByteArray;
@@ -169,6 +245,15 @@ public:
     unsigned int *elapsedTime;
 
     void allocateBuffer();
+
+    inline void detachBuffer()
+    {
+        // TAKE A PRIVATE COPY OF THE PIXELS IF ANOTHER OBJECT IS STILL LOOKING AT THEM
+        if (pixels && pixels->ref.loadRelaxed() != 1) {
+            pixels.detach();
+            buffer = pixels->buffer;
+        }
+    }
 };
 
 /****************************************************************************/
@@ -207,7 +292,7 @@ public:
     LAUMemoryObject(libtiff::TIFF *inTiff, int index = -1);
 
     bool save(QString filename = QString(), QString *savedFilePath = nullptr) const;
-    bool save(libtiff::TIFF *otTiff, int index = 0) const;
+    bool save(libtiff::TIFF *otTiff, int rowsPerStrip = LAUMEMORYOBJECTROWSPERSTRIP, int threads = 1, LAUMemoryObjectCodec codec = LAUMemoryObjectCodec()) const;
     bool load(libtiff::TIFF *inTiff, int index = -1);
 
     // LOAD INTO READS A FILE INTO THE EXISTING BUFFER BUT ALL
@@ -226,19 +311,21 @@ public:
 
     QImage toImage(int frame = 0) const;
 
-    void flipUpDownInPlace() const;
-    void flipLeftRightInPlace() const;
-    void rotate180InPlace() const;
-    void rotateFrame180InPlace(int frm) const;
+    // THE IN PLACE TRANSFORMS TAKE A PRIVATE COPY OF THE PIXELS FIRST IF THEY ARE SHARED
+    void flipUpDownInPlace();
+    void flipLeftRightInPlace();
+    void rotate180InPlace();
+    void rotateFrame180InPlace(int frm);
     void peakEnvelopeInPlace(float dx, float dy, float radius);
 
-    // SEE IF THE POINTERS ARE LOOKING AT SAME MEMORY
+    // SEE IF BOTH OBJECTS ARE COPIES OF THE SAME HANDLE; TWO OBJECTS THAT SHARE PIXELS
+    // BUT CARRY DIFFERENT METADATA ARE DIFFERENT FRAMES AND DO NOT COMPARE EQUAL
     bool operator == (const LAUMemoryObject &other) const
     {
         if (this == &other) {
             return (true);
         }
-        return (data->buffer == other.data->buffer);
+        return (data == other.data);
     }
 
     bool operator  < (const LAUMemoryObject &other) const
@@ -381,6 +468,11 @@ public:
         Q_UNUSED(data);
     }
 
+    // POINTER(), SCANLINE() AND FRAME() TAKE A PRIVATE COPY OF THE PIXELS BEFORE HANDING
+    // BACK A WRITABLE ADDRESS IF ANY OTHER OBJECT IS LOOKING AT THEM. THE CONST VERSIONS
+    // NEVER COPY, SO WRITING THROUGH THEM CHANGES THE PIXELS OF EVERY OBJECT SHARING THE
+    // BUFFER, INCLUDING COPIES THAT ONLY DETACHED THEIR METADATA. THAT IS HOW CAMERAS FILL
+    // BUFFERS HANDED TO THEM BY THE VIDEO PIPELINE; EVERYWHERE ELSE WRITE THROUGH POINTER()
     inline unsigned char *pointer()
     {
         return (scanLine(0));
@@ -393,6 +485,7 @@ public:
 
     inline unsigned char *scanLine(unsigned int row, unsigned int frame = 0)
     {
+        data->detachBuffer();
         return (&(((unsigned char *)(data->buffer))[frame * block() + row * step()]));
     }
 
@@ -636,10 +729,13 @@ public:
 
     static bool saveObjectsToDisk(QList<LAUMemoryObject> objects, QString filename);
 
-    static QString lastTiffErrorString;
-    static QString lastTiffWarningString;
+    // LIBTIFF REPORTS THROUGH ONE PROCESS WIDE HANDLER WHILE FILES ARE OPENED AND
+    // COMPRESSED ON WORKER THREADS, SO EACH THREAD KEEPS ITS OWN LAST MESSAGE
+    static thread_local QString lastTiffErrorString;
+    static thread_local QString lastTiffWarningString;
 
     static QHash<QString, QString> xmlToHash(QByteArray byteArray);
+    static QByteArray hashToXml(QHash<QString, QString> hashTable);
 
     static int howManyDirectoriesDoesThisTiffFileHave(QString filename);
     static int howManyChannelsDoesThisTiffFileHave(QString filename, int frame = 0);
@@ -658,6 +754,11 @@ public:
 
 protected:
     QSharedDataPointer<LAUMemoryObjectData> data;
+
+private:
+    bool compressStrips(const unsigned char *pixels, int rowsPerStrip, int threads, LAUMemoryObjectCodec codec, QVector<QByteArray> &strips) const;
+    int trailingZeroBits() const;
+    void restoreBitShift(libtiff::TIFF *inTiff);
 };
 
 /****************************************************************************/
@@ -683,6 +784,70 @@ signals:
     void emitFrame(LAUMemoryObject frame);
 };
 
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+class LAUMemoryObjectPool
+{
+public:
+    explicit LAUMemoryObjectPool(unsigned int cols, unsigned int rows, unsigned int chns, unsigned int byts, unsigned int frms = 1, int size = MINNUMBEROFFRAMESAVAILABLE);
+    ~LAUMemoryObjectPool();
+
+    bool isNull() const
+    {
+        return (!isValid());
+    }
+
+    bool isValid() const
+    {
+        return (numCols > 0 && numRows > 0 && numChns > 0 && numByts > 0 && numFrms > 0);
+    }
+
+    int capacity() const
+    {
+        return (cells.count());
+    }
+
+    int available() const
+    {
+        return (qMax(0, (int)(enqueuePosition.loadAcquire() - dequeuePosition.loadAcquire())));
+    }
+
+    int misses() const
+    {
+        return (missCounter.loadAcquire());
+    }
+
+    bool matches(const LAUMemoryObject &object) const
+    {
+        return (object.width() == numCols && object.height() == numRows && object.colors() == numChns && object.depth() == numByts && object.frames() == numFrms);
+    }
+
+    LAUMemoryObject acquire();
+    bool release(LAUMemoryObject object);
+
+private:
+    Q_DISABLE_COPY(LAUMemoryObjectPool)
+
+    // EACH CELL OF THE RING CARRIES A SEQUENCE NUMBER THAT TELLS PRODUCERS AND
+    // CONSUMERS WHETHER THE CELL IS EMPTY OR FULL FOR THEIR LAP AROUND THE RING
+    typedef struct {
+        QAtomicInteger<quint32> sequence;
+        LAUMemoryObject object;
+    } Cell;
+
+    unsigned int numRows, numCols, numChns, numByts, numFrms;
+    quint32 mask;
+    QVector<Cell> cells;
+    Cell *ring;
+    QAtomicInteger<quint32> enqueuePosition;
+    QAtomicInteger<quint32> dequeuePosition;
+    QAtomicInt missCounter;
+
+    bool push(const LAUMemoryObject &object);
+    bool pop(LAUMemoryObject &object);
+};
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -743,6 +908,117 @@ signals:
     void emitSaveComplete();
 };
 
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// EVERYTHING LOAD() PULLS OUT OF A TIFF DIRECTORY EXCEPT THE PIXELS THEMSELVES,
+// WITH THE SAME DEFAULTS AN EMPTY LAUMEMORYOBJECT WOULD REPORT
+class LAUMemoryObjectMetaData
+{
+public:
+    LAUMemoryObjectMetaData() : width(0), height(0), colors(0), depth(0), elapsed(0), anchor(QPoint(-1, -1)), jetr(QVector<double>(37, NAN)) { ; }
+
+    bool isValid() const
+    {
+        return (width > 0 && height > 0 && colors > 0 && depth > 0);
+    }
+
+    bool isNull() const
+    {
+        return (!isValid());
+    }
+
+    unsigned int width;
+    unsigned int height;
+    unsigned int colors;
+    unsigned int depth;
+    unsigned int elapsed;
+    QPoint anchor;
+    QString rfid;
+    QByteArray xml;
+    QVector<double> jetr;
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// OPENS A MULTI-DIRECTORY TIFF VIDEO ONCE AND HANDS BACK FRAMES EITHER IN
+// SEQUENCE OR BY INDEX. THE OFFSET OF EVERY DIRECTORY IS RECORDED WHEN THE
+// FILE IS OPENED SO RANDOM ACCESS JUMPS STRAIGHT TO THE REQUESTED DIRECTORY
+// INSTEAD OF REOPENING THE FILE AND WALKING THE DIRECTORY CHAIN EACH TIME.
+// WITH THE CACHE FLAG SET, THE OFFSETS ARE ALSO KEPT IN A HIDDEN SIDECAR FILE
+// SO THAT REOPENING A LONG RECORDING DOES NOT WALK THE CHAIN AGAIN; THE SIDECAR
+// IS IGNORED AND REBUILT WHENEVER THE TIFF FILE'S SIZE OR MODIFICATION TIME CHANGE.
+// A READER THAT IS KEPT OPEN SHOULD CHECK ISCURRENT() BEFORE EACH READ AND REOPEN
+// THE FILE IF IT HAS BEEN REWRITTEN OR APPENDED TO SINCE THE OFFSETS WERE TAKEN
+class LAUMemoryObjectReader
+{
+public:
+    explicit LAUMemoryObjectReader(QString flnm = QString(), bool cacheFlag = false);
+    ~LAUMemoryObjectReader();
+
+    static QString indexFilename(QString filename);
+    static QVector<quint64> cachedOffsets(QString filename);
+    static bool saveOffsets(QString filename, QVector<quint64> offsets);
+
+    bool isNull() const
+    {
+        return (!isValid());
+    }
+
+    bool isValid() const
+    {
+        return (tiff != nullptr);
+    }
+
+    QString filename() const
+    {
+        return (fileString);
+    }
+
+    int directories() const
+    {
+        return (offsets.count());
+    }
+
+    int index() const
+    {
+        return (currentIndex);
+    }
+
+    bool atEnd() const
+    {
+        return (currentIndex >= offsets.count());
+    }
+
+    void rewind()
+    {
+        currentIndex = 0;
+    }
+
+    bool isCurrent() const;
+    bool seek(int index);
+    void close();
+
+    LAUMemoryObject read(int index);
+    LAUMemoryObject readNext();
+    bool readInto(LAUMemoryObject &object, int index);
+    QString tagString(int index, unsigned int tag);
+    QByteArray xmlPacket(int index);
+    bool copyDirectory(libtiff::TIFF *otTiff, int index, QByteArray xml);
+    LAUMemoryObjectMetaData metaData(int index);
+
+private:
+    libtiff::TIFF *tiff;
+    QString fileString;
+    QVector<quint64> offsets;
+    int currentIndex;
+    qint64 fileSize;
+    qint64 fileTime;
+
+    Q_DISABLE_COPY(LAUMemoryObjectReader)
+};
+
 Q_DECLARE_METATYPE(LAUMemoryObject);
 
 #endif // LAUMEMORYOBJECT_H
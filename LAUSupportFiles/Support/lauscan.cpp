@@ -25,6 +25,7 @@
 #include <QtMath>
 #include <QBuffer>
 #include <QSettings>
+#include <QtConcurrent>
 #include <QDomDocument>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
@@ -57,20 +58,80 @@ LAUScan LAUScan::fromRawDepth(const LAUMemoryObject &object, const LAULookUpTabl
     float zMin = qMin(table.zLimits().x(), table.zLimits().y());
     float zMax = qMax(table.zLimits().x(), table.zLimits().y());
 
-    for (unsigned int row = 0; row < object.height(); row++) {
-        unsigned short *inBuffer = (unsigned short*)(object.constScanLine(row));
-        float *otBuffer = (float*)scan.scanLine(row);
+    // SPLIT THE ROWS OF THE IMAGE ACROSS THE AVAILABLE CPU CORES
+    QList<int> rows;
+    for (int row = 0; row < (int)object.height(); row++) {
+        rows << row;
+    }
 
-        for (unsigned int col = 0; col < object.width(); col++) {
-            float *lutVector = (float*)(table.constScanLine(row)) + (table.colors() * col);
+    QtConcurrent::blockingMap(rows, [&](const int &row) {
+        unsigned short *inBuffer = (unsigned short *)(object.constScanLine(row));
+        float *otBuffer = (float *)scan.constScanLine(row);
+        const float *lutBuffer = (const float *)(table.constScanLine(row));
+        const int lutStep = (int)table.colors();
+
+        __m128i zeroVec = _mm_set1_epi32(0);
+        __m128 scaleVec = _mm_set1_ps(65535.0f);
+        __m128 zMinVec = _mm_set1_ps(zMin);
+        __m128 zMaxVec = _mm_set1_ps(zMax);
+        __m128 nanVec = _mm_set1_ps(NAN);
+
+        // PROCESS FOUR PIXELS AT A TIME, TRANSPOSING THE INTERLEAVED LOOK UP TABLE
+        // COEFFICIENTS INTO ONE VECTOR PER COEFFICIENT
+        unsigned int col = 0;
+        for (; col + 4 <= object.width(); col += 4) {
+            const float *lutA = lutBuffer + lutStep * (col + 0);
+            const float *lutB = lutBuffer + lutStep * (col + 1);
+            const float *lutC = lutBuffer + lutStep * (col + 2);
+            const float *lutD = lutBuffer + lutStep * (col + 3);
+
+            __m128 c0 = _mm_loadu_ps(lutA + 0);
+            __m128 c1 = _mm_loadu_ps(lutB + 0);
+            __m128 c2 = _mm_loadu_ps(lutC + 0);
+            __m128 c3 = _mm_loadu_ps(lutD + 0);
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+            __m128 c4 = _mm_loadu_ps(lutA + 4);
+            __m128 c5 = _mm_loadu_ps(lutB + 4);
+            __m128 c6 = _mm_loadu_ps(lutC + 4);
+            __m128 c7 = _mm_loadu_ps(lutD + 4);
+            _MM_TRANSPOSE4_PS(c4, c5, c6, c7);
+
+            __m128 c8 = _mm_set_ps(lutD[8], lutC[8], lutB[8], lutA[8]);
+
+            // CONVERT THE RAW 16-BIT DEPTH TO THE UNIT INTERVAL
+            __m128i inVec = _mm_loadl_epi64((const __m128i *)(inBuffer + col));
+            __m128 pixel = _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(inVec, zeroVec)), scaleVec);
+
+            // EVALUATE THE 4TH ORDER DEPTH POLYNOMIAL USING HORNER'S SCHEME
+            __m128 z = _mm_add_ps(_mm_mul_ps(c4, pixel), c5);
+            z = _mm_add_ps(_mm_mul_ps(z, pixel), c6);
+            z = _mm_add_ps(_mm_mul_ps(z, pixel), c7);
+            z = _mm_add_ps(_mm_mul_ps(z, pixel), c8);
+
+            // REPLACE ANY DEPTH OUTSIDE THE VALID Z-RANGE WITH NAN
+            __m128 mask = _mm_and_ps(_mm_cmpgt_ps(z, zMinVec), _mm_cmplt_ps(z, zMaxVec));
+            z = _mm_or_ps(_mm_and_ps(mask, z), _mm_andnot_ps(mask, nanVec));
+
+            // CALCULATE SPATIAL COORDINATES AND INTERLEAVE BACK INTO XYZG PIXELS
+            __m128 x = _mm_add_ps(_mm_mul_ps(c0, z), c1);
+            __m128 y = _mm_add_ps(_mm_mul_ps(c2, z), c3);
+            __m128 g = pixel;
+            _MM_TRANSPOSE4_PS(x, y, z, g);
+
+            _mm_storeu_ps(otBuffer + 4 * col + 0, x);
+            _mm_storeu_ps(otBuffer + 4 * col + 4, y);
+            _mm_storeu_ps(otBuffer + 4 * col + 8, z);
+            _mm_storeu_ps(otBuffer + 4 * col + 12, g);
+        }
+
+        // PROCESS ANY LEFT OVER PIXELS AT THE END OF THE ROW
+        for (; col < object.width(); col++) {
+            const float *lutVector = lutBuffer + lutStep * col;
             float pixel = inBuffer[col] / 65535.0f;
 
             // Polynomial depth calculation
-            float z = (lutVector[4] * pow(pixel, 4.0f))
-                      + (lutVector[5] * pow(pixel, 3.0f))
-                      + (lutVector[6] * pow(pixel, 2.0f))
-                      + (lutVector[7] * pixel)
-                      + lutVector[8];
+            float z = (((lutVector[4] * pixel + lutVector[5]) * pixel + lutVector[6]) * pixel + lutVector[7]) * pixel + lutVector[8];
 
             // Validate z-range
             z = (z <= zMin || z >= zMax) ? NAN : z;
@@ -81,7 +142,8 @@ LAUScan LAUScan::fromRawDepth(const LAUMemoryObject &object, const LAULookUpTabl
             otBuffer[4*col + 2] = z;                                 // Z
             otBuffer[4*col + 3] = pixel;                             // Grayscale
         }
-    }
+    });
+
     scan.updateLimits();
     return scan;
 }
@@ -524,7 +586,7 @@ bool LAUScan::saveAsUint8(QString filename)
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-bool LAUScan::save(TIFF *otTiff, int index)
+bool LAUScan::save(TIFF *otTiff)
 {
     // GRAB THE CURRENT XML FIELD IN HASH TABLE FORM
     QHash<QString, QString> hashTable = xmlToHash(xml());
@@ -623,7 +685,7 @@ bool LAUScan::save(TIFF *otTiff, int index)
     TIFFSetField(otTiff, TIFFTAG_MODEL, modelString.toLocal8Bit().data());
     TIFFSetField(otTiff, TIFFTAG_MAKE, makeString.toLocal8Bit().data());
 
-    return (LAUMemoryObject::save(otTiff, index));
+    return (LAUMemoryObject::save(otTiff));
 }
 
 /****************************************************************************/
@@ -945,6 +1007,131 @@ QVector<float> LAUScan::pixel(int col, int row) const
     return (pix);
 }
 
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static void scanLimitsSSE(const float *buffer, unsigned int first, unsigned int pixels, unsigned int stride, __m128 *minVec, __m128 *maxVec, __m128 *menVec, int *pixelCount)
+{
+    // KEEP A SEPARATE MINIMUM, MAXIMUM, AND SUM FOR EACH OF THE FOUR PIXEL PHASES SO THE
+    // WIDER KERNELS, WHICH HANDLE TWO OR FOUR PIXELS PER VECTOR, ADD IN THE SAME ORDER
+    for (unsigned int pxl = first; pxl < pixels; pxl++) {
+        __m128 pixVec = _mm_loadu_ps(buffer + (unsigned long long)pxl * stride);
+        __m128 mskVec = _mm_cmpeq_ps(pixVec, pixVec);
+        if (_mm_test_all_ones(_mm_castps_si128(mskVec))) {
+            (*pixelCount)++;
+            minVec[pxl % 4] = _mm_min_ps(minVec[pxl % 4], pixVec);
+            maxVec[pxl % 4] = _mm_max_ps(maxVec[pxl % 4], pixVec);
+            menVec[pxl % 4] = _mm_add_ps(menVec[pxl % 4], pixVec);
+        }
+    }
+}
+
+#ifdef LAUMEMORYOBJECTAVXDISPATCH
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMEMORYOBJECTAVX2 static unsigned int scanLimitsAVX2(const float *buffer, unsigned int pixels, unsigned int stride, __m128 *minVec, __m128 *maxVec, __m128 *menVec, int *pixelCount)
+{
+    // PIXELS 0 AND 1 OF EVERY GROUP OF FOUR GO INTO THE A VECTORS AND PIXELS 2 AND 3 INTO THE B VECTORS
+    __m256 minVecA = _mm256_insertf128_ps(_mm256_castps128_ps256(minVec[0]), minVec[1], 1);
+    __m256 minVecB = _mm256_insertf128_ps(_mm256_castps128_ps256(minVec[2]), minVec[3], 1);
+    __m256 maxVecA = _mm256_insertf128_ps(_mm256_castps128_ps256(maxVec[0]), maxVec[1], 1);
+    __m256 maxVecB = _mm256_insertf128_ps(_mm256_castps128_ps256(maxVec[2]), maxVec[3], 1);
+    __m256 menVecA = _mm256_insertf128_ps(_mm256_castps128_ps256(menVec[0]), menVec[1], 1);
+    __m256 menVecB = _mm256_insertf128_ps(_mm256_castps128_ps256(menVec[2]), menVec[3], 1);
+
+    unsigned int pxl = 0;
+    for (; pxl + 4 <= pixels; pxl += 4) {
+        const float *pixel = buffer + (unsigned long long)pxl * stride;
+        __m256 pixVecA = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(pixel)), _mm_loadu_ps(pixel + stride), 1);
+        __m256 pixVecB = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(pixel + 2 * stride)), _mm_loadu_ps(pixel + 3 * stride), 1);
+
+        // A PIXEL ONLY COUNTS IF ALL FOUR OF ITS LANES ARE NUMBERS, SO AND THE LANES OF EACH HALF TOGETHER
+        __m256 mskVecA = _mm256_cmp_ps(pixVecA, pixVecA, _CMP_EQ_OQ);
+        __m256 mskVecB = _mm256_cmp_ps(pixVecB, pixVecB, _CMP_EQ_OQ);
+        mskVecA = _mm256_and_ps(mskVecA, _mm256_permute_ps(mskVecA, _MM_SHUFFLE(2, 3, 0, 1)));
+        mskVecB = _mm256_and_ps(mskVecB, _mm256_permute_ps(mskVecB, _MM_SHUFFLE(2, 3, 0, 1)));
+        mskVecA = _mm256_and_ps(mskVecA, _mm256_permute_ps(mskVecA, _MM_SHUFFLE(1, 0, 3, 2)));
+        mskVecB = _mm256_and_ps(mskVecB, _mm256_permute_ps(mskVecB, _MM_SHUFFLE(1, 0, 3, 2)));
+
+        int bitsA = _mm256_movemask_ps(mskVecA);
+        int bitsB = _mm256_movemask_ps(mskVecB);
+        *pixelCount += (bitsA & 1) + ((bitsA >> 4) & 1) + (bitsB & 1) + ((bitsB >> 4) & 1);
+
+        minVecA = _mm256_blendv_ps(minVecA, _mm256_min_ps(minVecA, pixVecA), mskVecA);
+        minVecB = _mm256_blendv_ps(minVecB, _mm256_min_ps(minVecB, pixVecB), mskVecB);
+        maxVecA = _mm256_blendv_ps(maxVecA, _mm256_max_ps(maxVecA, pixVecA), mskVecA);
+        maxVecB = _mm256_blendv_ps(maxVecB, _mm256_max_ps(maxVecB, pixVecB), mskVecB);
+        menVecA = _mm256_blendv_ps(menVecA, _mm256_add_ps(menVecA, pixVecA), mskVecA);
+        menVecB = _mm256_blendv_ps(menVecB, _mm256_add_ps(menVecB, pixVecB), mskVecB);
+    }
+
+    minVec[0] = _mm256_castps256_ps128(minVecA);
+    minVec[1] = _mm256_extractf128_ps(minVecA, 1);
+    minVec[2] = _mm256_castps256_ps128(minVecB);
+    minVec[3] = _mm256_extractf128_ps(minVecB, 1);
+    maxVec[0] = _mm256_castps256_ps128(maxVecA);
+    maxVec[1] = _mm256_extractf128_ps(maxVecA, 1);
+    maxVec[2] = _mm256_castps256_ps128(maxVecB);
+    maxVec[3] = _mm256_extractf128_ps(maxVecB, 1);
+    menVec[0] = _mm256_castps256_ps128(menVecA);
+    menVec[1] = _mm256_extractf128_ps(menVecA, 1);
+    menVec[2] = _mm256_castps256_ps128(menVecB);
+    menVec[3] = _mm256_extractf128_ps(menVecB, 1);
+
+    return (pxl);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMEMORYOBJECTAVX512 static unsigned int scanLimitsAVX512(const float *buffer, unsigned int pixels, unsigned int stride, __m128 *minVec, __m128 *maxVec, __m128 *menVec, int *pixelCount)
+{
+    // ALL FOUR PIXEL PHASES SHARE ONE VECTOR, ONE PIXEL PER 128-BIT LANE
+    __m512 minVecA = _mm512_insertf32x4(_mm512_insertf32x4(_mm512_insertf32x4(_mm512_castps128_ps512(minVec[0]), minVec[1], 1), minVec[2], 2), minVec[3], 3);
+    __m512 maxVecA = _mm512_insertf32x4(_mm512_insertf32x4(_mm512_insertf32x4(_mm512_castps128_ps512(maxVec[0]), maxVec[1], 1), maxVec[2], 2), maxVec[3], 3);
+    __m512 menVecA = _mm512_insertf32x4(_mm512_insertf32x4(_mm512_insertf32x4(_mm512_castps128_ps512(menVec[0]), menVec[1], 1), menVec[2], 2), menVec[3], 3);
+
+    unsigned int pxl = 0;
+    for (; pxl + 4 <= pixels; pxl += 4) {
+        const float *pixel = buffer + (unsigned long long)pxl * stride;
+        __m512 pixVec = _mm512_castps128_ps512(_mm_loadu_ps(pixel));
+        pixVec = _mm512_insertf32x4(pixVec, _mm_loadu_ps(pixel + stride), 1);
+        pixVec = _mm512_insertf32x4(pixVec, _mm_loadu_ps(pixel + 2 * stride), 2);
+        pixVec = _mm512_insertf32x4(pixVec, _mm_loadu_ps(pixel + 3 * stride), 3);
+
+        // KEEP ONLY THE PIXELS WHOSE FOUR LANES ARE ALL NUMBERS
+        unsigned int bits = (unsigned int)_mm512_cmp_ps_mask(pixVec, pixVec, _CMP_EQ_OQ);
+        unsigned int mask = 0;
+        for (int lane = 0; lane < 4; lane++) {
+            if (((bits >> (4 * lane)) & 0xF) == 0xF) {
+                mask |= 0xF << (4 * lane);
+                (*pixelCount)++;
+            }
+        }
+
+        minVecA = _mm512_mask_min_ps(minVecA, (__mmask16)mask, minVecA, pixVec);
+        maxVecA = _mm512_mask_max_ps(maxVecA, (__mmask16)mask, maxVecA, pixVec);
+        menVecA = _mm512_mask_add_ps(menVecA, (__mmask16)mask, menVecA, pixVec);
+    }
+
+    minVec[0] = _mm512_extractf32x4_ps(minVecA, 0);
+    minVec[1] = _mm512_extractf32x4_ps(minVecA, 1);
+    minVec[2] = _mm512_extractf32x4_ps(minVecA, 2);
+    minVec[3] = _mm512_extractf32x4_ps(minVecA, 3);
+    maxVec[0] = _mm512_extractf32x4_ps(maxVecA, 0);
+    maxVec[1] = _mm512_extractf32x4_ps(maxVecA, 1);
+    maxVec[2] = _mm512_extractf32x4_ps(maxVecA, 2);
+    maxVec[3] = _mm512_extractf32x4_ps(maxVecA, 3);
+    menVec[0] = _mm512_extractf32x4_ps(menVecA, 0);
+    menVec[1] = _mm512_extractf32x4_ps(menVecA, 1);
+    menVec[2] = _mm512_extractf32x4_ps(menVecA, 2);
+    menVec[3] = _mm512_extractf32x4_ps(menVecA, 3);
+
+    return (pxl);
+}
+#endif
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -954,42 +1141,31 @@ void LAUScan::updateLimits()
         return;
     }
 
-    __m128 minVec = _mm_set1_ps(1e9f);
-    __m128 maxVec = _mm_set1_ps(-1e9f);
-    __m128 menVec = _mm_set1_ps(0.0f);
+    __m128 minVecs[4], maxVecs[4], menVecs[4];
+    for (int n = 0; n < 4; n++) {
+        minVecs[n] = _mm_set1_ps(1e9f);
+        maxVecs[n] = _mm_set1_ps(-1e9f);
+        menVecs[n] = _mm_set1_ps(0.0f);
+    }
 
-    int index = 0;
+    // LET THE WIDEST AVAILABLE KERNEL TAKE AS MANY PIXELS AS IT CAN AND FINISH THE REST WITH SSE
     int pixelCount = 0;
+    unsigned int pixel = 0;
+    unsigned int pixels = width() * height();
     float *buffer = (float *)constScanLine(0);
-    if (colors() % 4 == 0) {
-        for (unsigned int row = 0; row < height(); row++) {
-            for (unsigned int col = 0; col < width(); col++) {
-                __m128 pixVec = _mm_load_ps(buffer + index);
-                __m128 mskVec = _mm_cmpeq_ps(pixVec, pixVec);
-                if (_mm_test_all_ones(_mm_castps_si128(mskVec))) {
-                    pixelCount++;
-                    minVec = _mm_min_ps(minVec, pixVec);
-                    maxVec = _mm_max_ps(maxVec, pixVec);
-                    menVec = _mm_add_ps(menVec, pixVec);
-                }
-                index += colors();
-            }
-        }
-    } else {
-        for (unsigned int row = 0; row < height(); row++) {
-            for (unsigned int col = 0; col < width(); col++) {
-                __m128 pixVec = _mm_loadu_ps(buffer + index);
-                __m128 mskVec = _mm_cmpeq_ps(pixVec, pixVec);
-                if (_mm_test_all_ones(_mm_castps_si128(mskVec))) {
-                    pixelCount++;
-                    minVec = _mm_min_ps(minVec, pixVec);
-                    maxVec = _mm_max_ps(maxVec, pixVec);
-                    menVec = _mm_add_ps(menVec, pixVec);
-                }
-                index += colors();
-            }
-        }
+#ifdef LAUMEMORYOBJECTAVXDISPATCH
+    if (LAUMemoryObjectSimd::level() == LAUMemoryObjectSimd::LevelAVX512) {
+        pixel = scanLimitsAVX512(buffer, pixels, colors(), minVecs, maxVecs, menVecs, &pixelCount);
+    } else if (LAUMemoryObjectSimd::level() == LAUMemoryObjectSimd::LevelAVX2) {
+        pixel = scanLimitsAVX2(buffer, pixels, colors(), minVecs, maxVecs, menVecs, &pixelCount);
     }
+#endif
+    scanLimitsSSE(buffer, pixel, pixels, colors(), minVecs, maxVecs, menVecs, &pixelCount);
+
+    // COMBINE THE FOUR PIXEL PHASES
+    __m128 minVec = _mm_min_ps(_mm_min_ps(minVecs[0], minVecs[1]), _mm_min_ps(minVecs[2], minVecs[3]));
+    __m128 maxVec = _mm_max_ps(_mm_max_ps(maxVecs[0], maxVecs[1]), _mm_max_ps(maxVecs[2], maxVecs[3]));
+    __m128 menVec = _mm_add_ps(_mm_add_ps(menVecs[0], menVecs[1]), _mm_add_ps(menVecs[2], menVecs[3]));
 
     *(int *)&xMin = _mm_extract_ps(minVec, 0);
     *(int *)&xMax = _mm_extract_ps(maxVec, 0);
@@ -1073,6 +1249,58 @@ QList<QImage> LAUScan::nearestNeighborMap()
 }
 #endif
 
+#ifdef LAUMEMORYOBJECTAVXDISPATCH
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMEMORYOBJECTAVX2 static unsigned long long accumulateScanAVX2(float *target, const float *source, unsigned long long bytes)
+{
+    unsigned long long i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        _mm256_storeu_ps(target + i / sizeof(float), _mm256_add_ps(_mm256_loadu_ps(target + i / sizeof(float)), _mm256_loadu_ps(source + i / sizeof(float))));
+    }
+    return (i);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMEMORYOBJECTAVX512 static unsigned long long accumulateScanAVX512(float *target, const float *source, unsigned long long bytes)
+{
+    unsigned long long i = 0;
+    for (; i + 64 <= bytes; i += 64) {
+        _mm512_storeu_ps(target + i / sizeof(float), _mm512_add_ps(_mm512_loadu_ps(target + i / sizeof(float)), _mm512_loadu_ps(source + i / sizeof(float))));
+    }
+    return (i);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMEMORYOBJECTAVX2 static unsigned long long scaleScanAVX2(float *target, float scale, unsigned long long bytes)
+{
+    unsigned long long i = 0;
+    __m256 otVector = _mm256_set1_ps(scale);
+    for (; i + 32 <= bytes; i += 32) {
+        _mm256_storeu_ps(target + i / sizeof(float), _mm256_mul_ps(_mm256_loadu_ps(target + i / sizeof(float)), otVector));
+    }
+    return (i);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMEMORYOBJECTAVX512 static unsigned long long scaleScanAVX512(float *target, float scale, unsigned long long bytes)
+{
+    unsigned long long i = 0;
+    __m512 otVector = _mm512_set1_ps(scale);
+    for (; i + 64 <= bytes; i += 64) {
+        _mm512_storeu_ps(target + i / sizeof(float), _mm512_mul_ps(_mm512_loadu_ps(target + i / sizeof(float)), otVector));
+    }
+    return (i);
+}
+#endif
+
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -1100,8 +1328,17 @@ LAUScan LAUScan::mergeScans(QList<LAUScan> scans)
         if (scnp.width() != scan.width() || scnp.height() != scan.height()) {
             scnp = scnp.resize(scan.width(), scan.height());
         }
-        // ADD NEW SCAN'S BUFFER TO EXIST BUFFER
-        for (unsigned int i = 0; i < scan.length(); i += 16) {
+        // ADD NEW SCAN'S BUFFER TO EXIST BUFFER, LETTING THE WIDEST AVAILABLE
+        // KERNEL TAKE AS MUCH OF IT AS IT CAN BEFORE FINISHING WITH SSE
+        unsigned long long i = 0;
+#ifdef LAUMEMORYOBJECTAVXDISPATCH
+        if (LAUMemoryObjectSimd::level() == LAUMemoryObjectSimd::LevelAVX512) {
+            i = accumulateScanAVX512((float *)scan.constPointer(), (const float *)scnp.constPointer(), scan.length());
+        } else if (LAUMemoryObjectSimd::level() == LAUMemoryObjectSimd::LevelAVX2) {
+            i = accumulateScanAVX2((float *)scan.constPointer(), (const float *)scnp.constPointer(), scan.length());
+        }
+#endif
+        for (; i < scan.length(); i += 16) {
             // LOAD THE NEXT 16 BYTES OF DATA FROM THE TWO BUFFERS
             __m128 inVector = _mm_load_ps((float *)(scan.constPointer() + i));
             __m128 otVector = _mm_load_ps((float *)(scnp.constPointer() + i));
@@ -1113,7 +1350,15 @@ LAUScan LAUScan::mergeScans(QList<LAUScan> scans)
 
     // NOW WE NEED TO DIVIDE THE BUFFER BY THE NUMBER OF IMAGES
     __m128 otVector = _mm_set1_ps(1.0f / (float)N);
-    for (unsigned int i = 0; i < scan.length(); i += 16) {
+    unsigned long long i = 0;
+#ifdef LAUMEMORYOBJECTAVXDISPATCH
+    if (LAUMemoryObjectSimd::level() == LAUMemoryObjectSimd::LevelAVX512) {
+        i = scaleScanAVX512((float *)scan.constPointer(), 1.0f / (float)N, scan.length());
+    } else if (LAUMemoryObjectSimd::level() == LAUMemoryObjectSimd::LevelAVX2) {
+        i = scaleScanAVX2((float *)scan.constPointer(), 1.0f / (float)N, scan.length());
+    }
+#endif
+    for (; i < scan.length(); i += 16) {
         // LOAD THE NEXT 16 BYTES OF DATA FROM THE TWO BUFFERS
         __m128 inVector = _mm_load_ps((float *)(scan.constPointer() + i));
 
@@ -1984,80 +2229,191 @@ LAUScan LAUScan::convertToColor(LAUVideoPlaybackColor clr) const
 /****************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
-void LAUScan::transformScanInPlace(QMatrix4x4 mat)
+static void transformPixelsSSE(float *buffer, unsigned int first, unsigned int pixels, unsigned int stride, const float *matrix, LAUVideoPlaybackColor color)
 {
-    if (playbackColor == ColorGray || playbackColor == ColorRGB || playbackColor == ColorRGBA) {
-        return;
+    // EACH PIXEL STARTS WITH ITS XYZ COORDINATE FOLLOWED BY EITHER W (XYZWRGBA), THE TEXTURE
+    // VALUE (XYZG), OR THE RED CHANNEL (XYZRGB), AND THE MATRIX IS STORED COLUMN BY COLUMN
+    __m128 colVec0 = _mm_loadu_ps(matrix + 0);
+    __m128 colVec1 = _mm_loadu_ps(matrix + 4);
+    __m128 colVec2 = _mm_loadu_ps(matrix + 8);
+    __m128 colVec3 = _mm_loadu_ps(matrix + 12);
+    __m128 mskVec = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    __m128 oneVec = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+    for (unsigned int pxl = first; pxl < pixels; pxl++) {
+        float *pixel = buffer + (unsigned long long)pxl * stride;
+        __m128 inVecR = _mm_loadu_ps(pixel);
+
+        // XYZRGB PIXELS HAVE NO W COORDINATE SO WE SUPPLY A ONE
+        __m128 inVecA = (color == ColorXYZRGB) ? _mm_add_ps(oneVec, _mm_and_ps(inVecR, mskVec)) : inVecR;
+        __m128 inVecB = _mm_mul_ps(colVec0, _mm_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(0, 0, 0, 0))); // MULTIPLY X COORDINATE BY FIRST COLUMN VECTOR OF OUR MATRIX
+        __m128 inVecC = _mm_mul_ps(colVec1, _mm_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(1, 1, 1, 1))); // MULTIPLY Y COORDINATE BY SECOND COLUMN VECTOR OF OUR MATRIX
+        __m128 inVecD = _mm_mul_ps(colVec2, _mm_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(2, 2, 2, 2))); // MULTIPLY Z COORDINATE BY THIRD COLUMN VECTOR OF OUR MATRIX
+
+        // NOW MULTIPLY WITH THE ROWS OF THE TRANFORM MATRIX
+        inVecB = _mm_add_ps(_mm_add_ps(inVecB, inVecC), _mm_add_ps(inVecD, colVec3));
+
+        // SWAP BACK IN T OR RED IN PLACE OF W
+        if (color != ColorXYZWRGBA) {
+            inVecB = _mm_insert_ps(inVecB, inVecR, 0xF0);
+        }
+
+        // STORE RESULTING COORDINATE BACK INTO THE SCAN, LEAVING THE COLOR CHANNELS UNTOUCHED
+        _mm_storeu_ps(pixel, inVecB);
     }
+}
 
-    __m128 colVec0 = _mm_set_ps(mat(3, 0), mat(2, 0), mat(1, 0), mat(0, 0));
-    __m128 colVec1 = _mm_set_ps(mat(3, 1), mat(2, 1), mat(1, 1), mat(0, 1));
-    __m128 colVec2 = _mm_set_ps(mat(3, 2), mat(2, 2), mat(1, 2), mat(0, 2));
-    __m128 colVec3 = _mm_set_ps(mat(3, 3), mat(2, 3), mat(1, 3), mat(0, 3));
-    if (playbackColor == ColorXYZG) {
-        for (unsigned int row = 0; row < this->height(); row++) {
-            float *toBuffer = (float *)this->scanLine(row);
-            float *inBuffer = (float *)constScanLine(row);
-            for (unsigned int col = 0; col < this->width(); col++) {
-                __m128 inVecA = _mm_load_ps(&inBuffer[4 * col]);
-                __m128 inVecB = _mm_mul_ps(colVec0, _mm_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(0, 0, 0, 0))); // MULTIPLY X COORDINATE BY FIRST COLUMN VECTOR OF OUR MATRIX
-                __m128 inVecC = _mm_mul_ps(colVec1, _mm_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(1, 1, 1, 1))); // MULTIPLY Y COORDINATE BY SECOND COLUMN VECTOR OF OUR MATRIX
-                __m128 inVecD = _mm_mul_ps(colVec2, _mm_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(2, 2, 2, 2))); // MULTIPLY Z COORDINATE BY THIRD COLUMN VECTOR OF OUR MATRIX
-
-                // NOW MULTIPLY WITH THE ROWS OF THE TRANFORM MATRIX
-                inVecB = _mm_add_ps(_mm_add_ps(inVecB, inVecC), _mm_add_ps(inVecD, colVec3));
+#ifdef LAUMEMORYOBJECTAVXDISPATCH
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMEMORYOBJECTAVX2 static unsigned int transformPixelsAVX2(float *buffer, unsigned int pixels, unsigned int stride, const float *matrix, LAUVideoPlaybackColor color)
+{
+    // SAME ARITHMETIC AS THE SSE KERNEL BUT TWO PIXELS AT A TIME, ONE PER 128-BIT LANE
+    __m256 colVec0 = _mm256_broadcast_ps((const __m128 *)(matrix + 0));
+    __m256 colVec1 = _mm256_broadcast_ps((const __m128 *)(matrix + 4));
+    __m256 colVec2 = _mm256_broadcast_ps((const __m128 *)(matrix + 8));
+    __m256 colVec3 = _mm256_broadcast_ps((const __m128 *)(matrix + 12));
+    __m256 mskVec = _mm256_castsi256_ps(_mm256_set_epi32(0, -1, -1, -1, 0, -1, -1, -1));
+    __m256 oneVec = _mm256_set_ps(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f);
+
+    unsigned int pxl = 0;
+    for (; pxl + 2 <= pixels; pxl += 2) {
+        float *pixel = buffer + (unsigned long long)pxl * stride;
+        __m256 inVecR;
+        if (stride == 4) {
+            inVecR = _mm256_loadu_ps(pixel);
+        } else {
+            inVecR = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(pixel)), _mm_loadu_ps(pixel + stride), 1);
+        }
 
-                // SWAP BACK IN T IN PLACE OF W
-                inVecB = _mm_insert_ps(inVecB, inVecA, 0xF0);
+        __m256 inVecA = (color == ColorXYZRGB) ? _mm256_add_ps(oneVec, _mm256_and_ps(inVecR, mskVec)) : inVecR;
+        __m256 inVecB = _mm256_mul_ps(colVec0, _mm256_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(0, 0, 0, 0)));
+        __m256 inVecC = _mm256_mul_ps(colVec1, _mm256_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(1, 1, 1, 1)));
+        __m256 inVecD = _mm256_mul_ps(colVec2, _mm256_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(2, 2, 2, 2)));
+        inVecB = _mm256_add_ps(_mm256_add_ps(inVecB, inVecC), _mm256_add_ps(inVecD, colVec3));
+        if (color != ColorXYZWRGBA) {
+            inVecB = _mm256_blend_ps(inVecB, inVecR, 0x88);
+        }
 
-                // STORE RESULTING COORDINATE INTO OUTPUT SCAN
-                _mm_store_ps(&toBuffer[4 * col], inVecB);
-            }
+        if (stride == 4) {
+            _mm256_storeu_ps(pixel, inVecB);
+        } else {
+            _mm_storeu_ps(pixel, _mm256_castps256_ps128(inVecB));
+            _mm_storeu_ps(pixel + stride, _mm256_extractf128_ps(inVecB, 1));
         }
-    } else if (playbackColor == ColorXYZWRGBA) {
-        for (unsigned int row = 0; row < this->height(); row++) {
-            float *toBuffer = (float *)this->scanLine(row);
-            float *inBuffer = (float *)constScanLine(row);
-            for (unsigned int col = 0; col < this->width(); col++) {
-                __m128 inVecA = _mm_load_ps(&inBuffer[8 * col]);
-                __m128 inVecB = _mm_mul_ps(colVec0, _mm_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(0, 0, 0, 0))); // MULTIPLY X COORDINATE BY FIRST COLUMN VECTOR OF OUR MATRIX
-                __m128 inVecC = _mm_mul_ps(colVec1, _mm_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(1, 1, 1, 1))); // MULTIPLY Y COORDINATE BY SECOND COLUMN VECTOR OF OUR MATRIX
-                __m128 inVecD = _mm_mul_ps(colVec2, _mm_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(2, 2, 2, 2))); // MULTIPLY Z COORDINATE BY THIRD COLUMN VECTOR OF OUR MATRIX
+    }
+    return (pxl);
+}
 
-                // NOW MULTIPLY WITH THE ROWS OF THE TRANFORM MATRIX
-                inVecB = _mm_add_ps(_mm_add_ps(inVecB, inVecC), _mm_add_ps(inVecD, colVec3));
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+LAUMEMORYOBJECTAVX512 static unsigned int transformPixelsAVX512(float *buffer, unsigned int pixels, unsigned int stride, const float *matrix, LAUVideoPlaybackColor color)
+{
+    // SAME ARITHMETIC AS THE SSE KERNEL BUT FOUR PIXELS AT A TIME, ONE PER 128-BIT LANE
+    __m512 colVec0 = _mm512_broadcast_f32x4(_mm_loadu_ps(matrix + 0));
+    __m512 colVec1 = _mm512_broadcast_f32x4(_mm_loadu_ps(matrix + 4));
+    __m512 colVec2 = _mm512_broadcast_f32x4(_mm_loadu_ps(matrix + 8));
+    __m512 colVec3 = _mm512_broadcast_f32x4(_mm_loadu_ps(matrix + 12));
+    __m512 mskVec = _mm512_castsi512_ps(_mm512_broadcast_i32x4(_mm_set_epi32(0, -1, -1, -1)));
+    __m512 oneVec = _mm512_broadcast_f32x4(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+
+    unsigned int pxl = 0;
+    for (; pxl + 4 <= pixels; pxl += 4) {
+        float *pixel = buffer + (unsigned long long)pxl * stride;
+        __m512 inVecR;
+        if (stride == 4) {
+            inVecR = _mm512_loadu_ps(pixel);
+        } else {
+            inVecR = _mm512_castps128_ps512(_mm_loadu_ps(pixel));
+            inVecR = _mm512_insertf32x4(inVecR, _mm_loadu_ps(pixel + stride), 1);
+            inVecR = _mm512_insertf32x4(inVecR, _mm_loadu_ps(pixel + 2 * stride), 2);
+            inVecR = _mm512_insertf32x4(inVecR, _mm_loadu_ps(pixel + 3 * stride), 3);
+        }
 
-                // STORE RESULTING COORDINATE INTO OUTPUT SCAN
-                _mm_store_ps(&toBuffer[8 * col], inVecB);
+        __m512 inVecA = (color == ColorXYZRGB) ? _mm512_add_ps(oneVec, _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(inVecR), _mm512_castps_si512(mskVec)))) : inVecR;
+        __m512 inVecB = _mm512_mul_ps(colVec0, _mm512_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(0, 0, 0, 0)));
+        __m512 inVecC = _mm512_mul_ps(colVec1, _mm512_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(1, 1, 1, 1)));
+        __m512 inVecD = _mm512_mul_ps(colVec2, _mm512_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(2, 2, 2, 2)));
+        inVecB = _mm512_add_ps(_mm512_add_ps(inVecB, inVecC), _mm512_add_ps(inVecD, colVec3));
+        if (color != ColorXYZWRGBA) {
+            inVecB = _mm512_mask_blend_ps((__mmask16)0x8888, inVecB, inVecR);
+        }
 
-                // COPY THE RGBA VECTOR
-                _mm_store_ps(&toBuffer[8 * col + 4], _mm_load_ps(&inBuffer[8 * col + 4]));
-            }
+        if (stride == 4) {
+            _mm512_storeu_ps(pixel, inVecB);
+        } else {
+            _mm_storeu_ps(pixel, _mm512_extractf32x4_ps(inVecB, 0));
+            _mm_storeu_ps(pixel + stride, _mm512_extractf32x4_ps(inVecB, 1));
+            _mm_storeu_ps(pixel + 2 * stride, _mm512_extractf32x4_ps(inVecB, 2));
+            _mm_storeu_ps(pixel + 3 * stride, _mm512_extractf32x4_ps(inVecB, 3));
         }
-    } else if (playbackColor == ColorXYZRGB) {
-        __m128 mskVec = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
-        __m128 oneVec = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
-        for (unsigned int row = 0; row < this->height(); row++) {
-            float *toBuffer = (float *)this->scanLine(row);
-            float *inBuffer = (float *)constScanLine(row);
-            for (unsigned int col = 0; col < this->width(); col++) {
-                __m128 inVecA = _mm_add_ps(oneVec, _mm_and_ps(_mm_loadu_ps(&inBuffer[6 * col]), mskVec));
-                __m128 inVecB = _mm_mul_ps(colVec0, _mm_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(0, 0, 0, 0))); // MULTIPLY X COORDINATE BY FIRST COLUMN VECTOR OF OUR MATRIX
-                __m128 inVecC = _mm_mul_ps(colVec1, _mm_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(1, 1, 1, 1))); // MULTIPLY Y COORDINATE BY SECOND COLUMN VECTOR OF OUR MATRIX
-                __m128 inVecD = _mm_mul_ps(colVec2, _mm_shuffle_ps(inVecA, inVecA, _MM_SHUFFLE(2, 2, 2, 2))); // MULTIPLY Z COORDINATE BY THIRD COLUMN VECTOR OF OUR MATRIX
+    }
+    return (pxl);
+}
+#endif
 
-                // NOW MULTIPLY WITH THE ROWS OF THE TRANFORM MATRIX
-                inVecB = _mm_add_ps(_mm_add_ps(inVecB, inVecC), _mm_add_ps(inVecD, colVec3));
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static void transformPixels(float *buffer, unsigned int pixels, unsigned int stride, const float *matrix, LAUVideoPlaybackColor color)
+{
+    // LET THE WIDEST AVAILABLE KERNEL TAKE AS MANY PIXELS AS IT CAN AND FINISH WITH SSE
+    unsigned int pixel = 0;
+#ifdef LAUMEMORYOBJECTAVXDISPATCH
+    if (LAUMemoryObjectSimd::level() == LAUMemoryObjectSimd::LevelAVX512) {
+        pixel = transformPixelsAVX512(buffer, pixels, stride, matrix, color);
+    } else if (LAUMemoryObjectSimd::level() == LAUMemoryObjectSimd::LevelAVX2) {
+        pixel = transformPixelsAVX2(buffer, pixels, stride, matrix, color);
+    }
+#endif
+    transformPixelsSSE(buffer, pixel, pixels, stride, matrix, color);
+}
 
-                // SWAP BACK IN T IN PLACE OF W
-                inVecB = _mm_insert_ps(inVecB, inVecA, 0xF0);
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScan::transformScanInPlace(QMatrix4x4 mat)
+{
+    // SMALL SCANS STAY ON THE CALLING THREAD WHILE LARGE ONES GET ONE BLOCK OF ROWS PER CORE
+    int threads = (width() * height() < LAUSCANTRANSFORMTHREADTHRESHOLD) ? 1 : qMax(1, QThread::idealThreadCount());
+    transformScanInPlace(mat, threads);
+}
 
-                // STORE RESULTING COORDINATE INTO OUTPUT SCAN
-                _mm_storeu_ps(&toBuffer[6 * col], inVecB);
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScan::transformScanInPlace(QMatrix4x4 mat, int threads)
+{
+    if (playbackColor == ColorGray || playbackColor == ColorRGB || playbackColor == ColorRGBA) {
+        return;
+    }
 
-                // COPY THE RGB VECTOR
-                _mm_storeu_ps(&toBuffer[6 * col + 3], _mm_loadu_ps(&inBuffer[6 * col + 3]));
-            }
+    if (this->height() > 0 && (playbackColor == ColorXYZG || playbackColor == ColorXYZWRGBA || playbackColor == ColorXYZRGB)) {
+        // THE SCAN LINES ARE CONTIGUOUS SO WE CAN WALK THE BUFFER AS ONE LIST OF PIXELS
+        float *buffer = (float *)this->scanLine(0);
+
+        // EVERY PIXEL IS TRANSFORMED ON ITS OWN, SO THE SCAN IS SPLIT INTO ONE BLOCK OF
+        // WHOLE ROWS PER THREAD WITHOUT CHANGING A SINGLE BIT OF THE RESULT
+        threads = qBound(1, threads, (int)this->height());
+        int rowsPerBlock = ((int)this->height() + threads - 1) / threads;
+
+        QList<int> blocks;
+        for (int row = 0; row < (int)this->height(); row += rowsPerBlock) {
+            blocks << row;
+        }
+
+        auto transformRows = [&](const int &firstRow) {
+            int lastRow = qMin(firstRow + rowsPerBlock, (int)this->height());
+            float *rowBuffer = buffer + (unsigned long long)firstRow * this->width() * colors();
+            transformPixels(rowBuffer, (unsigned int)(lastRow - firstRow) * this->width(), colors(), mat.constData(), playbackColor);
+        };
+
+        if (blocks.count() == 1) {
+            transformRows(blocks.first());
+        } else {
+            QtConcurrent::blockingMap(blocks, transformRows);
         }
     }
     this->setConstTransform(QMatrix4x4());
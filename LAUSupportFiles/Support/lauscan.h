@@ -27,6 +27,11 @@
 
 #include "laumemoryobject.h"
 
+// SCANS WITH AT LEAST THIS MANY PIXELS ARE TRANSFORMED ACROSS ALL CPU CORES,
+// WHILE SMALLER ONES STAY ON THE CALLING THREAD WHERE THE WORK IS TOO SHORT
+// TO PAY FOR HANDING IT TO THE THREAD POOL
+#define LAUSCANTRANSFORMTHREADTHRESHOLD (320 * 240)
+
 class LAULookUpTable;
 
 using namespace LAU3DVideoParameters;
@@ -47,7 +52,7 @@ public:
     void updateLimits();
 
     bool save(QString filename = QString());
-    bool save(libtiff::TIFF *otTiff, int index = 0);
+    bool save(libtiff::TIFF *otTiff);
     bool load(libtiff::TIFF *inTiff, int index = -1);
     bool loadInto(libtiff::TIFF *inTiff, int index = -1);
     bool loadInto(QString filename, int index = -1);
@@ -200,6 +205,7 @@ public:
     LAUMemoryObject channelsToFrames() const;
 
     void transformScanInPlace(QMatrix4x4 mat);
+    void transformScanInPlace(QMatrix4x4 mat, int threads);
 
     QVector<float> const boundingBox();
     QMatrix4x4 const lookAt();
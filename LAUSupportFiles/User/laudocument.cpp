@@ -179,7 +179,7 @@ bool LAUDocument::saveToDisk(QString filename)
                 LAUScan image = imageList.at(n);
 
                 // CALL THE IMAGE TO SAVE ITSELF IN THE CURRENT DIRECTORY
-                image.save(outputTiff, n);
+                image.save(outputTiff);
             }
             dialog.setValue(imageList.count());
 
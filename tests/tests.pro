@@ -0,0 +1,18 @@
+TEMPLATE = subdirs
+
+# ============================================================================
+# QTEST PROJECTS FOR THE SUPPORT LIBRARY AND THE COMMAND LINE TOOLS
+# ============================================================================
+# Run them with "make check" from the build directory. The object ID filter
+# test drives the LAUEncodeObjectIDFilter executable, so build that first.
+
+SUBDIRS += \
+    tst_lauabstractfilter \
+    tst_laubackgroundfilter \
+    tst_laulookuptable \
+    tst_laumemoryobject \
+    tst_laumemoryobjectreader \
+    tst_laureplaycamera \
+    tst_lauscan \
+    tst_lausavetodiskfilter \
+    tst_lauencodeobjectidfilter
@@ -0,0 +1,214 @@
+/*********************************************************************************
+ *                                                                               *
+ * Copyright (C) 2025 Dr. Daniel L. Lau                                          *
+ *                                                                               *
+ * This file is part of LAU 3D Video Inspection System.                         *
+ *                                                                               *
+ * LAU 3D Video Inspection System is free software: you can redistribute it     *
+ * and/or modify it under the terms of the GNU Lesser General Public License    *
+ * as published by the Free Software Foundation, either version 3 of the        *
+ * License, or (at your option) any later version.                              *
+ *                                                                               *
+ * LAU 3D Video Inspection System is distributed in the hope that it will be    *
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser      *
+ * General Public License for more details.                                     *
+ *                                                                               *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with LAU 3D Video Inspection System. If not, see                       *
+ * <https://www.gnu.org/licenses/>.                                             *
+ *                                                                               *
+ *********************************************************************************/
+
+#include <QtTest>
+#include <QPointer>
+#include <QElapsedTimer>
+
+#include "lauabstractfilter.h"
+
+#define TESTPIPELINEFRAMES 24
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// A STAGE THAT STANDS IN FOR THE CAMERA, THE CASCADE CLASSIFIER, THE SAVE-TO-DISK
+// FILTER OR THE DISPLAY BY HOLDING EACH FRAME SET FOR A FIXED LATENCY
+class LAUSlowFilter : public LAUAbstractFilter
+{
+    Q_OBJECT
+
+public:
+    explicit LAUSlowFilter(int msecs, QObject *parent = nullptr) : LAUAbstractFilter(0, 0, parent), latency(msecs) { ; }
+
+protected:
+    void updateBuffer(LAUMemoryObject depth, LAUMemoryObject color, LAUMemoryObject mapping)
+    {
+        Q_UNUSED(color);
+        Q_UNUSED(mapping);
+
+        // TOUCH THE PIXELS SO THE FRAME SET IS REALLY IN USE BY THIS STAGE
+        if (depth.isValid()) {
+            depth.constPointer()[0]++;
+        }
+        QThread::msleep(latency);
+    }
+
+private:
+    int latency;
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// RECIRCULATES A FIXED POOL OF FRAME SETS THE WAY LAUCASCADECLASSIFIERFROMLIVEVIDEO
+// DOES, PRIMING THE CAMERA WITH EVERY SET AND SENDING EACH RETURNING SET STRAIGHT BACK
+class LAUFramePool : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LAUFramePool(int count, int frames, QObject *parent = nullptr) : QObject(parent), framesInFlight(count), framesWanted(frames)
+    {
+        for (int n = 0; n < framesInFlight; n++) {
+            framesList << LAUMemoryObject(64, 48, 1, sizeof(unsigned short), 1);
+        }
+    }
+
+    void start()
+    {
+        timer.start();
+        while (framesList.isEmpty() == false) {
+            emit emitBuffer(framesList.takeFirst(), LAUMemoryObject(), LAUMemoryObject());
+        }
+    }
+
+    bool isFinished() const
+    {
+        return (arrivals.count() >= framesWanted);
+    }
+
+    double period() const
+    {
+        // IGNORE THE FIRST PASS OF EVERY SET SO THE PIPELINE IS FULL BEFORE WE START TIMING
+        int first = qMin(2 * framesInFlight, arrivals.count() - 2);
+        return ((double)(arrivals.last() - arrivals.at(first)) / (double)(arrivals.count() - 1 - first));
+    }
+
+public slots:
+    void onUpdateBuffer(LAUMemoryObject depth, LAUMemoryObject color, LAUMemoryObject mapping)
+    {
+        Q_UNUSED(color);
+        Q_UNUSED(mapping);
+
+        arrivals << timer.elapsed();
+        if (isFinished() == false) {
+            emit emitBuffer(depth, LAUMemoryObject(), LAUMemoryObject());
+        }
+    }
+
+private:
+    int framesInFlight;
+    int framesWanted;
+    QElapsedTimer timer;
+    QList<LAUMemoryObject> framesList;
+    QList<qint64> arrivals;
+
+signals:
+    void emitBuffer(LAUMemoryObject depth, LAUMemoryObject color, LAUMemoryObject mapping);
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// RUNS A SIMULATED CAMERA AND THREE SLOW STAGES, EACH ON ITS OWN FILTER CONTROLLER
+// THREAD, AND CHECKS THAT THROUGHPUT TRACKS THE SLOWEST STAGE ONCE ENOUGH FRAME
+// SETS ARE IN FLIGHT INSTEAD OF THE SUM OF ALL THE STAGE LATENCIES
+class LAUAbstractFilterTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void framesInFlight_data();
+    void framesInFlight();
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUAbstractFilterTest::initTestCase()
+{
+    // THE STAGES HAND FRAMES TO EACH OTHER OVER QUEUED CONNECTIONS, THE SAME AS IN MAIN()
+    qRegisterMetaType<LAUMemoryObject>("LAUMemoryObject");
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUAbstractFilterTest::framesInFlight_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("1 frame set") << 1;
+    QTest::newRow("2 frame sets") << 2;
+    QTest::newRow("4 frame sets") << 4;
+    QTest::newRow("8 frame sets") << 8;
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUAbstractFilterTest::framesInFlight()
+{
+    QFETCH(int, count);
+
+    // CAMERA, CASCADE CLASSIFIER, SAVE-TO-DISK AND DISPLAY LATENCIES IN MILLISECONDS
+    QList<int> latencies = { 20, 40, 60, 20 };
+    int sum = 0;
+    int slowest = 0;
+    for (int latency : latencies) {
+        sum += latency;
+        slowest = qMax(slowest, latency);
+    }
+
+    LAUFramePool pool(count, TESTPIPELINEFRAMES);
+    QList<QPointer<LAUSlowFilter>> filters;
+    QList<LAUAbstractFilterController *> controllers;
+    for (int latency : latencies) {
+        LAUSlowFilter *filter = new LAUSlowFilter(latency);
+        if (filters.isEmpty()) {
+            connect(&pool, SIGNAL(emitBuffer(LAUMemoryObject, LAUMemoryObject, LAUMemoryObject)), filter, SLOT(onUpdateBuffer(LAUMemoryObject, LAUMemoryObject, LAUMemoryObject)), Qt::QueuedConnection);
+        } else {
+            connect(filters.last(), SIGNAL(emitBuffer(LAUMemoryObject, LAUMemoryObject, LAUMemoryObject)), filter, SLOT(onUpdateBuffer(LAUMemoryObject, LAUMemoryObject, LAUMemoryObject)), Qt::QueuedConnection);
+        }
+        filters << filter;
+        controllers << new LAUAbstractFilterController((LAUAbstractFilter *)filter);
+    }
+    connect(filters.last(), SIGNAL(emitBuffer(LAUMemoryObject, LAUMemoryObject, LAUMemoryObject)), &pool, SLOT(onUpdateBuffer(LAUMemoryObject, LAUMemoryObject, LAUMemoryObject)), Qt::QueuedConnection);
+
+    pool.start();
+    QTRY_VERIFY_WITH_TIMEOUT(pool.isFinished(), 60000);
+
+    // WITH N SETS CIRCULATING A CLOSED PIPELINE DELIVERS ONE SET EVERY MAX(SLOWEST, SUM / N) MILLISECONDS
+    double expected = qMax((double)slowest, (double)sum / (double)count);
+    double period = pool.period();
+    qDebug() << count << "frame sets in flight:" << period << "ms per frame, expected" << expected << "slowest stage" << slowest << "sum of stages" << sum;
+    QVERIFY2(period >= 0.9 * expected, qPrintable(QString("%1 ms per frame is faster than the stages allow").arg(period)));
+    QVERIFY2(period <= 1.25 * expected + 10.0, qPrintable(QString("%1 ms per frame, expected %2").arg(period).arg(expected)));
+    if (count >= latencies.count()) {
+        QVERIFY(period < 0.6 * sum);
+    }
+
+    // SHUT DOWN THE STAGE THREADS AND WAIT FOR THE FILTERS TO BE DELETED ON THEM
+    while (controllers.isEmpty() == false) {
+        delete controllers.takeFirst();
+    }
+    for (const QPointer<LAUSlowFilter> &filter : filters) {
+        QTRY_VERIFY_WITH_TIMEOUT(filter.isNull(), 10000);
+    }
+}
+
+QTEST_GUILESS_MAIN(LAUAbstractFilterTest)
+
+#include "tst_lauabstractfilter.moc"
@@ -0,0 +1,62 @@
+QT = core gui widgets opengl xml concurrent testlib
+greaterThan(QT_MAJOR_VERSION, 5): QT += openglwidgets
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+# Build the filter base classes the way the live video applications do, with their GUI code
+DEFINES += EXCLUDE_LAUSCANINSPECTOR
+
+TARGET = tst_lauabstractfilter
+TEMPLATE = app
+
+INCLUDEPATH += $$PWD/../../LAUSupportFiles/Support $$PWD/../../LAUSupportFiles/Filters
+
+# ============================================================================
+# Build Directory Configuration - Place build artifacts outside repository
+# ============================================================================
+BUILD_ROOT = $$PWD/../../../build
+
+CONFIG(debug, debug|release) {
+    DESTDIR = $$BUILD_ROOT/$$TARGET-debug
+}
+
+CONFIG(release, debug|release) {
+    DESTDIR = $$BUILD_ROOT/$$TARGET-release
+}
+
+OBJECTS_DIR = $$DESTDIR/.obj
+MOC_DIR = $$DESTDIR/.moc
+
+SOURCES += \
+    tst_lauabstractfilter.cpp \
+    ../../LAUSupportFiles/Filters/lauabstractfilter.cpp \
+    ../../LAUSupportFiles/Support/lauscan.cpp \
+    ../../LAUSupportFiles/Support/laulookuptable.cpp \
+    ../../LAUSupportFiles/Support/laumemoryobject.cpp
+
+HEADERS += \
+    ../../LAUSupportFiles/Filters/lauabstractfilter.h \
+    ../../LAUSupportFiles/Support/lauscan.h \
+    ../../LAUSupportFiles/Support/laulookuptable.h \
+    ../../LAUSupportFiles/Support/laumemoryobject.h \
+    ../../LAUSupportFiles/Support/lauconstants.h
+
+win32 {
+    INCLUDEPATH += $$quote(C:/usr/Tiff/include)
+    DEPENDPATH  += $$quote(C:/usr/Tiff/include)
+    LIBS        += -L$$quote(C:/usr/Tiff/lib) -ltiff
+}
+unix:macx {
+    CONFIG += sdk_no_version_check
+    QMAKE_CXXFLAGS += -msse2 -msse3 -mssse3 -msse4.1
+    QMAKE_CXXFLAGS_WARN_ON += -Wno-reorder
+    INCLUDEPATH    += /usr/local/include/Tiff
+    DEPENDPATH     += /usr/local/include/Tiff
+    LIBS           += /usr/local/lib/libtiff.dylib
+}
+unix:!macx {
+    QMAKE_CXXFLAGS += -msse2 -msse3 -mssse3 -msse4.1
+    QMAKE_CXXFLAGS_WARN_ON += -Wno-reorder
+    LIBS           += -ltiff
+}
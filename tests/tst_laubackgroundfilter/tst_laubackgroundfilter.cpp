@@ -0,0 +1,296 @@
+/*********************************************************************************
+ *                                                                               *
+ * Copyright (C) 2025 Dr. Daniel L. Lau                                          *
+ *                                                                               *
+ * This file is part of LAU 3D Video Inspection System.                         *
+ *                                                                               *
+ * LAU 3D Video Inspection System is free software: you can redistribute it     *
+ * and/or modify it under the terms of the GNU Lesser General Public License    *
+ * as published by the Free Software Foundation, either version 3 of the        *
+ * License, or (at your option) any later version.                              *
+ *                                                                               *
+ * LAU 3D Video Inspection System is distributed in the hope that it will be    *
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser      *
+ * General Public License for more details.                                     *
+ *                                                                               *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with LAU 3D Video Inspection System. If not, see                       *
+ * <https://www.gnu.org/licenses/>.                                             *
+ *                                                                               *
+ *********************************************************************************/
+
+#include <QtTest>
+#include <QRandomGenerator>
+
+#include "laubackgroundfilter.h"
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// FLOAT MODEL OF LAUBACKGROUNDGLFILTER: TEXTURES AND FRAME BUFFER OBJECTS ARE ARRAYS OF
+// FLOATS, THE SHADERS ARE TRANSCRIBED LINE FOR LINE, AND READ BACK ROUNDS TO 16 BITS
+class LAUBackgroundShaderModel
+{
+public:
+    LAUBackgroundShaderModel(int cols, int rows, int frames) : pixelCount((cols / 4) * 4 * rows), maxFilterFrameCount(frames), frameCounter(0)
+    {
+        for (int n = 0; n < 4; n++) {
+            maxPixelFBO[n] = QVector<float>(pixelCount, 0.0f);
+        }
+    }
+
+    static float texel(unsigned short value)
+    {
+        return ((float)value / 65535.0f);
+    }
+
+    static unsigned short readBack(float value)
+    {
+        return ((unsigned short)qRound(qBound(0.0f, value, 1.0f) * 65535.0f));
+    }
+
+    static float extractMinimumPixel(float pixelA, float pixelB)
+    {
+        // REMOVE ZEROS FROM THE INCOMING VIDEO FRAME
+        pixelA = pixelA + ((pixelA < 0.001f) ? 1.0f : 0.0f);
+        return (qMin(pixelA, pixelB));
+    }
+
+    static float extractMaximumPixel(float pixelA, float pixelB)
+    {
+        // REMOVE SATURATED PIXELS FROM THE MINIMUM FRAME
+        pixelA = pixelA - ((pixelA > 0.999f) ? 1.0f : 0.0f);
+        return (qMax(pixelA, pixelB));
+    }
+
+    void updateBuffer(unsigned short *frame, int length)
+    {
+        // UPLOAD THE FRAME TO THE DEPTH TEXTURE AND ZERO THE SINGLE SENSOR BUFFER
+        QVector<float> textureDepth(pixelCount);
+        for (int n = 0; n < pixelCount; n++) {
+            textureDepth[n] = texel(frame[n]);
+        }
+        memset(frame, 0, length * sizeof(unsigned short));
+
+        // MINIMUM PIXEL PASS AGAINST THE ALL ONES TEXTURE OR THE PREVIOUS FRAME BUFFER OBJECT
+        QVector<float> &minTarget = maxPixelFBO[frameCounter % 2];
+        const QVector<float> &minSource = maxPixelFBO[(frameCounter + 1) % 2];
+        for (int n = 0; n < pixelCount; n++) {
+            float pixelB = ((frameCounter % maxFilterFrameCount) == 0) ? 1.0f : minSource[n];
+            minTarget[n] = extractMinimumPixel(textureDepth[n], pixelB);
+        }
+
+        // MAXIMUM PIXEL PASS, CLEARED WITH THE ALL ZEROS TEXTURE ON A RESET
+        int targetA = (frameCounter / maxFilterFrameCount) % 2 + 2;
+        int targetB = (frameCounter / maxFilterFrameCount + 1) % 2 + 2;
+        if (frameCounter < 2) {
+            for (int n = 0; n < pixelCount; n++) {
+                maxPixelFBO[targetA][n] = extractMaximumPixel(0.0f, 0.0f);
+            }
+        } else if (frameCounter % maxFilterFrameCount == 0) {
+            for (int n = 0; n < pixelCount; n++) {
+                maxPixelFBO[targetA][n] = extractMaximumPixel(maxPixelFBO[(frameCounter + 1) % 2][n], maxPixelFBO[targetB][n]);
+            }
+        }
+        frameCounter++;
+
+        // READ THE CURRENT RESULT BACK INTO THE DEPTH BUFFER
+        const QVector<float> &result = (frameCounter < maxFilterFrameCount) ? maxPixelFBO[frameCounter % 2] : maxPixelFBO[targetA];
+        for (int n = 0; n < pixelCount; n++) {
+            frame[n] = readBack(result[n]);
+        }
+    }
+
+    void background(LAUMemoryObject object, unsigned short maxDistance) const
+    {
+        // READ BACK THE LAST MAXIMUM FRAME BUFFER OBJECT AND IN-PAINT IT LIKE ONEMITBACKGROUND()
+        unsigned short *buffer = (unsigned short *)object.constPointer();
+        memset(buffer, 0, object.length());
+        for (int n = 0; n < pixelCount; n++) {
+            buffer[n] = readBack(maxPixelFBO[3][n]);
+        }
+        LAUBackgroundFilter::inPaint(object, maxDistance);
+    }
+
+private:
+    int pixelCount;
+    int maxFilterFrameCount;
+    int frameCounter;
+    QVector<float> maxPixelFBO[4];
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// CHECKS THE CPU BACKGROUND FILTER AGAINST THE SHADERS OF THE GPU FILTER IT REPLACES
+class LAUBackgroundFilterTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void kernelsMatchShader();
+    void filterMatchesShader_data();
+    void filterMatchesShader();
+
+    void benchmark_data();
+    void benchmark();
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static void randomDepth(LAUMemoryObject object, QRandomGenerator &generator)
+{
+    // A NOISY SCENE WITH HOLES, SATURATED PIXELS AND VALUES ON EITHER SIDE OF BOTH SHADER THRESHOLDS
+    static const unsigned short boundaries[] = { 0, 1, 64, 65, 66, 65469, 65470, 65471, 65534, 65535 };
+    unsigned short *buffer = (unsigned short *)object.constPointer();
+    int pixels = (int)(object.width() * object.height() * object.frames());
+    for (int n = 0; n < pixels; n++) {
+        int choice = generator.bounded(32);
+        if (choice < 4) {
+            buffer[n] = boundaries[generator.bounded(10)];
+        } else if (choice < 6) {
+            buffer[n] = (unsigned short)generator.bounded(65536);
+        } else {
+            buffer[n] = (unsigned short)(1500 + (n % 977) + generator.bounded(40));
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUBackgroundFilterTest::initTestCase()
+{
+    qRegisterMetaType<LAUMemoryObject>("LAUMemoryObject");
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUBackgroundFilterTest::kernelsMatchShader()
+{
+    // EVERY 16-BIT VALUE OF A AGAINST VALUES OF B ON BOTH SIDES OF THE THRESHOLDS, WITH A SCALAR TAIL
+    const int count = 65536 - 3;
+    QVector<unsigned short> pixelsA(65536), pixelsB(65536), minimum(65536), maximum(65536);
+    for (int n = 0; n < 65536; n++) {
+        pixelsA[n] = (unsigned short)n;
+    }
+
+    for (int value : { 0, 1, 64, 65, 66, 1000, 32768, 65469, 65470, 65471, 65535 }) {
+        pixelsB.fill((unsigned short)value);
+        LAUBackgroundFilter::extractMinimumPixel(pixelsA.constData(), pixelsB.constData(), minimum.data(), count);
+        LAUBackgroundFilter::extractMaximumPixel(pixelsA.constData(), pixelsB.constData(), maximum.data(), count);
+        for (int n = 0; n < count; n++) {
+            float pixelA = LAUBackgroundShaderModel::texel(pixelsA[n]);
+            float pixelB = LAUBackgroundShaderModel::texel(pixelsB[n]);
+            if (minimum[n] != LAUBackgroundShaderModel::readBack(LAUBackgroundShaderModel::extractMinimumPixel(pixelA, pixelB))) {
+                QFAIL(qPrintable(QString("minimum of %1 and %2").arg(pixelsA[n]).arg(pixelsB[n])));
+            }
+            if (maximum[n] != LAUBackgroundShaderModel::readBack(LAUBackgroundShaderModel::extractMaximumPixel(pixelA, pixelB))) {
+                QFAIL(qPrintable(QString("maximum of %1 and %2").arg(pixelsA[n]).arg(pixelsB[n])));
+            }
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUBackgroundFilterTest::filterMatchesShader_data()
+{
+    QTest::addColumn<int>("cols");
+    QTest::addColumn<int>("rows");
+    QTest::addColumn<int>("maxFilterFrameCount");
+    QTest::addColumn<int>("frames");
+
+    QTest::newRow("640x480") << 640 << 480 << 30 << 95;
+    QTest::newRow("partial texel") << 150 << 40 << 7 << 40;
+    QTest::newRow("every frame") << 64 << 16 << 1 << 10;
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUBackgroundFilterTest::filterMatchesShader()
+{
+    QFETCH(int, cols);
+    QFETCH(int, rows);
+    QFETCH(int, maxFilterFrameCount);
+    QFETCH(int, frames);
+
+    LAUBackgroundFilter filter(cols, rows);
+    filter.onSetMaxPixelFilterCount(maxFilterFrameCount);
+    filter.setMaxDistance(4000);
+    LAUBackgroundShaderModel model(cols, rows, maxFilterFrameCount);
+
+    // EVERY FRAME WRITTEN BACK INTO THE DEPTH BUFFER MUST MATCH THE SHADERS BIT FOR BIT
+    QRandomGenerator generator((quint32)(cols * rows + maxFilterFrameCount));
+    for (int frame = 0; frame < frames; frame++) {
+        LAUMemoryObject depth(cols, rows, 1, sizeof(unsigned short), 1);
+        randomDepth(depth, generator);
+        depth.setElapsed((unsigned int)(33 * frame));
+
+        QVector<unsigned short> expected(cols * rows);
+        memcpy(expected.data(), depth.constPointer(), depth.length());
+        model.updateBuffer(expected.data(), cols * rows);
+
+        filter.onUpdateBuffer(depth);
+        QVERIFY2(memcmp(depth.constPointer(), expected.constData(), depth.length()) == 0, qPrintable(QString("frame %1").arg(frame)));
+    }
+    QCOMPARE(filter.frames(), frames);
+
+    // THE IN-PAINTED BACKGROUND MUST MATCH WHAT ONEMITBACKGROUND() READS BACK FROM THE GPU
+    LAUMemoryObject background = filter.background();
+    QVERIFY(background.isValid());
+    LAUMemoryObject expected(cols, rows, 1, sizeof(unsigned short), 1);
+    model.background(expected, 4000);
+    QVERIFY(memcmp(background.constPointer(), expected.constPointer(), expected.length()) == 0);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUBackgroundFilterTest::benchmark_data()
+{
+    QTest::addColumn<bool>("reference");
+
+    QTest::newRow("shader model") << true;
+    QTest::newRow("LAUBackgroundFilter") << false;
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUBackgroundFilterTest::benchmark()
+{
+    QFETCH(bool, reference);
+
+    // ONE 640X480 FRAME PER ITERATION, REFRESHED FROM A SOURCE FRAME SINCE THE FILTER OVERWRITES IT
+    QRandomGenerator generator(7);
+    LAUMemoryObject source(640, 480, 1, sizeof(unsigned short), 1);
+    randomDepth(source, generator);
+    LAUMemoryObject depth(640, 480, 1, sizeof(unsigned short), 1);
+    depth.setElapsed(0);
+
+    if (reference) {
+        LAUBackgroundShaderModel model(640, 480, 30);
+        QBENCHMARK {
+            memcpy(depth.constPointer(), source.constPointer(), source.length());
+            model.updateBuffer((unsigned short *)depth.constPointer(), 640 * 480);
+        }
+    } else {
+        LAUBackgroundFilter filter(640, 480);
+        QBENCHMARK {
+            memcpy(depth.constPointer(), source.constPointer(), source.length());
+            filter.onUpdateBuffer(depth);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(LAUBackgroundFilterTest)
+
+#include "tst_laubackgroundfilter.moc"
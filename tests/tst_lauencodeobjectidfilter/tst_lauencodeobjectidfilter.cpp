@@ -0,0 +1,361 @@
+/*********************************************************************************
+ *                                                                               *
+ * Copyright (C) 2025 Dr. Daniel L. Lau                                          *
+ *                                                                               *
+ * This file is part of LAU 3D Video Inspection System.                         *
+ *                                                                               *
+ * LAU 3D Video Inspection System is free software: you can redistribute it     *
+ * and/or modify it under the terms of the GNU Lesser General Public License    *
+ * as published by the Free Software Foundation, either version 3 of the        *
+ * License, or (at your option) any later version.                              *
+ *                                                                               *
+ * LAU 3D Video Inspection System is distributed in the hope that it will be    *
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser      *
+ * General Public License for more details.                                     *
+ *                                                                               *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with LAU 3D Video Inspection System. If not, see                       *
+ * <https://www.gnu.org/licenses/>.                                             *
+ *                                                                               *
+ *********************************************************************************/
+
+#include <QtTest>
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+#include <QTemporaryDir>
+
+#include "laumemoryobject.h"
+#include "lauconstants.h"
+
+#define TESTRECORDINGWIDTH   32
+#define TESTRECORDINGHEIGHT  24
+#define TESTMANYJOBS         4
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static QStringList repeatedTag(QString tag, int count)
+{
+    QStringList tags;
+    for (int n = 0; n < count; n++) {
+        tags << tag;
+    }
+    return (tags);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static QStringList consoleLines(QString log, QString root)
+{
+    // DROP THE LINE THAT REPORTS THE WORKER COUNT AND THE PART OF EACH PATH THAT ONLY DIFFERS BY RUN
+    QStringList lines;
+    for (QString line : log.split(QChar('\n'))) {
+        if (line.endsWith(QString("worker(s)")) == false) {
+            lines << line.replace(root, QString());
+        }
+    }
+    return (lines);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static QHash<unsigned int, QByteArray> rawStrips(QString filename)
+{
+    // THE STILL COMPRESSED STRIPS OF EVERY DIRECTORY, KEYED BY THE FRAME'S ELAPSED TIME SINCE THE
+    // ENCODER REORDERS DIRECTORIES BUT MUST NEVER TOUCH THE PIXEL DATA IT COPIES
+    QHash<unsigned int, QByteArray> strips;
+    LAUMemoryObjectReader reader(filename);
+    QList<unsigned int> elapsed;
+    for (int n = 0; n < reader.directories(); n++) {
+        elapsed << reader.metaData(n).elapsed;
+    }
+    reader.close();
+
+    libtiff::TIFF *inputTiff = libtiff::TIFFOpen(filename.toLocal8Bit(), "r");
+    if (inputTiff == nullptr) {
+        return (strips);
+    }
+    int directory = 0;
+    do {
+        QByteArray bytes;
+        for (unsigned int strip = 0; strip < libtiff::TIFFNumberOfStrips(inputTiff); strip++) {
+            QByteArray stripBytes((int)libtiff::TIFFRawStripSize(inputTiff, strip), (char)0);
+            libtiff::TIFFReadRawStrip(inputTiff, strip, stripBytes.data(), stripBytes.length());
+            bytes.append(stripBytes);
+        }
+        if (directory < elapsed.count()) {
+            strips[elapsed.at(directory)] = bytes;
+        }
+        directory++;
+    } while (libtiff::TIFFReadDirectory(inputTiff));
+    libtiff::TIFFClose(inputTiff);
+    return (strips);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// RUNS LAUENCODEOBJECTIDFILTER ON TWO COPIES OF THE SAME DIRECTORY OF SYNTHETIC
+// RECORDINGS, ONE WITH A SINGLE WORKER AND ONE WITH SEVERAL, AND CHECKS THAT THE
+// RENAMED FILES, THE ENCODED METADATA, THE FRAME ORDER AND THE UNDO ARE IDENTICAL
+class LAUEncodeObjectIDFilterTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void jobsAreEquivalent();
+    void stripsSurviveTaggingAndUndo();
+
+private:
+    QString encoder;
+
+    bool writeRecording(QString filename, bool calibrated, QStringList rfids, int seed) const;
+    bool runEncoder(QStringList arguments, QString *output = nullptr) const;
+    void compareDirectories(QString dirA, QString dirB) const;
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUEncodeObjectIDFilterTest::initTestCase()
+{
+    // SILENCE LIBTIFF SO ITS WARNINGS DON'T LAND ON STDERR
+    libtiff::TIFFSetErrorHandler(myTIFFErrorHandler);
+    libtiff::TIFFSetWarningHandler(myTIFFWarningHandler);
+
+    encoder = qEnvironmentVariable("LAUENCODEOBJECTIDFILTER", QString(LAUENCODEOBJECTIDFILTERPATH));
+    if (QFileInfo(encoder).isExecutable() == false) {
+        QString bundle = QString("%1.app/Contents/MacOS/%2").arg(encoder).arg(QFileInfo(encoder).fileName());
+        if (QFileInfo(bundle).isExecutable()) {
+            encoder = bundle;
+        } else if (QFileInfo(encoder + QString(".exe")).isExecutable()) {
+            encoder = encoder + QString(".exe");
+        } else {
+            QSKIP(qPrintable(QString("LAUEncodeObjectIDFilter not found at %1, build it first or set LAUENCODEOBJECTIDFILTER").arg(encoder)));
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUEncodeObjectIDFilterTest::writeRecording(QString filename, bool calibrated, QStringList rfids, int seed) const
+{
+    QList<LAUMemoryObject> objects;
+    for (int frm = 0; frm <= rfids.count(); frm++) {
+        LAUMemoryObject object(TESTRECORDINGWIDTH, TESTRECORDINGHEIGHT, 1, sizeof(unsigned short));
+        for (unsigned int row = 0; row < object.height(); row++) {
+            unsigned short *buffer = (unsigned short *)object.scanLine(row);
+            for (unsigned int col = 0; col < object.width(); col++) {
+                buffer[col] = (unsigned short)(seed * 7919 + frm * 131 + row * 17 + col);
+            }
+        }
+
+        if (frm == 0) {
+            // THE FIRST FRAME IS THE BACKGROUND AND CARRIES THE CALIBRATION, WHICH NEEDS A
+            // TRANSFORM OTHER THAN IDENTITY AND A FINITE ONE METER BOUNDING BOX TO BE ACCEPTED
+            if (calibrated) {
+                QVector<double> jetr(LAU_JETR_VECTOR_SIZE, 0.0);
+                jetr[12] = 2.0;
+                jetr[17] = 2.0;
+                jetr[22] = 2.0;
+                jetr[27] = 1.0;
+                jetr[28] = -500.0;
+                jetr[29] = 500.0;
+                jetr[30] = -500.0;
+                jetr[31] = 500.0;
+                jetr[32] = 0.0;
+                jetr[33] = 1000.0;
+                object.setJetr(jetr);
+            }
+            object.setElapsed(1);
+        } else {
+            // SWAP THE ELAPSED TIMES OF THE LAST TWO FRAMES SO THE ENCODER HAS TO REORDER THEM
+            int order = frm;
+            if (rfids.count() > 6 && frm >= rfids.count() - 1) {
+                order = (frm == rfids.count()) ? rfids.count() - 1 : rfids.count();
+            }
+            object.setRFID(rfids.at(frm - 1));
+            object.setElapsed(100 + 33 * order);
+        }
+        objects << object;
+    }
+    return (LAUMemoryObject::saveObjectsToDisk(objects, filename));
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+bool LAUEncodeObjectIDFilterTest::runEncoder(QStringList arguments, QString *output) const
+{
+    QProcess process;
+    process.setProcessChannelMode(QProcess::MergedChannels);
+    process.start(encoder, arguments);
+    if (process.waitForFinished(300000) == false) {
+        process.kill();
+        return (false);
+    }
+    if (output) {
+        *output = QString::fromUtf8(process.readAll());
+    }
+    return (process.exitStatus() == QProcess::NormalExit && process.exitCode() == 0);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUEncodeObjectIDFilterTest::compareDirectories(QString dirA, QString dirB) const
+{
+    // THE SAME FILES MUST HAVE BEEN RENAMED THE SAME WAY
+    QStringList filesA = QDir(dirA).entryList(QDir::Files, QDir::Name);
+    QStringList filesB = QDir(dirB).entryList(QDir::Files, QDir::Name);
+    QCOMPARE(filesA, filesB);
+
+    // AND EVERY DIRECTORY MUST HOLD THE SAME METADATA AND PIXELS IN THE SAME ORDER, COMPARING
+    // THE XML AS KEY VALUE PAIRS SINCE ITS ELEMENT ORDER FOLLOWS EACH PROCESS'S HASH SEED
+    for (const QString &file : filesA) {
+        LAUMemoryObjectReader readerA(QDir(dirA).absoluteFilePath(file));
+        LAUMemoryObjectReader readerB(QDir(dirB).absoluteFilePath(file));
+        QVERIFY2(readerA.isValid() && readerB.isValid(), qPrintable(file));
+        QCOMPARE(readerA.directories(), readerB.directories());
+
+        for (int n = 0; n < readerA.directories(); n++) {
+            LAUMemoryObjectMetaData metaA = readerA.metaData(n);
+            LAUMemoryObjectMetaData metaB = readerB.metaData(n);
+            QCOMPARE(metaA.rfid, metaB.rfid);
+            QCOMPARE(metaA.elapsed, metaB.elapsed);
+            QCOMPARE(LAUMemoryObject::xmlToHash(metaA.xml), LAUMemoryObject::xmlToHash(metaB.xml));
+
+            LAUMemoryObject objectA = readerA.read(n);
+            LAUMemoryObject objectB = readerB.read(n);
+            QCOMPARE(objectA.length(), objectB.length());
+            QVERIFY2(memcmp(objectA.constPointer(), objectB.constPointer(), objectA.length()) == 0, qPrintable(QString("%1 directory %2").arg(file).arg(n)));
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUEncodeObjectIDFilterTest::jobsAreEquivalent()
+{
+    QTemporaryDir temporaryDir;
+    QVERIFY(temporaryDir.isValid());
+
+    // EACH RUN GETS A DIRECTORY WITH THE SAME NAME SO THAT THE CONSOLE LOGS CAN BE COMPARED TOO
+    QString dirOne = QDir(temporaryDir.path()).absoluteFilePath("one/recordings");
+    QString dirMany = QDir(temporaryDir.path()).absoluteFilePath("many/recordings");
+    QVERIFY(QDir().mkpath(dirOne));
+    QVERIFY(QDir().mkpath(dirMany));
+
+    // COVER EVERY OUTCOME: NEW OBJECT IDS, DUPLICATES THAT ONLY THE FIRST FILE IN NAME ORDER
+    // MAY KEEP, TOO FEW RFID READINGS, MISSING CALIBRATION, AND A MIXED SET OF READINGS
+    QString tagA("982000411111111");
+    QString tagB("982000422222222");
+    QString tagC("982000455555555");
+    QString tagD("982000466666666");
+    QList<QPair<bool, QStringList>> recordings;
+    recordings << QPair<bool, QStringList>(true, repeatedTag(tagA, 8));
+    recordings << QPair<bool, QStringList>(true, repeatedTag(tagB, 8));
+    recordings << QPair<bool, QStringList>(true, repeatedTag(tagA, 8));
+    recordings << QPair<bool, QStringList>(true, repeatedTag(QString("982000433333333"), 3));
+    recordings << QPair<bool, QStringList>(false, repeatedTag(QString("982000444444444"), 6));
+    recordings << QPair<bool, QStringList>(true, QStringList() << tagC << tagD << tagC << tagC << tagD << tagC << tagC);
+    recordings << QPair<bool, QStringList>(true, repeatedTag(tagB, 6));
+    recordings << QPair<bool, QStringList>(true, repeatedTag(QString("982000477777777"), 7));
+    recordings << QPair<bool, QStringList>(true, repeatedTag(tagA, 6));
+
+    for (int n = 0; n < recordings.count(); n++) {
+        QString filename = QString("data%1.tif").arg(n + 1, 5, 10, QChar('0'));
+        QVERIFY(writeRecording(QDir(dirOne).absoluteFilePath(filename), recordings.at(n).first, recordings.at(n).second, n));
+        QVERIFY(QFile::copy(QDir(dirOne).absoluteFilePath(filename), QDir(dirMany).absoluteFilePath(filename)));
+    }
+
+    // ENCODE BOTH COPIES AND COMPARE THE RESULTS AND THE CONSOLE LOGS
+    QString logOne, logMany;
+    QVERIFY(runEncoder(QStringList() << dirOne << "--jobs" << "1", &logOne));
+    QVERIFY(runEncoder(QStringList() << dirMany << "--jobs" << QString::number(TESTMANYJOBS), &logMany));
+    QCOMPARE(consoleLines(logOne, QDir(temporaryDir.path()).absoluteFilePath("one")), consoleLines(logMany, QDir(temporaryDir.path()).absoluteFilePath("many")));
+
+    compareDirectories(dirOne, dirMany);
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+
+    // MAKE SURE THE EXPECTED OUTCOMES ACTUALLY HAPPENED SO THE TEST CAN'T PASS VACUOUSLY
+    QStringList files = QDir(dirOne).entryList(QDir::Files, QDir::Name);
+    QVERIFY(files.contains("noTag00003.tif"));
+    QVERIFY(files.contains("badFile00004.tif"));
+    QVERIFY(files.contains("noCal00005.tif"));
+    QVERIFY(files.contains("noTag00007.tif"));
+    QVERIFY(files.contains("noTag00009.tif"));
+    QVERIFY(files.contains("data00008.tif"));
+
+    LAUMemoryObjectReader mixedReader(QDir(dirOne).absoluteFilePath("data00006.tif"));
+    QCOMPARE(LAUMemoryObject::xmlToHash(mixedReader.metaData(0).xml).value("ObjectID").trimmed(), tagC);
+    mixedReader.close();
+
+    // UNDO BOTH RUNS AND COMPARE AGAIN
+    QVERIFY(runEncoder(QStringList() << "--undo" << dirOne << "--jobs" << "1"));
+    QVERIFY(runEncoder(QStringList() << "--undo" << dirMany << "--jobs" << QString::number(TESTMANYJOBS)));
+    compareDirectories(dirOne, dirMany);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUEncodeObjectIDFilterTest::stripsSurviveTaggingAndUndo()
+{
+    QTemporaryDir temporaryDir;
+    QVERIFY(temporaryDir.isValid());
+
+    // ONE CALIBRATED RECORDING WHOSE LAST TWO FRAMES THE ENCODER HAS TO SWAP
+    QString filename = QDir(temporaryDir.path()).absoluteFilePath("data00001.tif");
+    QVERIFY(writeRecording(filename, true, repeatedTag(QString("982000411111111"), 8), 1));
+
+    LAUMemoryObjectReader before(filename);
+    QList<unsigned int> orderBefore;
+    for (int n = 0; n < before.directories(); n++) {
+        orderBefore << before.metaData(n).elapsed;
+    }
+    before.close();
+    QHash<unsigned int, QByteArray> stripsBefore = rawStrips(filename);
+    QCOMPARE(stripsBefore.count(), 9);
+
+    // TAGGING REWRITES EVERY XML PACKET AND REORDERS THE FRAMES BUT COPIES EACH STRIP BYTE FOR BYTE
+    QVERIFY(runEncoder(QStringList() << temporaryDir.path() << "--jobs" << "1"));
+    QVERIFY(QFile::exists(filename));
+    LAUMemoryObjectReader tagged(filename);
+    QVERIFY(LAUMemoryObject::xmlToHash(tagged.metaData(0).xml).contains("ObjectID"));
+    QList<unsigned int> orderTagged;
+    for (int n = 0; n < tagged.directories(); n++) {
+        orderTagged << tagged.metaData(n).elapsed;
+    }
+    tagged.close();
+    QVERIFY(orderTagged != orderBefore);
+    QCOMPARE(rawStrips(filename), stripsBefore);
+
+    // UNDO PUTS THE ORIGINAL ORDER BACK, STILL WITHOUT TOUCHING THE STRIPS
+    QVERIFY(runEncoder(QStringList() << "--undo" << temporaryDir.path() << "--jobs" << "1"));
+    LAUMemoryObjectReader undone(filename);
+    QVERIFY(LAUMemoryObject::xmlToHash(undone.metaData(0).xml).contains("ObjectID") == false);
+    QList<unsigned int> orderUndone;
+    for (int n = 0; n < undone.directories(); n++) {
+        orderUndone << undone.metaData(n).elapsed;
+    }
+    undone.close();
+    QCOMPARE(orderUndone, orderBefore);
+    QCOMPARE(rawStrips(filename), stripsBefore);
+
+    // NEITHER THE TEMPORARY COPY NOR THE BACKUP OF THE ORIGINAL IS LEFT BEHIND
+    QCOMPARE(QDir(temporaryDir.path()).entryList(QDir::Files | QDir::Hidden), QStringList() << "data00001.tif");
+}
+
+QTEST_GUILESS_MAIN(LAUEncodeObjectIDFilterTest)
+
+#include "tst_lauencodeobjectidfilter.moc"
@@ -0,0 +1,303 @@
+/*********************************************************************************
+ *                                                                               *
+ * Copyright (C) 2025 Dr. Daniel L. Lau                                          *
+ *                                                                               *
+ * This file is part of LAU 3D Video Inspection System.                         *
+ *                                                                               *
+ * LAU 3D Video Inspection System is free software: you can redistribute it     *
+ * and/or modify it under the terms of the GNU Lesser General Public License    *
+ * as published by the Free Software Foundation, either version 3 of the        *
+ * License, or (at your option) any later version.                              *
+ *                                                                               *
+ * LAU 3D Video Inspection System is distributed in the hope that it will be    *
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser      *
+ * General Public License for more details.                                     *
+ *                                                                               *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with LAU 3D Video Inspection System. If not, see                       *
+ * <https://www.gnu.org/licenses/>.                                             *
+ *                                                                               *
+ *********************************************************************************/
+
+#include <QtTest>
+#include <QtMath>
+#include <QVector3D>
+#include <QGenericMatrix>
+
+#include "laulookuptable.h"
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// CHECKS THE NEWTON SOLVER THAT INVERTS THE LENS DISTORTION WHEN BUILDING A
+// LOOK UP TABLE FROM INTRINSICS AGAINST THE PATTERN SEARCH IT REPLACED
+class LAULookUpTableTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void newtonSolver_data();
+    void newtonSolver();
+
+    void newtonSolverBenchmark_data();
+    void newtonSolverBenchmark();
+};
+
+typedef struct {
+    int row;
+    unsigned int width;
+    QMatrix3x3 intParameters;
+    QVector<double> rdlParameters;
+    QVector<double> tngParameters;
+    double *buffer;
+} PatternSearchRow;
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static QMatrix3x3 testIntrinsics(unsigned int cols, unsigned int rows)
+{
+    QMatrix3x3 intParameters;
+    intParameters.fill(0.0f);
+    intParameters(0, 0) = 0.78f * (float)cols;
+    intParameters(1, 1) = 0.78f * (float)cols;
+    intParameters(0, 2) = ((float)cols - 1.0f) / 2.0f;
+    intParameters(1, 2) = ((float)rows - 1.0f) / 2.0f;
+    intParameters(2, 2) = 1.0f;
+    return (intParameters);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static QPointF distortedCoordinates(QVector3D point, QMatrix3x3 intParameters, QVector<double> rdlParameters, QVector<double> tngParameters)
+{
+    // THE DISTORTION MODEL EXACTLY AS THE PATTERN SEARCH EVALUATED IT
+    QPointF distortedCoodinates;
+
+    point = point / point.z();
+
+    double r = point.x()*point.x() + point.y()*point.y();
+    double g = (1.0 + rdlParameters[0]*r + rdlParameters[1]*r*r + rdlParameters[2]*r*r*r) / (1.0 + rdlParameters[3]*r + rdlParameters[4]*r*r + rdlParameters[5]*r*r*r);
+
+    double x = point.x()*g + 2.0*tngParameters[0]*point.x()*point.y() + tngParameters[1]*(r + 2.0*point.x()*point.x());
+    double y = point.y()*g + 2.0*tngParameters[1]*point.x()*point.y() + tngParameters[0]*(r + 2.0*point.y()*point.y());
+
+    distortedCoodinates.setX(intParameters(0, 0)*x + intParameters(0, 2));
+    distortedCoodinates.setY(intParameters(1, 1)*y + intParameters(1, 2));
+
+    return (distortedCoodinates);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static double distanceBetweenTwoPoints(QPointF pointA, QPointF pointB)
+{
+    QPointF pointC = pointA - pointB;
+    return (sqrt(pointC.x()*pointC.x() + pointC.y()*pointC.y()));
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static void patternSearchRow(PatternSearchRow &params)
+{
+    // THE PATTERN SEARCH THAT LAULOOKUPTABLE USED BEFORE THE NEWTON SOLVER, WRITING
+    // THE WORLD COORDINATE AT Z = 1000 AND THE PIXEL RESIDUAL FOR EVERY COLUMN
+    double *buffer = params.buffer + 3 * params.row * params.width;
+    double errorOpt = 1e6;
+    double xw = 0.0, yw = 0.0, zw = 0.0;
+
+    for (int col = 0; col < (int)params.width; col++) {
+        double xi = (double)col;
+        double yi = (double)params.row;
+
+        if (errorOpt > 1.0) {
+            xw = 1000.0 * ((double)col - params.intParameters(0, 2)) / params.intParameters(0, 0);
+            yw = 1000.0 * ((double)params.row - params.intParameters(1, 2)) / params.intParameters(1, 1);
+            zw = 1000.0;
+        }
+
+        for (double dlt = 1.0; dlt > 0.1; dlt /= 2.0) {
+            while (1) {
+                double eO = distanceBetweenTwoPoints(distortedCoordinates(QVector3D(xw+0.0, yw+0.0, zw), params.intParameters, params.rdlParameters, params.tngParameters), QPointF(xi, yi));
+                double eA = distanceBetweenTwoPoints(distortedCoordinates(QVector3D(xw-dlt, yw+0.0, zw), params.intParameters, params.rdlParameters, params.tngParameters), QPointF(xi, yi));
+                double eB = distanceBetweenTwoPoints(distortedCoordinates(QVector3D(xw+dlt, yw+0.0, zw), params.intParameters, params.rdlParameters, params.tngParameters), QPointF(xi, yi));
+                double eC = distanceBetweenTwoPoints(distortedCoordinates(QVector3D(xw+0.0, yw-dlt, zw), params.intParameters, params.rdlParameters, params.tngParameters), QPointF(xi, yi));
+                double eD = distanceBetweenTwoPoints(distortedCoordinates(QVector3D(xw+0.0, yw+dlt, zw), params.intParameters, params.rdlParameters, params.tngParameters), QPointF(xi, yi));
+
+                errorOpt = qMin(eO, qMin(eA, qMin(eB, qMin(eC, eD))));
+                if (eA == errorOpt) {
+                    xw = xw - dlt;
+                } else if (eB == errorOpt) {
+                    xw = xw + dlt;
+                } else if (eC == errorOpt) {
+                    yw = yw - dlt;
+                } else if (eD == errorOpt) {
+                    yw = yw + dlt;
+                } else {
+                    break;
+                }
+            }
+        }
+
+        buffer[3*col + 0] = xw;
+        buffer[3*col + 1] = yw;
+        buffer[3*col + 2] = errorOpt;
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUMemoryObject patternSearch(unsigned int cols, unsigned int rows, QMatrix3x3 intParameters, QVector<double> rdlParameters, QVector<double> tngParameters)
+{
+    LAUMemoryObject object(cols, rows, 3, sizeof(double));
+
+    QList<PatternSearchRow> rowParams;
+    for (int row = 0; row < (int)rows; row++) {
+        PatternSearchRow params;
+        params.row = row;
+        params.width = cols;
+        params.intParameters = intParameters;
+        params.rdlParameters = rdlParameters;
+        params.tngParameters = tngParameters;
+        params.buffer = (double *)object.pointer();
+        rowParams << params;
+    }
+    QtConcurrent::blockingMap(rowParams, patternSearchRow);
+
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static void addDistortionRows()
+{
+    QTest::addColumn<QVector<double>>("rdlParameters");
+    QTest::addColumn<QVector<double>>("tngParameters");
+
+    QTest::newRow("polynomial radial") << (QVector<double>() << 0.1 << -0.05 << 0.01 << 0.0 << 0.0 << 0.0) << (QVector<double>() << 0.001 << -0.0005);
+    QTest::newRow("rational radial") << (QVector<double>() << 0.5 << -0.02 << 0.001 << 0.4 << -0.01 << 0.0005) << (QVector<double>() << -0.0008 << 0.0012);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAULookUpTableTest::initTestCase()
+{
+    // SILENCE LIBTIFF SO ITS WARNINGS DON'T LAND ON STDERR
+    libtiff::TIFFSetErrorHandler(myTIFFErrorHandler);
+    libtiff::TIFFSetWarningHandler(myTIFFWarningHandler);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAULookUpTableTest::newtonSolver_data()
+{
+    addDistortionRows();
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAULookUpTableTest::newtonSolver()
+{
+    QFETCH(QVector<double>, rdlParameters);
+    QFETCH(QVector<double>, tngParameters);
+
+    unsigned int cols = 320;
+    unsigned int rows = 288;
+    QMatrix3x3 intParameters = testIntrinsics(cols, rows);
+
+    bool completed = false;
+    LAULookUpTable table(cols, rows, intParameters, rdlParameters, tngParameters, 0.1, 500.0, 8000.0, nullptr, &completed);
+    QVERIFY(completed);
+    QCOMPARE(table.colors(), 12u);
+
+    LAUMemoryObject reference = patternSearch(cols, rows, intParameters, rdlParameters, tngParameters);
+
+    // THE PATTERN SEARCH STOPS ON A GRID OF 0.125 WORLD UNITS AT Z = 1000, SO IT CAN ONLY BE TRUSTED TO THAT STEP
+    double fx = intParameters(0, 0);
+    double fy = intParameters(1, 1);
+    double tolerance = 0.125 / 1000.0 * qMax(fx, fy);
+
+    int valid = 0;
+    for (unsigned int row = 0; row < rows; row++) {
+        const float *buffer = (const float *)table.constScanLine(row);
+        const double *expected = (const double *)reference.constScanLine(row);
+        for (unsigned int col = 0; col < cols; col++) {
+            const float *vector = buffer + 12 * col;
+            bool newtonValid = (qIsNaN(vector[0]) == false);
+            bool searchValid = (expected[3*col + 2] < 0.1);
+
+            // BOTH SOLVERS USE THE SAME 0.1 PIXEL THRESHOLD, SO THEY MUST AGREE ON WHICH PIXELS ARE VALID
+            QVERIFY2(newtonValid == searchValid, qPrintable(QString("validity differs at %1,%2").arg(col).arg(row)));
+            if (newtonValid == false) {
+                continue;
+            }
+            valid++;
+
+            // THE STORED RAY MUST DISTORT BACK ONTO ITS OWN PIXEL
+            double xn = -(double)vector[0];
+            double yn = (double)vector[2];
+            QPointF pixel = distortedCoordinates(QVector3D((float)xn, (float)yn, 1.0f), intParameters, rdlParameters, tngParameters);
+            QVERIFY2(distanceBetweenTwoPoints(pixel, QPointF(col, row)) < 1e-3, qPrintable(QString("residual %1 at %2,%3").arg(distanceBetweenTwoPoints(pixel, QPointF(col, row))).arg(col).arg(row)));
+
+            // AND LAND WITHIN THE PATTERN SEARCH'S STEP OF WHERE THE OLD SOLVER ENDED UP
+            double dx = qAbs(xn - expected[3*col + 0] / 1000.0) * fx;
+            double dy = qAbs(yn - expected[3*col + 1] / 1000.0) * fy;
+            QVERIFY2(dx <= tolerance && dy <= tolerance, qPrintable(QString("moved %1,%2 pixels at %3,%4").arg(dx).arg(dy).arg(col).arg(row)));
+        }
+    }
+    QVERIFY(valid > 0);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAULookUpTableTest::newtonSolverBenchmark_data()
+{
+    QTest::addColumn<bool>("newton");
+
+    QTest::newRow("pattern search") << false;
+    QTest::newRow("newton") << true;
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAULookUpTableTest::newtonSolverBenchmark()
+{
+    QFETCH(bool, newton);
+
+    unsigned int cols = 640;
+    unsigned int rows = 576;
+    QMatrix3x3 intParameters = testIntrinsics(cols, rows);
+    QVector<double> rdlParameters = QVector<double>() << 0.5 << -0.02 << 0.001 << 0.4 << -0.01 << 0.0005;
+    QVector<double> tngParameters = QVector<double>() << -0.0008 << 0.0012;
+
+    // THE TABLE CONSTRUCTOR POLLS ITS WORKERS EVERY 100 MS IN GUI BUILDS, SO ITS
+    // TIMES ARE ROUNDED UP TO THAT; THE PATTERN SEARCH RUNS ON EVERY CORE
+    if (newton) {
+        QBENCHMARK {
+            LAULookUpTable table(cols, rows, intParameters, rdlParameters, tngParameters);
+            Q_UNUSED(table);
+        }
+    } else {
+        QBENCHMARK {
+            LAUMemoryObject object = patternSearch(cols, rows, intParameters, rdlParameters, tngParameters);
+            Q_UNUSED(object);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(LAULookUpTableTest)
+
+#include "tst_laulookuptable.moc"
@@ -0,0 +1,59 @@
+QT = core gui widgets xml concurrent testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+# The look up table constructors take QMatrix3x3 and QWidget, so leave HEADLESS off like the applications do
+DEFINES += EXCLUDE_LAUSCANINSPECTOR
+
+TARGET = tst_laulookuptable
+TEMPLATE = app
+
+INCLUDEPATH += $$PWD/../../LAUSupportFiles/Support
+
+# ============================================================================
+# Build Directory Configuration - Place build artifacts outside repository
+# ============================================================================
+BUILD_ROOT = $$PWD/../../../build
+
+CONFIG(debug, debug|release) {
+    DESTDIR = $$BUILD_ROOT/$$TARGET-debug
+}
+
+CONFIG(release, debug|release) {
+    DESTDIR = $$BUILD_ROOT/$$TARGET-release
+}
+
+OBJECTS_DIR = $$DESTDIR/.obj
+MOC_DIR = $$DESTDIR/.moc
+
+SOURCES += \
+    tst_laulookuptable.cpp \
+    ../../LAUSupportFiles/Support/lauscan.cpp \
+    ../../LAUSupportFiles/Support/laulookuptable.cpp \
+    ../../LAUSupportFiles/Support/laumemoryobject.cpp
+
+HEADERS += \
+    ../../LAUSupportFiles/Support/lauscan.h \
+    ../../LAUSupportFiles/Support/laulookuptable.h \
+    ../../LAUSupportFiles/Support/laumemoryobject.h \
+    ../../LAUSupportFiles/Support/lauconstants.h
+
+win32 {
+    INCLUDEPATH += $$quote(C:/usr/Tiff/include)
+    DEPENDPATH  += $$quote(C:/usr/Tiff/include)
+    LIBS        += -L$$quote(C:/usr/Tiff/lib) -ltiff
+}
+unix:macx {
+    CONFIG += sdk_no_version_check
+    QMAKE_CXXFLAGS += -msse2 -msse3 -mssse3 -msse4.1
+    QMAKE_CXXFLAGS_WARN_ON += -Wno-reorder
+    INCLUDEPATH    += /usr/local/include/Tiff
+    DEPENDPATH     += /usr/local/include/Tiff
+    LIBS           += /usr/local/lib/libtiff.dylib
+}
+unix:!macx {
+    QMAKE_CXXFLAGS += -msse2 -msse3 -mssse3 -msse4.1
+    QMAKE_CXXFLAGS_WARN_ON += -Wno-reorder
+    LIBS           += -ltiff
+}
@@ -0,0 +1,1155 @@
+/*********************************************************************************
+ *                                                                               *
+ * Copyright (C) 2025 Dr. Daniel L. Lau                                          *
+ *                                                                               *
+ * This file is part of LAU 3D Video Inspection System.                         *
+ *                                                                               *
+ * LAU 3D Video Inspection System is free software: you can redistribute it     *
+ * and/or modify it under the terms of the GNU Lesser General Public License    *
+ * as published by the Free Software Foundation, either version 3 of the        *
+ * License, or (at your option) any later version.                              *
+ *                                                                               *
+ * LAU 3D Video Inspection System is distributed in the hope that it will be    *
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser      *
+ * General Public License for more details.                                     *
+ *                                                                               *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with LAU 3D Video Inspection System. If not, see                       *
+ * <https://www.gnu.org/licenses/>.                                             *
+ *                                                                               *
+ *********************************************************************************/
+
+#include <QtTest>
+#include <QDir>
+#include <QTemporaryDir>
+#include <QRandomGenerator>
+#include <QtMath>
+#include <QMutex>
+#include <QSet>
+
+#include "laumemoryobject.h"
+
+using namespace libtiff;
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// CHECKS THE PER-FRAME KERNELS OF LAUMEMORYOBJECT AGAINST THEIR REFERENCE BEHAVIOR
+class LAUMemoryObjectTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+
+    void saveRoundTrip_data();
+    void saveRoundTrip();
+    void packRoundTrip_data();
+    void packRoundTrip();
+    void stripHeight_data();
+    void stripHeight();
+    void stripHeightBenchmark_data();
+    void stripHeightBenchmark();
+    void stripsMatchScanlineWriter_data();
+    void stripsMatchScanlineWriter();
+    void codecBenchmark_data();
+    void codecBenchmark();
+
+    void detachMetaData();
+
+    void minAreaFilter_data();
+    void minAreaFilter();
+    void minAreaFilterBenchmark_data();
+    void minAreaFilterBenchmark();
+
+    void peakEnvelope_data();
+    void peakEnvelope();
+
+    void nonZeroPixelsCount_data();
+    void nonZeroPixelsCount();
+    void nonZeroPixelsCountBenchmark_data();
+    void nonZeroPixelsCountBenchmark();
+
+    void memoryObjectPool_data();
+    void memoryObjectPool();
+    void memoryObjectPoolBenchmark_data();
+    void memoryObjectPoolBenchmark();
+
+private:
+    LAUMemoryObjectSimd::Level defaultLevel;
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUMemoryObject randomObject(unsigned int cols, unsigned int rows, unsigned int chns, unsigned int byts, unsigned int frms, quint32 seed)
+{
+    // FILL EVERY BYTE SO THAT FLOAT OBJECTS ALSO CARRY NANS, INFINITIES AND SIGNED ZEROS
+    LAUMemoryObject object(cols, rows, chns, byts, frms);
+    QRandomGenerator generator(seed);
+    unsigned char *buffer = object.pointer();
+    for (unsigned long long n = 0; n < object.length(); n++) {
+        buffer[n] = (unsigned char)generator.bounded(256);
+    }
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUMemoryObject sparseObject(unsigned int cols, unsigned int rows, unsigned int chns, unsigned int byts, quint32 seed)
+{
+    // ABOUT A THIRD OF THE SAMPLES ARE ZERO, AND FLOAT OBJECTS ALSO CARRY NEGATIVE ZEROS AND NANS
+    LAUMemoryObject object(cols, rows, chns, byts, 1);
+    QRandomGenerator generator(seed);
+    unsigned long long samples = object.length() / byts;
+    for (unsigned long long n = 0; n < samples; n++) {
+        int choice = generator.bounded(12);
+        if (byts == sizeof(unsigned char)) {
+            ((unsigned char *)object.pointer())[n] = (choice < 4) ? 0 : (unsigned char)(1 + generator.bounded(255));
+        } else if (byts == sizeof(unsigned short)) {
+            ((unsigned short *)object.pointer())[n] = (choice < 4) ? 0 : (unsigned short)(1 + generator.bounded(65535));
+        } else {
+            float value = (float)((int)generator.bounded(20000) - 10000) / 7.0f;
+            if (choice < 3) {
+                value = 0.0f;
+            } else if (choice == 3) {
+                value = -0.0f;
+            } else if (choice == 4) {
+                value = NAN;
+            }
+            ((float *)object.pointer())[n] = value;
+        }
+    }
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUMemoryObject finiteObject(unsigned int cols, unsigned int rows, unsigned int chns, unsigned int frms, quint32 seed)
+{
+    // FLOAT OBJECT HOLDING ONLY FINITE VALUES AND POSITIVE ZEROS
+    LAUMemoryObject object(cols, rows, chns, sizeof(float), frms);
+    QRandomGenerator generator(seed);
+    float *buffer = (float *)object.pointer();
+    for (unsigned long long n = 0; n < object.length() / sizeof(float); n++) {
+        buffer[n] = (generator.bounded(8) == 0) ? 0.0f : (float)((int)generator.bounded(20000) - 10000) / 7.0f;
+    }
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUMemoryObject copyObject(const LAUMemoryObject &input)
+{
+    LAUMemoryObject object(input.width(), input.height(), input.colors(), input.depth(), input.frames());
+    memcpy(object.pointer(), input.constPointer(), input.length());
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// THE (2R+1)X(2R+1) SCAN THAT MINAREAFILTER USED BEFORE IT BECAME SEPARABLE, KEPT AS THE REFERENCE
+template<class T> static LAUMemoryObject minAreaFilterReference(const LAUMemoryObject &input, int rad)
+{
+    LAUMemoryObject object = copyObject(input);
+    for (unsigned int frm = 0; frm < input.frames(); frm++) {
+        for (int row = 0; row < (int)input.height(); row++) {
+            T *toBuffer = (T *)object.scanLine(row, frm);
+            for (int col = 0; col < (int)input.width(); col++) {
+                for (int dy = -rad; dy <= rad; dy++) {
+                    int rwp = qMin((int)input.height() - 1, qMax(0, row + dy));
+                    T *fmBuffer = (T *)input.constScanLine(rwp, frm);
+                    for (int dx = -rad; dx <= rad; dx++) {
+                        int clp = qMin((int)input.width() - 1, qMax(0, col + dx));
+                        for (unsigned int chn = 0; chn < input.colors(); chn++) {
+                            toBuffer[col * input.colors() + chn] = qMin(toBuffer[col * input.colors() + chn], fmBuffer[clp * input.colors() + chn]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUMemoryObject surfaceObject(unsigned int cols, unsigned int rows, quint32 seed)
+{
+    // 16-BIT DEPTH FRAME SHAPED LIKE A RECORDED SCAN, A TILTED PLANE WITH BUMPS, NOISE AND 0/65535 HOLES
+    LAUMemoryObject object(cols, rows, 1, sizeof(unsigned short), 1);
+    QRandomGenerator generator(seed);
+    for (unsigned int row = 0; row < rows; row++) {
+        unsigned short *buffer = (unsigned short *)object.scanLine(row);
+        for (unsigned int col = 0; col < cols; col++) {
+            double bump = 4000.0 * qCos((double)col / 5.0) * qSin((double)row / 7.0);
+            double value = 30000.0 + 150.0 * col - 80.0 * row + bump + (double)generator.bounded(64);
+            buffer[col] = (unsigned short)qBound(1.0, value, 65534.0);
+            if (generator.bounded(20) == 0) {
+                buffer[col] = (generator.bounded(2) == 0) ? 0 : 65535;
+            }
+        }
+    }
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// ONE LINE OF THE SCALAR PEAK ENVELOPE THAT PEAKENVELOPE AND PEAKENVELOPEINPLACE USED BEFORE THEY WERE
+// VECTORIZED, WITH CIRCLES REACHING OFFSETS -PIXELRADIUS THROUGH LASTOFFSET FROM THEIR OWN SAMPLE
+static void peakEnvelopeLineReference(unsigned short *samples, int count, int stride, float dx, float dy, float radius, int pixelRadius, int lastOffset)
+{
+    QVector<float> yVector(count, -1e6);
+    QVector<float> xVector(count, +1e6);
+
+    for (int ind = 0; ind < count; ind++) {
+        unsigned short pixel = samples[ind * stride];
+        if (pixel != 0 && pixel != 65535) {
+            QPointF pointA((float)ind * dx, (float)pixel * dy);
+            for (int deltaP = -pixelRadius; deltaP <= lastOffset; deltaP++) {
+                int indP = qMin(count - 1, qMax(0, ind + deltaP));
+                float deltaX = (float)(indP - ind) * dx;
+                float yCoord = pointA.y() + qSqrt((radius * radius) - (deltaX * deltaX));
+                yVector[indP] = qMax(yVector[indP], yCoord);
+            }
+        }
+    }
+
+    for (int ind = 0; ind < count; ind++) {
+        if (yVector[ind] > -1e5) {
+            QPointF pointA((float)ind * dx, yVector[ind]);
+            for (int deltaP = -pixelRadius; deltaP <= lastOffset; deltaP++) {
+                int indP = qMin(count - 1, qMax(0, ind + deltaP));
+                float deltaX = (float)(indP - ind) * dx;
+                float yCoord = pointA.y() - qSqrt((radius * radius) - (deltaX * deltaX));
+                xVector[indP] = qMin(xVector[indP], yCoord);
+            }
+        }
+    }
+
+    for (int ind = 0; ind < count; ind++) {
+        unsigned short pixel = samples[ind * stride];
+        if (pixel != 0 && pixel != 65535) {
+            samples[ind * stride] = (unsigned short)qMax(0.0f, qMin(65535.0f, xVector[ind] / dy));
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// PEAKENVELOPE ONLY EVER SCANNED ROWS AND STOPPED ITS CIRCLES ONE SAMPLE SHORT ON THE RIGHT, WHILE
+// PEAKENVELOPEINPLACE SCANS ROWS AND THEN COLUMNS, STEPPING COLUMNS BY WIDTH() SAMPLES RATHER THAN
+// BY STEP() BYTES AS THE OLD CODE DID
+static LAUMemoryObject peakEnvelopeReference(const LAUMemoryObject &input, float dx, float dy, float radius, bool inPlace)
+{
+    LAUMemoryObject object = copyObject(input);
+    int pixelRadius = (int)qFloor(radius / dx);
+    for (unsigned int frm = 0; frm < object.frames(); frm++) {
+        unsigned short *buffer = (unsigned short *)object.scanLine(0, frm);
+        for (unsigned int row = 0; row < object.height(); row++) {
+            peakEnvelopeLineReference(buffer + row * object.width(), (int)object.width(), 1, dx, dy, radius, pixelRadius, inPlace ? pixelRadius : pixelRadius - 1);
+        }
+        if (inPlace) {
+            for (unsigned int col = 0; col < object.width(); col++) {
+                peakEnvelopeLineReference(buffer + col, (int)object.height(), (int)object.width(), dx, dy, radius, pixelRadius, pixelRadius);
+            }
+        }
+    }
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::initTestCase()
+{
+    // SILENCE LIBTIFF SO ITS WARNINGS DON'T LAND ON STDERR
+    TIFFSetErrorHandler(myTIFFErrorHandler);
+    TIFFSetWarningHandler(myTIFFWarningHandler);
+
+    // REMEMBER THE LEVEL THE DISPATCHER PICKED SO TESTS THAT FORCE ANOTHER ONE CAN PUT IT BACK
+    defaultLevel = LAUMemoryObjectSimd::level();
+    qDebug() << "SIMD level" << LAUMemoryObjectSimd::toString(defaultLevel);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::cleanup()
+{
+    LAUMemoryObjectSimd::setLevel(defaultLevel);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::saveRoundTrip_data()
+{
+    QTest::addColumn<int>("depth");
+    QTest::addColumn<int>("colors");
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<QString>("codec");
+
+    QStringList codecs = QStringList() << "none" << "lzw" << "lzw+pack" << "deflate:6";
+    if (LAUMemoryObjectCodec(LAUMemoryObjectCodec::SchemeZSTD).isSupported()) {
+        codecs << "zstd";
+    }
+
+    for (int depth : { 1, 2, 4 }) {
+        for (int colors : { 1, 4 }) {
+            for (int threads : { 1, 2, 3, 8 }) {
+                for (const QString &codec : codecs) {
+                    QTest::addRow("%d byte %d channel %d threads %s", depth, colors, threads, qPrintable(codec)) << depth << colors << threads << codec;
+                }
+            }
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::saveRoundTrip()
+{
+    QFETCH(int, depth);
+    QFETCH(int, colors);
+    QFETCH(int, threads);
+    QFETCH(QString, codec);
+
+    // USE A ROW COUNT THAT LEAVES A SHORT LAST STRIP AND MORE STRIPS THAN THREADS
+    LAUMemoryObject object = randomObject(61, 103, colors, depth, 1, (quint32)(depth * 1000 + colors * 100 + threads));
+
+    QTemporaryDir temporaryDir;
+    QVERIFY(temporaryDir.isValid());
+    QString filename = QDir(temporaryDir.path()).absoluteFilePath("roundtrip.tif");
+
+    // COMPRESS THE STRIPS ON SEVERAL THREADS AND READ THE FILE BACK WITH THE ORDINARY LOADER
+    TIFF *outputTiff = TIFFOpen(filename.toLatin1(), "w");
+    QVERIFY(outputTiff != nullptr);
+    bool saved = object.save(outputTiff, LAUMEMORYOBJECTROWSPERSTRIP, threads, LAUMemoryObjectCodec::fromString(codec));
+    TIFFClose(outputTiff);
+    QVERIFY(saved);
+
+    LAUMemoryObject loaded(filename);
+    QCOMPARE(loaded.width(), object.width());
+    QCOMPARE(loaded.height(), object.height());
+    QCOMPARE(loaded.colors(), object.colors());
+    QCOMPARE(loaded.depth(), object.depth());
+    QVERIFY(memcmp(loaded.constPointer(), object.constPointer(), object.length()) == 0);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static qint64 writeRecording(QString filename, const QList<LAUMemoryObject> &frames, int rowsPerStrip, LAUMemoryObjectCodec codec = LAUMemoryObjectCodec())
+{
+    // WRITE THE FRAMES THE WAY THE SAVE TO DISK FILTER DOES AND RETURN THE SIZE OF THE FILE
+    TIFF *outputTiff = TIFFOpen(filename.toLatin1(), "w");
+    if (outputTiff == nullptr) {
+        return (-1);
+    }
+    for (int frame = 0; frame < frames.count(); frame++) {
+        if (frames.at(frame).save(outputTiff, rowsPerStrip, 1, codec) == false) {
+            TIFFClose(outputTiff);
+            return (-1);
+        }
+    }
+    TIFFClose(outputTiff);
+    return (QFileInfo(filename).size());
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::packRoundTrip_data()
+{
+    QTest::addColumn<QString>("codec");
+    QTest::addColumn<int>("depth");
+    QTest::addColumn<int>("shift");
+
+    // EVERY PACKING CODEC LIBTIFF CAN WRITE, ON EVERY SAMPLE SIZE; ONLY 16-BIT SAMPLES ARE
+    // SHIFTED, SO THE OTHER SIZES CHECK THAT PACKING LEAVES THEM ALONE
+    QList<LAUMemoryObjectCodec> codecs = LAUMemoryObjectCodec::availableCodecs();
+    for (int n = 0; n < codecs.count(); n++) {
+        if (codecs.at(n).pack() == false) {
+            continue;
+        }
+        QString codec = codecs.at(n).toString();
+        for (int depth : { 1, 2, 4, 8 }) {
+            for (int shift : { 0, 1, 2, 4, 8, 15 }) {
+                if (depth != sizeof(unsigned short) && shift > 0) {
+                    continue;
+                }
+                QTest::addRow("%s %d byte shift %d", qPrintable(codec), depth, shift) << codec << depth << shift;
+            }
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::packRoundTrip()
+{
+    QFETCH(QString, codec);
+    QFETCH(int, depth);
+    QFETCH(int, shift);
+
+    // CLEAR THE LOW ORDER BITS OF EVERY 16-BIT SAMPLE, AND MAKE SURE AT LEAST ONE SAMPLE
+    // HAS THE NEXT BIT SET SO THE WRITER CAN'T SHIFT ANY FURTHER THAN WE EXPECT
+    LAUMemoryObject object = randomObject(61, 103, 1, depth, 2, (quint32)(depth * 100 + shift));
+    if (depth == sizeof(unsigned short)) {
+        unsigned short *buffer = (unsigned short *)object.pointer();
+        for (unsigned long long n = 0; n < object.length() / sizeof(unsigned short); n++) {
+            buffer[n] = (unsigned short)(buffer[n] & (0xffff << shift));
+        }
+        buffer[0] = (unsigned short)(1 << shift);
+    }
+
+    QTemporaryDir temporaryDir;
+    QVERIFY(temporaryDir.isValid());
+    QString filename = QDir(temporaryDir.path()).absoluteFilePath("packed.tif");
+
+    // WRITE THE SAME OBJECT TWICE SO THE READER ALSO RESTORES THE SHIFT INTO A REUSED BUFFER
+    TIFF *outputTiff = TIFFOpen(filename.toLatin1(), "w");
+    QVERIFY(outputTiff != nullptr);
+    QVERIFY(object.save(outputTiff, LAUMEMORYOBJECTROWSPERSTRIP, 1, LAUMemoryObjectCodec::fromString(codec)));
+    QVERIFY(object.save(outputTiff, LAUMEMORYOBJECTROWSPERSTRIP, 4, LAUMemoryObjectCodec::fromString(codec)));
+    TIFFClose(outputTiff);
+
+    // ONLY A SHIFTED DIRECTORY CARRIES THE BIT SHIFT TAG
+    TIFF *inputTiff = TIFFOpen(filename.toLatin1(), "r");
+    QVERIFY(inputTiff != nullptr);
+    unsigned short bitShift = 0;
+    bool tagged = TIFFGetField(inputTiff, LAUMEMORYOBJECTTIFFTAG_BITSHIFT, &bitShift) != 0;
+    TIFFClose(inputTiff);
+    QCOMPARE(tagged, shift > 0);
+    QCOMPARE((int)bitShift, shift);
+
+    LAUMemoryObject loaded(filename);
+    QCOMPARE(loaded.depth(), object.depth());
+    QVERIFY(memcmp(loaded.constPointer(), object.constPointer(), object.length()) == 0);
+
+    LAUMemoryObjectReader reader(filename);
+    QCOMPARE(reader.directories(), 2);
+    LAUMemoryObject reused(object.width(), object.height(), object.colors(), object.depth(), object.frames());
+    for (int index = 0; index < reader.directories(); index++) {
+        QVERIFY(reader.readInto(reused, index));
+        QVERIFY(memcmp(reused.constPointer(), object.constPointer(), object.length()) == 0);
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::stripHeight_data()
+{
+    QTest::addColumn<int>("rowsPerStrip");
+
+    for (int rowsPerStrip : { 1, 4, 8, LAUMEMORYOBJECTROWSPERSTRIP, 64, 480 }) {
+        QTest::addRow("%d rows per strip", rowsPerStrip) << rowsPerStrip;
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::stripHeight()
+{
+    QFETCH(int, rowsPerStrip);
+
+    QTemporaryDir temporaryDir;
+    QVERIFY(temporaryDir.isValid());
+
+    // EVERY STRIP HEIGHT MUST READ BACK THE SAME PIXELS, AND NONE MAY BE LARGER THAN ONE ROW PER STRIP
+    QList<LAUMemoryObject> frames;
+    for (int frame = 0; frame < 4; frame++) {
+        frames << surfaceObject(640, 480, (quint32)frame + 1);
+    }
+    qint64 singleRowSize = writeRecording(QDir(temporaryDir.path()).absoluteFilePath("single.tif"), frames, 1);
+    qint64 size = writeRecording(QDir(temporaryDir.path()).absoluteFilePath("strips.tif"), frames, rowsPerStrip);
+    QVERIFY(singleRowSize > 0 && size > 0);
+    QVERIFY(size <= singleRowSize);
+    qDebug() << rowsPerStrip << "rows per strip" << size / frames.count() << "bytes per frame," << 100.0 * (double)size / (double)singleRowSize << "percent of one row per strip";
+
+    LAUMemoryObjectReader reader(QDir(temporaryDir.path()).absoluteFilePath("strips.tif"));
+    QCOMPARE(reader.directories(), frames.count());
+    for (int frame = 0; frame < frames.count(); frame++) {
+        LAUMemoryObject loaded = reader.read(frame);
+        QCOMPARE(loaded.length(), frames.at(frame).length());
+        QVERIFY(memcmp(loaded.constPointer(), frames.at(frame).constPointer(), loaded.length()) == 0);
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::stripHeightBenchmark_data()
+{
+    stripHeight_data();
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::stripHeightBenchmark()
+{
+    QFETCH(int, rowsPerStrip);
+
+    QTemporaryDir temporaryDir;
+    QVERIFY(temporaryDir.isValid());
+    QString filename = QDir(temporaryDir.path()).absoluteFilePath("benchmark.tif");
+
+    // ONE SECOND OF 30 FPS DEPTH VIDEO WITH THE DEFAULT CODEC
+    QList<LAUMemoryObject> frames;
+    for (int frame = 0; frame < 30; frame++) {
+        frames << surfaceObject(640, 480, (quint32)frame + 1);
+    }
+
+    qint64 size = 0;
+    QBENCHMARK {
+        size = writeRecording(filename, frames, rowsPerStrip);
+    }
+    QVERIFY(size > 0);
+    qDebug() << rowsPerStrip << "rows per strip" << size << "bytes";
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static QList<QByteArray> rawStrips(QString filename)
+{
+    // PULL THE STILL COMPRESSED BYTES OF EVERY STRIP OF THE FIRST DIRECTORY
+    QList<QByteArray> strips;
+    TIFF *inputTiff = TIFFOpen(filename.toLatin1(), "r");
+    if (inputTiff == nullptr) {
+        return (strips);
+    }
+    uint64_t *byteCounts = nullptr;
+    TIFFGetField(inputTiff, TIFFTAG_STRIPBYTECOUNTS, &byteCounts);
+    for (unsigned int strip = 0; byteCounts && strip < TIFFNumberOfStrips(inputTiff); strip++) {
+        QByteArray bytes((int)byteCounts[strip], 0);
+        TIFFReadRawStrip(inputTiff, strip, bytes.data(), bytes.size());
+        strips << bytes;
+    }
+    TIFFClose(inputTiff);
+    return (strips);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static bool writeScanlines(QString filename, const LAUMemoryObject &object, int rowsPerStrip, LAUMemoryObjectCodec codec)
+{
+    // THE WRITER SAVE() USED BEFORE IT HANDED STRIPS TO LIBTIFF STRAIGHT FROM THE
+    // OBJECT'S BUFFER: ONE SCRATCH COPY AND ONE TIFFWRITESCANLINE CALL PER ROW
+    TIFF *outputTiff = TIFFOpen(filename.toLatin1(), "w");
+    if (outputTiff == nullptr) {
+        return (false);
+    }
+    TIFFSetField(outputTiff, TIFFTAG_IMAGEWIDTH, (unsigned long)object.width());
+    TIFFSetField(outputTiff, TIFFTAG_IMAGELENGTH, (unsigned long)(object.height() * object.frames()));
+    TIFFSetField(outputTiff, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+    TIFFSetField(outputTiff, TIFFTAG_SAMPLESPERPIXEL, (unsigned short)object.colors());
+    TIFFSetField(outputTiff, TIFFTAG_BITSPERSAMPLE, (unsigned short)(8 * object.depth()));
+    TIFFSetField(outputTiff, TIFFTAG_PHOTOMETRIC, (object.colors() == 3) ? PHOTOMETRIC_RGB : ((object.colors() == 4) ? PHOTOMETRIC_SEPARATED : PHOTOMETRIC_MINISBLACK));
+    if (object.depth() == sizeof(float) || object.depth() == sizeof(double)) {
+        TIFFSetField(outputTiff, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_IEEEFP);
+    }
+    codec.apply(outputTiff);
+    TIFFSetField(outputTiff, TIFFTAG_ROWSPERSTRIP, (unsigned int)rowsPerStrip);
+
+    bool okay = true;
+    unsigned int cnt = 0;
+    unsigned char *tempBuffer = (unsigned char *)malloc(object.step());
+    for (unsigned int frm = 0; frm < object.frames(); frm++) {
+        for (unsigned int row = 0; row < object.height(); row++) {
+            memcpy(tempBuffer, object.constScanLine(row, frm), object.step());
+            okay &= (TIFFWriteScanline(outputTiff, tempBuffer, cnt++, 0) == 1);
+        }
+    }
+    free(tempBuffer);
+    okay &= (TIFFWriteDirectory(outputTiff) != 0);
+    TIFFClose(outputTiff);
+    return (okay);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::stripsMatchScanlineWriter_data()
+{
+    QTest::addColumn<QString>("codec");
+    QTest::addColumn<unsigned int>("colors");
+    QTest::addColumn<unsigned int>("depth");
+
+    // DEFLATE IS LEFT OUT BECAUSE LIBTIFF HANDS WHOLE STRIPS TO LIBDEFLATE BUT FEEDS
+    // SCANLINES THROUGH ZLIB, SO THE BYTES DIFFER EVEN THOUGH BOTH ARE LOSSLESS
+    QStringList codecs = QStringList() << "none" << "lzw";
+    if (LAUMemoryObjectCodec(LAUMemoryObjectCodec::SchemeZSTD).isSupported()) {
+        codecs << "zstd:3";
+    }
+    for (const QString &codec : codecs) {
+        for (unsigned int colors : { 1, 3, 4 }) {
+            for (unsigned int depth : { 1, 2, 4, 8 }) {
+                QTest::addRow("%s %ux%u", qPrintable(codec), colors, depth) << codec << colors << depth;
+            }
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::stripsMatchScanlineWriter()
+{
+    QFETCH(QString, codec);
+    QFETCH(unsigned int, colors);
+    QFETCH(unsigned int, depth);
+
+    QTemporaryDir temporaryDir;
+    QVERIFY(temporaryDir.isValid());
+
+    // TWO FRAMES OF 40 ROWS SO THAT THE THIRD 16-ROW STRIP SPANS THE FRAME BOUNDARY
+    LAUMemoryObject object = randomObject(67, 40, colors, depth, 2, 17 * colors + depth);
+    LAUMemoryObject original = copyObject(object);
+
+    QString scanlineFilename = QDir(temporaryDir.path()).absoluteFilePath("scanline.tif");
+    QVERIFY(writeScanlines(scanlineFilename, object, LAUMEMORYOBJECTROWSPERSTRIP, LAUMemoryObjectCodec::fromString(codec)));
+    QList<QByteArray> expected = rawStrips(scanlineFilename);
+    QCOMPARE(expected.count(), (80 + LAUMEMORYOBJECTROWSPERSTRIP - 1) / LAUMEMORYOBJECTROWSPERSTRIP);
+
+    // THE SINGLE AND MULTI-THREADED STRIP WRITERS MUST PRODUCE THE SAME BYTES AS THE SCANLINE WRITER
+    for (int threads : { 1, 4 }) {
+        QString filename = QDir(temporaryDir.path()).absoluteFilePath(QString("strips%1.tif").arg(threads));
+        TIFF *outputTiff = TIFFOpen(filename.toLatin1(), "w");
+        QVERIFY(outputTiff != nullptr);
+        QVERIFY(object.save(outputTiff, LAUMEMORYOBJECTROWSPERSTRIP, threads, LAUMemoryObjectCodec::fromString(codec)));
+        TIFFClose(outputTiff);
+
+        QList<QByteArray> strips = rawStrips(filename);
+        QCOMPARE(strips.count(), expected.count());
+        for (int strip = 0; strip < strips.count(); strip++) {
+            QVERIFY2(strips.at(strip) == expected.at(strip), qPrintable(QString("threads %1 strip %2").arg(threads).arg(strip)));
+        }
+    }
+
+    // AND NEITHER OF THEM MAY TOUCH THE SOURCE BUFFER
+    QVERIFY(memcmp(object.constPointer(), original.constPointer(), object.length()) == 0);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::codecBenchmark_data()
+{
+    QTest::addColumn<QString>("codec");
+    QTest::addColumn<bool>("encode");
+
+    QList<LAUMemoryObjectCodec> codecs = LAUMemoryObjectCodec::availableCodecs();
+    for (int n = 0; n < codecs.count(); n++) {
+        QTest::addRow("%s encode", qPrintable(codecs.at(n).toString())) << codecs.at(n).toString() << true;
+        QTest::addRow("%s decode", qPrintable(codecs.at(n).toString())) << codecs.at(n).toString() << false;
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::codecBenchmark()
+{
+    QFETCH(QString, codec);
+    QFETCH(bool, encode);
+
+    QTemporaryDir temporaryDir;
+    QVERIFY(temporaryDir.isValid());
+    QString filename = QDir(temporaryDir.path()).absoluteFilePath("codec.tif");
+
+    // THIRTY DEPTH FRAMES WITH THE TWO LOW BITS CLEARED LIKE THE ORBBEC CAMERA SO PACKING HAS SOMETHING TO DROP
+    QList<LAUMemoryObject> frames;
+    for (int frame = 0; frame < 30; frame++) {
+        LAUMemoryObject object = surfaceObject(640, 480, (quint32)frame + 1);
+        unsigned short *buffer = (unsigned short *)object.constPointer();
+        for (unsigned int n = 0; n < object.width() * object.height(); n++) {
+            buffer[n] &= 0xfffc;
+        }
+        frames << object;
+    }
+    qint64 rawBytes = (qint64)frames.count() * frames.first().length();
+
+    qint64 size = 0;
+    if (encode) {
+        QBENCHMARK {
+            size = writeRecording(filename, frames, LAUMEMORYOBJECTROWSPERSTRIP, LAUMemoryObjectCodec::fromString(codec));
+        }
+    } else {
+        size = writeRecording(filename, frames, LAUMEMORYOBJECTROWSPERSTRIP, LAUMemoryObjectCodec::fromString(codec));
+        LAUMemoryObject loaded(640, 480, 1, sizeof(unsigned short), 1);
+        QBENCHMARK {
+            LAUMemoryObjectReader reader(filename);
+            for (int frame = 0; frame < frames.count(); frame++) {
+                reader.readInto(loaded, frame);
+            }
+        }
+    }
+    QVERIFY(size > 0);
+    qDebug() << codec << "ratio" << (double)rawBytes / (double)size;
+
+    // EVERY CODEC IS LOSSLESS
+    LAUMemoryObjectReader reader(filename);
+    QCOMPARE(reader.directories(), frames.count());
+    for (int frame = 0; frame < frames.count(); frame++) {
+        LAUMemoryObject loaded = reader.read(frame);
+        QVERIFY(memcmp(loaded.constPointer(), frames.at(frame).constPointer(), loaded.length()) == 0);
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::detachMetaData()
+{
+    LAUMemoryObject objectA = randomObject(640, 480, 1, sizeof(unsigned short), 1, 25);
+    objectA.setRFID(QString("A"));
+    objectA.setXML(QByteArray("<a/>"));
+    QByteArray pixels((const char *)objectA.constPointer(), (int)objectA.length());
+
+    // TAGGING A SHARED COPY ONLY COPIES THE METADATA, SO BOTH OBJECTS KEEP LOOKING AT THE SAME PIXELS
+    int buffers = LAUMemoryObjectData::instanceCounter;
+    LAUMemoryObject objectB = objectA;
+    objectB.setRFID(QString("B"));
+    objectB.setXML(QByteArray("<b/>"));
+    QCOMPARE(objectA.constPointer(), objectB.constPointer());
+    QCOMPARE(LAUMemoryObjectData::instanceCounter, buffers);
+    QCOMPARE(objectA.rfid(), QString("A"));
+    QCOMPARE(objectB.rfid(), QString("B"));
+    QCOMPARE(objectA.xml(), QByteArray("<a/>"));
+    QCOMPARE(objectB.xml(), QByteArray("<b/>"));
+
+    // THE FIRST WRITE THROUGH SCANLINE() GIVES THE WRITER ITS OWN PIXELS AND LEAVES THE OTHER OBJECT ALONE
+    unsigned short *buffer = (unsigned short *)objectB.scanLine(0);
+    buffer[0] = (unsigned short)(buffer[0] + 1);
+    QVERIFY(objectA.constPointer() != objectB.constPointer());
+    QCOMPARE(LAUMemoryObjectData::instanceCounter, buffers + 1);
+    QVERIFY(memcmp(objectA.constPointer(), pixels.constData(), pixels.size()) == 0);
+    QCOMPARE(((unsigned short *)objectB.constPointer())[0], buffer[0]);
+    QVERIFY(memcmp(objectB.constPointer() + sizeof(unsigned short), pixels.constData() + sizeof(unsigned short), pixels.size() - sizeof(unsigned short)) == 0);
+
+    // AN OBJECT THAT NO LONGER SHARES ITS PIXELS WRITES IN PLACE
+    const unsigned char *pointer = objectB.constPointer();
+    QCOMPARE((const unsigned char *)objectB.scanLine(1), pointer + objectB.step());
+    QCOMPARE(LAUMemoryObjectData::instanceCounter, buffers + 1);
+
+    // THE IN PLACE TRANSFORMS TAKE THEIR OWN PIXELS BEFORE TOUCHING SHARED ONES
+    LAUMemoryObject objectC = objectA;
+    objectC.rotate180InPlace();
+    QVERIFY(objectC.constPointer() != objectA.constPointer());
+    QVERIFY(memcmp(objectA.constPointer(), pixels.constData(), pixels.size()) == 0);
+    objectC.rotate180InPlace();
+    QVERIFY(memcmp(objectC.constPointer(), pixels.constData(), pixels.size()) == 0);
+
+    // COPIES OF THE SAME HANDLE ARE EQUAL, BUT A COPY WITH ITS OWN METADATA IS A DIFFERENT FRAME
+    LAUMemoryObject objectD = objectA;
+    QVERIFY(objectD == objectA);
+    objectD.setElapsed(7);
+    QCOMPARE(objectD.constPointer(), objectA.constPointer());
+    QVERIFY((objectD == objectA) == false);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::minAreaFilter_data()
+{
+    QTest::addColumn<int>("depth");
+    QTest::addColumn<int>("colors");
+    QTest::addColumn<int>("radius");
+    QTest::addColumn<bool>("special");
+
+    // FLOAT FRAMES WITH NANS OR NEGATIVE ZEROS TAKE THE ORDERED FALLBACK SCAN, THE REST THE SEPARABLE FILTER
+    for (int radius = 1; radius <= 15; radius++) {
+        for (int colors : { 1, 3 }) {
+            QTest::addRow("8-bit %d channel radius %d", colors, radius) << 1 << colors << radius << false;
+            QTest::addRow("16-bit %d channel radius %d", colors, radius) << 2 << colors << radius << false;
+            QTest::addRow("float %d channel radius %d", colors, radius) << 4 << colors << radius << false;
+            QTest::addRow("float nan %d channel radius %d", colors, radius) << 4 << colors << radius << true;
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::minAreaFilter()
+{
+    QFETCH(int, depth);
+    QFETCH(int, colors);
+    QFETCH(int, radius);
+    QFETCH(bool, special);
+
+    // KEEP THE FRAME SMALLER THAN THE WINDOW AT LARGE RADII SO EVERY PIXEL IS AN EDGE PIXEL THERE
+    quint32 seed = (quint32)(depth * 10000 + colors * 100 + radius);
+    LAUMemoryObject input;
+    if (depth == sizeof(float) && special == false) {
+        input = finiteObject(37, 23, colors, 2, seed);
+    } else {
+        input = randomObject(37, 23, colors, depth, 2, seed);
+        if (special) {
+            float *buffer = (float *)input.pointer();
+            buffer[5] = -0.0f;
+            buffer[17] = NAN;
+        }
+    }
+
+    LAUMemoryObject result = input.minAreaFilter(radius);
+    LAUMemoryObject reference;
+    if (depth == sizeof(unsigned char)) {
+        reference = minAreaFilterReference<unsigned char>(input, radius);
+    } else if (depth == sizeof(unsigned short)) {
+        reference = minAreaFilterReference<unsigned short>(input, radius);
+    } else {
+        reference = minAreaFilterReference<float>(input, radius);
+    }
+
+    QCOMPARE(result.length(), reference.length());
+    QVERIFY(memcmp(result.constPointer(), reference.constPointer(), reference.length()) == 0);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::minAreaFilterBenchmark_data()
+{
+    QTest::addColumn<int>("depth");
+    QTest::addColumn<int>("radius");
+
+    for (int depth : { 1, 2, 4 }) {
+        for (int radius : { 1, 2, 4, 8, 15 }) {
+            QTest::addRow("%d byte radius %d", depth, radius) << depth << radius;
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::minAreaFilterBenchmark()
+{
+    QFETCH(int, depth);
+    QFETCH(int, radius);
+
+    // A 640X480 DEPTH FRAME, WHICH SHOULD COST ABOUT THE SAME AT EVERY RADIUS
+    LAUMemoryObject input = (depth == sizeof(float)) ? finiteObject(640, 480, 1, 1, 1) : randomObject(640, 480, 1, depth, 1, 1);
+    QBENCHMARK {
+        LAUMemoryObject result = input.minAreaFilter(radius);
+        Q_UNUSED(result);
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::peakEnvelope_data()
+{
+    QTest::addColumn<LAUMemoryObject>("input");
+    QTest::addColumn<float>("dx");
+    QTest::addColumn<float>("dy");
+    QTest::addColumn<float>("radius");
+
+    // RANDOM FRAMES AND SMOOTH SURFACES, WIDE AND TALL SO THE COLUMN PASS RUNS LONGER THAN A ROW
+    QList<QSize> sizes = { QSize(64, 48), QSize(48, 64), QSize(17, 5), QSize(3, 1) };
+    // EACH SETTING IS DX, DY AND RADIUS
+    QList<QList<float>> settings = { { 1.0f, 0.01f, 2.0f }, { 0.5f, 0.01f, 7.5f }, { 1.0f, 0.05f, 20.0f }, { 2.0f, 0.01f, 1.0f } };
+    for (const QSize &size : sizes) {
+        for (const QList<float> &setting : settings) {
+            quint32 seed = (quint32)(size.width() * 100 + size.height());
+            QTest::addRow("random %dx%d radius %g", size.width(), size.height(), setting[2]) << randomObject(size.width(), size.height(), 1, sizeof(unsigned short), 2, seed) << setting[0] << setting[1] << setting[2];
+            QTest::addRow("surface %dx%d radius %g", size.width(), size.height(), setting[2]) << surfaceObject(size.width(), size.height(), seed) << setting[0] << setting[1] << setting[2];
+        }
+    }
+
+    // A RECORDED 16-BIT DEPTH VIDEO CAN BE ADDED THROUGH THE LAUPEAKENVELOPERECORDING ENVIRONMENT VARIABLE
+    QString filename = qEnvironmentVariable("LAUPEAKENVELOPERECORDING");
+    if (filename.isEmpty() == false) {
+        LAUMemoryObject recording(filename, 0);
+        if (recording.colors() == 1 && recording.depth() == sizeof(unsigned short)) {
+            for (const QList<float> &setting : settings) {
+                QTest::addRow("recording radius %g", setting[2]) << recording << setting[0] << setting[1] << setting[2];
+            }
+        } else {
+            qDebug() << "Skipping recording" << filename << "because it is not a 16-bit single channel video.";
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::peakEnvelope()
+{
+    QFETCH(LAUMemoryObject, input);
+    QFETCH(float, dx);
+    QFETCH(float, dy);
+    QFETCH(float, radius);
+
+    LAUMemoryObject envelope = input.peakEnvelope(dx, dy, radius);
+    LAUMemoryObject reference = peakEnvelopeReference(input, dx, dy, radius, false);
+    QCOMPARE(envelope.length(), reference.length());
+    QVERIFY(memcmp(envelope.constPointer(), reference.constPointer(), reference.length()) == 0);
+
+    LAUMemoryObject inPlace = copyObject(input);
+    inPlace.peakEnvelopeInPlace(dx, dy, radius);
+    reference = peakEnvelopeReference(input, dx, dy, radius, true);
+    QVERIFY(memcmp(inPlace.constPointer(), reference.constPointer(), reference.length()) == 0);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::nonZeroPixelsCount_data()
+{
+    QTest::addColumn<int>("depth");
+    QTest::addColumn<int>("colors");
+    QTest::addColumn<QSize>("size");
+
+    // THE KERNELS WORK IN SIXTEEN BYTE BLOCKS, SO EVERY FRAME HERE IS A WHOLE NUMBER OF BLOCKS LONG
+    QList<QSize> sizes = { QSize(16, 1), QSize(48, 5), QSize(64, 48), QSize(640, 480) };
+    for (int depth : { 1, 2, 4 }) {
+        for (int colors : { 1, 4 }) {
+            for (const QSize &size : sizes) {
+                QTest::addRow("%d byte %d channel %dx%d", depth, colors, size.width(), size.height()) << depth << colors << size;
+            }
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::nonZeroPixelsCount()
+{
+    QFETCH(int, depth);
+    QFETCH(int, colors);
+    QFETCH(QSize, size);
+
+    LAUMemoryObject object = sparseObject(size.width(), size.height(), colors, depth, (quint32)(depth * 100 + colors));
+
+    // COUNT THE SAMPLES ONE AT A TIME, WHERE NEGATIVE ZERO IS ZERO AND NAN IS NOT
+    unsigned int reference = 0;
+    for (unsigned long long n = 0; n < object.length() / depth; n++) {
+        if (depth == sizeof(unsigned char)) {
+            reference += (((unsigned char *)object.constPointer())[n] != 0);
+        } else if (depth == sizeof(unsigned short)) {
+            reference += (((unsigned short *)object.constPointer())[n] != 0);
+        } else {
+            reference += (((float *)object.constPointer())[n] != 0.0f);
+        }
+    }
+
+    // EVERY LEVEL THIS CPU SUPPORTS HAS TO GIVE THE SAME COUNT
+    for (int lvl = LAUMemoryObjectSimd::LevelSSE; lvl <= LAUMemoryObjectSimd::supportedLevel(); lvl++) {
+        QVERIFY(LAUMemoryObjectSimd::setLevel((LAUMemoryObjectSimd::Level)lvl));
+        QCOMPARE(object.nonZeroPixelsCount(), reference);
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::nonZeroPixelsCountBenchmark_data()
+{
+    QTest::addColumn<int>("level");
+    QTest::addColumn<int>("depth");
+
+    for (int lvl = LAUMemoryObjectSimd::LevelSSE; lvl <= LAUMemoryObjectSimd::supportedLevel(); lvl++) {
+        QString name = LAUMemoryObjectSimd::toString((LAUMemoryObjectSimd::Level)lvl);
+        for (int depth : { 1, 2, 4 }) {
+            QTest::addRow("%s %d byte", qPrintable(name), depth) << lvl << depth;
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::nonZeroPixelsCountBenchmark()
+{
+    QFETCH(int, level);
+    QFETCH(int, depth);
+
+    LAUMemoryObject object = sparseObject(640, 480, 1, depth, 1);
+    QVERIFY(LAUMemoryObjectSimd::setLevel((LAUMemoryObjectSimd::Level)level));
+    unsigned int count = 0;
+    QBENCHMARK {
+        count = object.nonZeroPixelsCount();
+    }
+    QVERIFY(count <= 640 * 480);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static int cyclePool(LAUMemoryObjectPool *pool, int cycles, QMutex *mutex, QSet<const void *> *inUse, quint32 stamp)
+{
+    // ACQUIRE AND RELEASE OVER AND OVER, COUNTING ANY BUFFER THAT IS ALREADY OUT
+    // WITH ANOTHER THREAD OR WHOSE STAMP IS OVERWRITTEN WHILE WE HOLD IT
+    int collisions = 0;
+    for (int cycle = 0; cycle < cycles; cycle++) {
+        LAUMemoryObject object = pool->acquire();
+        if (object.isNull()) {
+            collisions++;
+            continue;
+        }
+
+        const void *address = object.constPointer();
+        if (inUse) {
+            QMutexLocker locker(mutex);
+            if (inUse->contains(address)) {
+                collisions++;
+            }
+            inUse->insert(address);
+        }
+
+        quint32 *buffer = (quint32 *)object.pointer();
+        buffer[0] = stamp;
+        buffer[1] = (quint32)cycle;
+        QThread::yieldCurrentThread();
+        if (buffer[0] != stamp || buffer[1] != (quint32)cycle) {
+            collisions++;
+        }
+
+        if (inUse) {
+            QMutexLocker locker(mutex);
+            inUse->remove(address);
+        }
+        pool->release(object);
+    }
+    return (collisions);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::memoryObjectPool_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("workers");
+
+    // A POOL WITH A BUFFER FOR EVERY WORKER NEVER RUNS DRY, A SMALL ONE FALLS BACK TO THE HEAP
+    QTest::newRow("40 buffers 8 threads") << MINNUMBEROFFRAMESAVAILABLE << 8;
+    QTest::newRow("4 buffers 8 threads") << 4 << 8;
+    QTest::newRow("1 buffer 4 threads") << 1 << 4;
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::memoryObjectPool()
+{
+    QFETCH(int, size);
+    QFETCH(int, workers);
+
+    LAUMemoryObjectPool pool(64, 48, 1, sizeof(unsigned short), 1, size);
+    QVERIFY(pool.isValid());
+    QCOMPARE(pool.available(), size);
+
+    // EVERY WORKER GETS ITS OWN THREAD SO THE RING IS HIT FROM ALL OF THEM AT ONCE
+    QMutex mutex;
+    QSet<const void *> inUse;
+    QList<QThread *> threads;
+    QAtomicInt collisions(0);
+    for (int worker = 0; worker < workers; worker++) {
+        threads << QThread::create([&pool, &mutex, &inUse, &collisions, worker]() {
+            collisions.fetchAndAddOrdered(cyclePool(&pool, 20000, &mutex, &inUse, (quint32)worker + 1));
+        });
+    }
+    for (QThread *thread : threads) {
+        thread->start();
+    }
+    for (QThread *thread : threads) {
+        QVERIFY(thread->wait(60000));
+        delete thread;
+    }
+
+    QCOMPARE(collisions.loadAcquire(), 0);
+    QVERIFY(inUse.isEmpty());
+
+    // EVERY BUFFER COMES BACK, AND ONLY A POOL SMALLER THAN THE NUMBER OF WORKERS HAS TO ALLOCATE
+    QVERIFY(pool.available() >= size);
+    QVERIFY(pool.available() <= pool.capacity());
+    if (size >= workers) {
+        QCOMPARE(pool.misses(), 0);
+    }
+
+    // WHAT COMES OUT OF THE DRAINED POOL ARE DISTINCT BUFFERS OF THE POOL'S SHAPE
+    QSet<const void *> drained;
+    int available = pool.available();
+    QList<LAUMemoryObject> objects;
+    for (int n = 0; n < available; n++) {
+        objects << pool.acquire();
+        QVERIFY(pool.matches(objects.last()));
+        drained.insert(objects.last().constPointer());
+    }
+    QCOMPARE(drained.count(), available);
+    QCOMPARE(pool.available(), 0);
+
+    // A BUFFER OF ANOTHER SHAPE IS NEVER TAKEN IN
+    QVERIFY(pool.release(LAUMemoryObject(32, 48, 1, sizeof(unsigned short), 1)) == false);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::memoryObjectPoolBenchmark_data()
+{
+    QTest::addColumn<bool>("pooled");
+    QTest::addColumn<int>("workers");
+
+    QTest::newRow("heap 1 thread") << false << 1;
+    QTest::newRow("pool 1 thread") << true << 1;
+    QTest::newRow("heap 4 threads") << false << 4;
+    QTest::newRow("pool 4 threads") << true << 4;
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectTest::memoryObjectPoolBenchmark()
+{
+    QFETCH(bool, pooled);
+    QFETCH(int, workers);
+
+    // 1000 ACQUIRE AND RELEASE PAIRS PER WORKER OF A 640X480 FLOAT FRAME, AGAINST ALLOCATING IT EVERY TIME
+    LAUMemoryObjectPool pool(640, 480, 1, sizeof(float), 1, MINNUMBEROFFRAMESAVAILABLE);
+    QList<int> workerList;
+    for (int worker = 0; worker < workers; worker++) {
+        workerList << worker;
+    }
+
+    QBENCHMARK {
+        QtConcurrent::blockingMap(workerList, [&pool, pooled](const int &worker) {
+            if (pooled) {
+                cyclePool(&pool, 1000, nullptr, nullptr, (quint32)worker + 1);
+            } else {
+                for (int cycle = 0; cycle < 1000; cycle++) {
+                    LAUMemoryObject object(640, 480, 1, sizeof(float), 1);
+                    ((quint32 *)object.pointer())[0] = (quint32)worker + 1;
+                }
+            }
+        });
+    }
+    QCOMPARE(pool.misses(), 0);
+}
+
+QTEST_GUILESS_MAIN(LAUMemoryObjectTest)
+
+#include "tst_laumemoryobject.moc"
@@ -0,0 +1,54 @@
+QT = core xml concurrent testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+# Define HEADLESS to disable QImage and other GUI dependencies in LAU support libraries
+DEFINES += HEADLESS
+
+TARGET = tst_laumemoryobject
+TEMPLATE = app
+
+INCLUDEPATH += $$PWD/../../LAUSupportFiles/Support
+
+# ============================================================================
+# Build Directory Configuration - Place build artifacts outside repository
+# ============================================================================
+BUILD_ROOT = $$PWD/../../../build
+
+CONFIG(debug, debug|release) {
+    DESTDIR = $$BUILD_ROOT/$$TARGET-debug
+}
+
+CONFIG(release, debug|release) {
+    DESTDIR = $$BUILD_ROOT/$$TARGET-release
+}
+
+OBJECTS_DIR = $$DESTDIR/.obj
+MOC_DIR = $$DESTDIR/.moc
+
+SOURCES += \
+    tst_laumemoryobject.cpp \
+    ../../LAUSupportFiles/Support/laumemoryobject.cpp
+
+HEADERS += \
+    ../../LAUSupportFiles/Support/laumemoryobject.h
+
+win32 {
+    INCLUDEPATH += $$quote(C:/usr/Tiff/include)
+    DEPENDPATH  += $$quote(C:/usr/Tiff/include)
+    LIBS        += -L$$quote(C:/usr/Tiff/lib) -ltiff
+}
+unix:macx {
+    CONFIG += sdk_no_version_check
+    QMAKE_CXXFLAGS += -msse2 -msse3 -mssse3 -msse4.1
+    QMAKE_CXXFLAGS_WARN_ON += -Wno-reorder
+    INCLUDEPATH    += /usr/local/include/Tiff
+    DEPENDPATH     += /usr/local/include/Tiff
+    LIBS           += /usr/local/lib/libtiff.dylib
+}
+unix:!macx {
+    QMAKE_CXXFLAGS += -msse2 -msse3 -mssse3 -msse4.1
+    QMAKE_CXXFLAGS_WARN_ON += -Wno-reorder
+    LIBS           += -ltiff
+}
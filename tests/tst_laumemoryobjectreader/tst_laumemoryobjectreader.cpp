@@ -0,0 +1,376 @@
+/*********************************************************************************
+ *                                                                               *
+ * Copyright (C) 2025 Dr. Daniel L. Lau                                          *
+ *                                                                               *
+ * This file is part of LAU 3D Video Inspection System.                         *
+ *                                                                               *
+ * LAU 3D Video Inspection System is free software: you can redistribute it     *
+ * and/or modify it under the terms of the GNU Lesser General Public License    *
+ * as published by the Free Software Foundation, either version 3 of the        *
+ * License, or (at your option) any later version.                              *
+ *                                                                               *
+ * LAU 3D Video Inspection System is distributed in the hope that it will be    *
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser      *
+ * General Public License for more details.                                     *
+ *                                                                               *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with LAU 3D Video Inspection System. If not, see                       *
+ * <https://www.gnu.org/licenses/>.                                             *
+ *                                                                               *
+ *********************************************************************************/
+
+#include <QtTest>
+#include <QDir>
+#include <QTemporaryDir>
+#include <QRandomGenerator>
+
+#include "laumemoryobject.h"
+
+using namespace libtiff;
+
+#define TESTREADERFRAMES    500
+#define TESTMETADATAFRAMES  100
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// CHECKS LAUMEMORYOBJECTREADER AGAINST OPENING THE RECORDING ONCE PER FRAME
+class LAUMemoryObjectReaderTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void readMatchesReopen();
+    void staleIndexRebuilt();
+    void truncatedRecordingReadable();
+    void fullPassBenchmark_data();
+    void fullPassBenchmark();
+    void metaDataMatchesLoad();
+    void metaDataBenchmark_data();
+    void metaDataBenchmark();
+
+private:
+    QTemporaryDir temporaryDir;
+    QString recordingFilename;
+    QString metaDataFilename;
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUMemoryObject syntheticFrame(int frame)
+{
+    // A SMALL 16-BIT DEPTH FRAME THAT IS DIFFERENT FOR EVERY DIRECTORY OF THE RECORDING
+    LAUMemoryObject object(64, 48, 1, sizeof(unsigned short), 1);
+    QRandomGenerator generator((quint32)frame + 1);
+    for (unsigned int row = 0; row < object.height(); row++) {
+        unsigned short *buffer = (unsigned short *)object.scanLine(row);
+        for (unsigned int col = 0; col < object.width(); col++) {
+            buffer[col] = (unsigned short)(1000 + 10 * row + col + generator.bounded(16));
+        }
+    }
+    object.setRFID(QString("frame%1").arg(frame, 5, 10, QChar('0')));
+    object.setElapsed((unsigned int)(33 * frame));
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static QString writeRecording(QString filename, int frames)
+{
+    TIFF *outputTiff = TIFFOpen(filename.toLatin1(), "w");
+    if (outputTiff == nullptr) {
+        return (QString());
+    }
+    for (int frame = 0; frame < frames; frame++) {
+        if (syntheticFrame(frame).save(outputTiff) == false) {
+            TIFFClose(outputTiff);
+            return (QString());
+        }
+    }
+    TIFFClose(outputTiff);
+    return (filename);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUMemoryObject taggedFrame(int frame)
+{
+    // A FULL SIZE DEPTH FRAME CARRYING EVERYTHING THE OBJECT ID ENCODER LOOKS AT: AN RFID, AN
+    // ELAPSED TIME, AN ANCHOR, AND AN XML PACKET WITH AN OBJECT ID AND A JETR VECTOR
+    LAUMemoryObject object(640, 480, 1, sizeof(unsigned short), 1);
+    QRandomGenerator generator((quint32)frame + 1);
+    for (unsigned int row = 0; row < object.height(); row++) {
+        unsigned short *buffer = (unsigned short *)object.scanLine(row);
+        for (unsigned int col = 0; col < object.width(); col++) {
+            buffer[col] = (unsigned short)(1000 + row + col + generator.bounded(64));
+        }
+    }
+
+    QVector<double> jetrVector(37, 0.0);
+    for (int n = 0; n < jetrVector.count(); n++) {
+        jetrVector[n] = 0.5 * n + frame;
+    }
+    object.setJetr(jetrVector);
+
+    QHash<QString, QString> hashTable;
+    hashTable["ObjectID"] = QString("982000411111111");
+    hashTable["OriginalFrameOrder"] = QString::number(frame);
+    object.setXML(LAUMemoryObject::hashToXml(hashTable));
+
+    object.setRFID(QString("982000411111111"));
+    object.setAnchor(QPoint(100 + 3 * frame, 240));
+    object.setElapsed((unsigned int)(33 * frame));
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectReaderTest::initTestCase()
+{
+    // SILENCE LIBTIFF SO ITS WARNINGS DON'T LAND ON STDERR
+    TIFFSetErrorHandler(myTIFFErrorHandler);
+    TIFFSetWarningHandler(myTIFFWarningHandler);
+
+    QVERIFY(temporaryDir.isValid());
+    recordingFilename = writeRecording(QDir(temporaryDir.path()).absoluteFilePath("recording.tif"), TESTREADERFRAMES);
+    QVERIFY(recordingFilename.isEmpty() == false);
+
+    QList<LAUMemoryObject> objects;
+    for (int frame = 0; frame < TESTMETADATAFRAMES; frame++) {
+        objects << taggedFrame(frame);
+    }
+    metaDataFilename = QDir(temporaryDir.path()).absoluteFilePath("tagged.tif");
+    QVERIFY(LAUMemoryObject::saveObjectsToDisk(objects, metaDataFilename));
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectReaderTest::readMatchesReopen()
+{
+    LAUMemoryObjectReader reader(recordingFilename);
+    QVERIFY(reader.isValid());
+    QCOMPARE(reader.directories(), TESTREADERFRAMES);
+
+    // EVERY FRAME HANDED OUT IN SEQUENCE MUST EQUAL THE SAME FRAME LOADED BY REOPENING THE FILE
+    int frame = 0;
+    while (reader.atEnd() == false) {
+        LAUMemoryObject streamed = reader.readNext();
+        LAUMemoryObject reopened(recordingFilename, frame);
+        QVERIFY(streamed.isValid());
+        QCOMPARE(streamed.length(), reopened.length());
+        QVERIFY(memcmp(streamed.constPointer(), reopened.constPointer(), reopened.length()) == 0);
+        QCOMPARE(streamed.rfid(), reopened.rfid());
+        QCOMPARE(streamed.elapsed(), reopened.elapsed());
+        frame++;
+    }
+    QCOMPARE(frame, TESTREADERFRAMES);
+
+    // RANDOM ACCESS GOES STRAIGHT TO THE REQUESTED DIRECTORY, BACKWARDS AS WELL AS FORWARDS
+    for (int index : { 417, 3, 499, 0, 250 }) {
+        LAUMemoryObject object = reader.read(index);
+        QCOMPARE(object.rfid(), syntheticFrame(index).rfid());
+        QVERIFY(memcmp(object.constPointer(), syntheticFrame(index).constPointer(), object.length()) == 0);
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectReaderTest::staleIndexRebuilt()
+{
+    QString filename = writeRecording(QDir(temporaryDir.path()).absoluteFilePath("stale.tif"), 10);
+    QVERIFY(filename.isEmpty() == false);
+
+    // THE FIRST CACHED OPEN WALKS THE FILE AND LEAVES A SIDECAR INDEX BEHIND
+    LAUMemoryObjectReader reader(filename, true);
+    QCOMPARE(reader.directories(), 10);
+    QVERIFY(reader.isCurrent());
+    QVERIFY(QFile::exists(LAUMemoryObjectReader::indexFilename(filename)));
+    QCOMPARE(LAUMemoryObjectReader::cachedOffsets(filename).count(), 10);
+
+    // APPENDING FRAMES CHANGES THE SIZE SO BOTH THE SIDECAR AND THE OPEN READER ARE STALE
+    TIFF *outputTiff = TIFFOpen(filename.toLatin1(), "a");
+    QVERIFY(outputTiff != nullptr);
+    for (int frame = 10; frame < 15; frame++) {
+        QVERIFY(syntheticFrame(frame).save(outputTiff));
+    }
+    TIFFClose(outputTiff);
+
+    QVERIFY(reader.isCurrent() == false);
+    QVERIFY(LAUMemoryObjectReader::cachedOffsets(filename).isEmpty());
+
+    // REOPENING REBUILDS THE INDEX AND FINDS THE NEW FRAMES
+    {
+        LAUMemoryObjectReader rebuilt(filename, true);
+        QCOMPARE(rebuilt.directories(), 15);
+        QCOMPARE(rebuilt.read(14).rfid(), syntheticFrame(14).rfid());
+        QCOMPARE(LAUMemoryObjectReader::cachedOffsets(filename).count(), 15);
+    }
+
+    // TOUCHING THE FILE WITHOUT CHANGING ITS SIZE STILL INVALIDATES THE SIDECAR
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.setFileTime(QFileInfo(filename).lastModified().addSecs(10), QFileDevice::FileModificationTime));
+    file.close();
+    QVERIFY(LAUMemoryObjectReader::cachedOffsets(filename).isEmpty());
+
+    LAUMemoryObjectReader touched(filename, true);
+    QCOMPARE(touched.directories(), 15);
+    QVERIFY(touched.isCurrent());
+    QCOMPARE(LAUMemoryObjectReader::cachedOffsets(filename).count(), 15);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectReaderTest::truncatedRecordingReadable()
+{
+    // RECORD HOW LONG THE FILE IS AFTER EACH FRAME; FRAME ZERO HAS NO TIME STAMP SO
+    // THE FIRST DIRECTORY IS WRITTEN WITHOUT AN EXIF DIRECTORY IN FRONT OF IT
+    QString filename = QDir(temporaryDir.path()).absoluteFilePath("truncated.tif");
+    QList<qint64> sizes;
+    TIFF *outputTiff = TIFFOpen(filename.toLatin1(), "w");
+    QVERIFY(outputTiff != nullptr);
+    for (int frame = 0; frame < 20; frame++) {
+        QVERIFY(syntheticFrame(frame).save(outputTiff));
+        sizes << QFileInfo(filename).size();
+    }
+    TIFFClose(outputTiff);
+
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray bytes = file.readAll();
+    file.close();
+
+    // CUT THE FILE OFF JUST AFTER A FRAME AND PART WAY THROUGH THE NEXT ONE, AS IF THE
+    // RECORDING PROCESS HAD BEEN KILLED, AND EVERY FRAME THAT FINISHED MUST STILL LOAD
+    QString cutFilename = QDir(temporaryDir.path()).absoluteFilePath("cut.tif");
+    for (int frame = 0; frame < sizes.count() - 1; frame++) {
+        for (qint64 length : { sizes.at(frame), sizes.at(frame) + 1, (sizes.at(frame) + sizes.at(frame + 1)) / 2 }) {
+            QFile cutFile(cutFilename);
+            QVERIFY(cutFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+            QCOMPARE(cutFile.write(bytes.left((int)length)), length);
+            cutFile.close();
+
+            LAUMemoryObjectReader reader(cutFilename);
+            QVERIFY2(reader.isValid(), qPrintable(QString("cut at %1 bytes").arg(length)));
+            QCOMPARE(reader.directories(), frame + 1);
+            for (int index = 0; index <= frame; index++) {
+                LAUMemoryObject object = reader.read(index);
+                LAUMemoryObject expected = syntheticFrame(index);
+                QVERIFY(object.isValid());
+                QCOMPARE(object.rfid(), expected.rfid());
+                QCOMPARE(object.elapsed(), expected.elapsed());
+                QVERIFY(memcmp(object.constPointer(), expected.constPointer(), expected.length()) == 0);
+            }
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectReaderTest::fullPassBenchmark_data()
+{
+    QTest::addColumn<bool>("streaming");
+
+    QTest::newRow("reopen per frame") << false;
+    QTest::newRow("streaming reader") << true;
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectReaderTest::fullPassBenchmark()
+{
+    QFETCH(bool, streaming);
+
+    // READ ALL 500 FRAMES, EITHER REOPENING AND SEEKING FOR EACH ONE OR WITH ONE READER
+    unsigned long long bytes = 0;
+    QBENCHMARK {
+        bytes = 0;
+        if (streaming) {
+            LAUMemoryObjectReader reader(recordingFilename);
+            while (reader.atEnd() == false) {
+                bytes += reader.readNext().length();
+            }
+        } else {
+            for (int frame = 0; frame < TESTREADERFRAMES; frame++) {
+                bytes += LAUMemoryObject(recordingFilename, frame).length();
+            }
+        }
+    }
+    QCOMPARE(bytes, (unsigned long long)TESTREADERFRAMES * 64 * 48 * sizeof(unsigned short));
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectReaderTest::metaDataMatchesLoad()
+{
+    // EVERY VALUE OF THE METADATA PASS MUST EQUAL WHAT A FULL LOAD OF THE SAME DIRECTORY REPORTS
+    LAUMemoryObjectReader reader(metaDataFilename);
+    QCOMPARE(reader.directories(), TESTMETADATAFRAMES);
+    for (int frame = 0; frame < TESTMETADATAFRAMES; frame++) {
+        LAUMemoryObjectMetaData metaData = reader.metaData(frame);
+        LAUMemoryObject object = reader.read(frame);
+        QVERIFY(metaData.isValid());
+        QCOMPARE(metaData.width, object.width());
+        QCOMPARE(metaData.height, object.height());
+        QCOMPARE(metaData.colors, object.colors());
+        QCOMPARE(metaData.depth, object.depth());
+        QCOMPARE(metaData.elapsed, object.elapsed());
+        QCOMPARE(metaData.anchor, object.anchor());
+        QCOMPARE(metaData.rfid, object.rfid());
+        QCOMPARE(metaData.xml, object.xml());
+        QCOMPARE(metaData.jetr, object.jetr());
+        QCOMPARE(LAUMemoryObject::xmlToHash(metaData.xml).value("OriginalFrameOrder").toInt(), frame);
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectReaderTest::metaDataBenchmark_data()
+{
+    QTest::addColumn<bool>("metaDataOnly");
+
+    QTest::newRow("full load") << false;
+    QTest::newRow("metadata pass") << true;
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUMemoryObjectReaderTest::metaDataBenchmark()
+{
+    QFETCH(bool, metaDataOnly);
+
+    // COLLECT THE RFID OF EVERY DIRECTORY THE WAY THE OBJECT ID ENCODER'S ANALYSIS PASS DOES,
+    // EITHER DECODING EACH FRAME OR READING ONLY ITS TAGS
+    QStringList rfids;
+    QBENCHMARK {
+        rfids.clear();
+        LAUMemoryObjectReader reader(metaDataFilename);
+        for (int frame = 0; frame < reader.directories(); frame++) {
+            if (metaDataOnly) {
+                rfids << reader.metaData(frame).rfid;
+            } else {
+                rfids << reader.read(frame).rfid();
+            }
+        }
+    }
+    QCOMPARE(rfids.count(), TESTMETADATAFRAMES);
+}
+
+QTEST_GUILESS_MAIN(LAUMemoryObjectReaderTest)
+
+#include "tst_laumemoryobjectreader.moc"
@@ -0,0 +1,284 @@
+/*********************************************************************************
+ *                                                                               *
+ * Copyright (C) 2025 Dr. Daniel L. Lau                                          *
+ *                                                                               *
+ * This file is part of LAU 3D Video Inspection System.                         *
+ *                                                                               *
+ * LAU 3D Video Inspection System is free software: you can redistribute it     *
+ * and/or modify it under the terms of the GNU Lesser General Public License    *
+ * as published by the Free Software Foundation, either version 3 of the        *
+ * License, or (at your option) any later version.                              *
+ *                                                                               *
+ * LAU 3D Video Inspection System is distributed in the hope that it will be    *
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser      *
+ * General Public License for more details.                                     *
+ *                                                                               *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with LAU 3D Video Inspection System. If not, see                       *
+ * <https://www.gnu.org/licenses/>.                                             *
+ *                                                                               *
+ *********************************************************************************/
+
+#include <QtTest>
+#include <QDir>
+#include <QSettings>
+#include <QTemporaryDir>
+
+#include "laureplaycamera.h"
+
+using namespace libtiff;
+
+#define TESTREPLAYWIDTH   640
+#define TESTREPLAYHEIGHT  480
+#define TESTREPLAYFRAMES  5
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// REPLAYS SYNTHETIC RECORDINGS THE WAY THE SAVE TO DISK FILTER WRITES THEM
+class LAUReplayCameraTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void multiSensorRecording();
+    void lookUpTablePerSensor();
+    void legacyRecordingUsesConfiguredMakeAndModel();
+    void replayDeliversStackedFrames();
+
+private:
+    QTemporaryDir temporaryDir;
+    QString multiSensorFilename;
+    QString legacyFilename;
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static QVector<double> sensorJetr(int sensor)
+{
+    // FEMTO STYLE INTRINSICS FOR A 640X576 SENSOR, EXACT TO THE FIVE DECIMALS SAVE() WRITES
+    QVector<double> vector(LAUREPLAYJETRLENGTH, 0.0);
+    vector[0] = 504.25 + 2.0 * sensor;
+    vector[1] = 319.5 + 0.25 * sensor;
+    vector[2] = 504.5 + 2.0 * sensor;
+    vector[3] = 287.75 - 0.25 * sensor;
+    vector[4] = 0.0625;
+    vector[5] = -0.03125;
+    vector[6] = 0.0;
+    vector[7] = 0.0;
+    vector[8] = 0.0;
+    vector[9] = 0.0;
+    vector[10] = 0.00125;
+    vector[11] = -0.0025;
+    for (int n = 0; n < 4; n++) {
+        vector[12 + 5 * n] = 1.0;
+    }
+    vector[28] = -1000.0;
+    vector[29] = 1000.0;
+    vector[30] = -1000.0;
+    vector[31] = 1000.0;
+    vector[32] = -5000.0;
+    vector[33] = -100.0;
+    vector[34] = 0.25;
+    vector[35] = 250.0;
+    vector[36] = 2880.0;
+    return (vector);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUMemoryObject recordedFrame(int frame, int sensors, QString make, QString model)
+{
+    // SENSORS STACKED AS FRAMES WITH ONE JETR VECTOR EACH, LIKE THE LIVE VIDEO CLASSIFIER ALLOCATES THEM
+    LAUMemoryObject object(TESTREPLAYWIDTH, TESTREPLAYHEIGHT, 1, sizeof(unsigned short), sensors);
+    for (unsigned int row = 0; row < object.height() * object.frames(); row++) {
+        unsigned short *buffer = (unsigned short *)object.scanLine(row);
+        for (unsigned int col = 0; col < object.width(); col++) {
+            buffer[col] = (unsigned short)(1000 + 7 * frame + row + (col % 17));
+        }
+    }
+
+    QVector<double> jetrVector;
+    for (int sensor = 0; sensor < sensors; sensor++) {
+        jetrVector << sensorJetr(sensor);
+    }
+    object.setJetr(jetrVector);
+
+    if (make.isEmpty() == false || model.isEmpty() == false) {
+        QHash<QString, QString> hashTable;
+        hashTable["make"] = make;
+        hashTable["model"] = model;
+        object.setXML(LAUMemoryObject::hashToXml(hashTable));
+    }
+    object.setElapsed((unsigned int)(33 * frame));
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static QString writeRecording(QString filename, int sensors, QString make, QString model)
+{
+    TIFF *outputTiff = TIFFOpen(filename.toLatin1(), "w");
+    if (outputTiff == nullptr) {
+        return (QString());
+    }
+
+    // THE BACKGROUND GOES IN THE FIRST DIRECTORY AHEAD OF THE VIDEO FRAMES
+    if (recordedFrame(0, sensors, QString(), QString()).save(outputTiff) == false) {
+        TIFFClose(outputTiff);
+        return (QString());
+    }
+    for (int frame = 0; frame < TESTREPLAYFRAMES; frame++) {
+        if (recordedFrame(frame, sensors, make, model).save(outputTiff) == false) {
+            TIFFClose(outputTiff);
+            return (QString());
+        }
+    }
+    TIFFClose(outputTiff);
+    return (filename);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static bool sameTable(const LAULookUpTable &tableA, const LAULookUpTable &tableB)
+{
+    if (tableA.isNull() || tableB.isNull() || tableA.width() != tableB.width() || tableA.height() != tableB.height() || tableA.colors() != tableB.colors()) {
+        return (false);
+    }
+    for (unsigned int row = 0; row < tableA.height(); row++) {
+        if (memcmp(tableA.constScanLine(row), tableB.constScanLine(row), tableA.step()) != 0) {
+            return (false);
+        }
+    }
+    return (true);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUReplayCameraTest::initTestCase()
+{
+    // SILENCE LIBTIFF SO ITS WARNINGS DON'T LAND ON STDERR
+    TIFFSetErrorHandler(myTIFFErrorHandler);
+    TIFFSetWarningHandler(myTIFFWarningHandler);
+
+    // KEEP THE REPLAY SETTINGS OUT OF THE APPLICATIONS' OWN SETTINGS
+    QCoreApplication::setOrganizationName(QString("LAU Tests"));
+    QCoreApplication::setApplicationName(QString("tst_laureplaycamera"));
+
+    QVERIFY(temporaryDir.isValid());
+    multiSensorFilename = writeRecording(QDir(temporaryDir.path()).absoluteFilePath("multisensor.tif"), 2, QString("Orbbec"), QString("Femto Bolt"));
+    QVERIFY(multiSensorFilename.isEmpty() == false);
+    legacyFilename = writeRecording(QDir(temporaryDir.path()).absoluteFilePath("legacy.tif"), 1, QString(), QString());
+    QVERIFY(legacyFilename.isEmpty() == false);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUReplayCameraTest::multiSensorRecording()
+{
+    LAUReplayCamera camera(multiSensorFilename);
+    QVERIFY(camera.isValid());
+
+    // THE STACKED DIRECTORY SPLITS BACK INTO ONE SENSOR PER JETR VECTOR
+    QCOMPARE(camera.sensors(), 2u);
+    QCOMPARE(camera.depthWidth(), (unsigned int)TESTREPLAYWIDTH);
+    QCOMPARE(camera.depthHeight(), (unsigned int)TESTREPLAYHEIGHT);
+    QCOMPARE(camera.frameCount(), TESTREPLAYFRAMES);
+    QCOMPARE(camera.jetr(0), sensorJetr(0));
+    QCOMPARE(camera.jetr(1), sensorJetr(1));
+
+    // THE MAKE AND MODEL COME BACK FROM THE XML PACKET THE RECORDER WROTE
+    QCOMPARE(camera.make(), QString("Orbbec"));
+    QCOMPARE(camera.model(), QString("Femto Bolt"));
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUReplayCameraTest::lookUpTablePerSensor()
+{
+    LAUReplayCamera camera(multiSensorFilename);
+    QVERIFY(camera.isValid());
+
+    // EACH SENSOR GETS THE SAME FEMTO TABLE THE LIVE CAMERA WOULD HAVE BUILT FOR IT
+    for (int sensor = 0; sensor < 2; sensor++) {
+        LAULookUpTable replayed = camera.lut(sensor);
+        LAULookUpTable expected = LAULookUpTable::generateTableFromJETR(TESTREPLAYWIDTH, TESTREPLAYHEIGHT, sensorJetr(sensor), QString("Orbbec"), QString("Femto Bolt"));
+        QVERIFY(sameTable(replayed, expected));
+
+        // AND NOT THE GENERIC TABLE A RECORDING WITHOUT A MAKE AND MODEL USED TO GET
+        LAULookUpTable generic = LAULookUpTable::generateTableFromJETR(TESTREPLAYWIDTH, TESTREPLAYHEIGHT, sensorJetr(sensor));
+        QVERIFY(sameTable(replayed, generic) == false);
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUReplayCameraTest::legacyRecordingUsesConfiguredMakeAndModel()
+{
+    QSettings settings;
+    settings.setValue("LAUReplayCamera::make", QString("Orbbec"));
+    settings.setValue("LAUReplayCamera::model", QString("Femto Mega"));
+
+    // RECORDINGS WITHOUT A MAKE AND MODEL FALL BACK TO THE ONES CONFIGURED FOR REPLAY
+    {
+        LAUReplayCamera camera(legacyFilename);
+        QVERIFY(camera.isValid());
+        QCOMPARE(camera.sensors(), 1u);
+        QCOMPARE(camera.depthHeight(), (unsigned int)TESTREPLAYHEIGHT);
+        QCOMPARE(camera.make(), QString("Orbbec"));
+        QCOMPARE(camera.model(), QString("Femto Mega"));
+    }
+
+    settings.remove("LAUReplayCamera::make");
+    settings.remove("LAUReplayCamera::model");
+
+    // WITHOUT ANY CONFIGURATION THE MAKE AND MODEL STAY EMPTY
+    LAUReplayCamera camera(legacyFilename);
+    QVERIFY(camera.make().isEmpty());
+    QVERIFY(camera.model().isEmpty());
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUReplayCameraTest::replayDeliversStackedFrames()
+{
+    LAUReplayCamera camera(multiSensorFilename);
+    QVERIFY(camera.isValid());
+    camera.setMode(LAUReplayCamera::ModeFreeRunning);
+    camera.setLooping(false);
+
+    QSignalSpy endSpy(&camera, &LAUReplayCamera::emitEndOfRecording);
+
+    // EVERY FRAME COMES BACK IN THE CALLER'S PER-SENSOR BUFFER EXACTLY AS IT WAS RECORDED
+    LAUMemoryObject depth = camera.depthMemoryObject();
+    QCOMPARE(depth.frames(), 2u);
+    for (int frame = 0; frame < TESTREPLAYFRAMES; frame++) {
+        camera.onUpdateBuffer(depth);
+        LAUMemoryObject recorded = recordedFrame(frame, 2, QString(), QString());
+        QCOMPARE(depth.length(), recorded.length());
+        QVERIFY(memcmp(depth.constPointer(), recorded.constPointer(), recorded.length()) == 0);
+        QCOMPARE(depth.elapsed(), recorded.elapsed());
+        QCOMPARE(depth.jetr(), recorded.jetr());
+    }
+    QCOMPARE(camera.framesReplayed(), (qint64)TESTREPLAYFRAMES);
+
+    // ONE MORE REQUEST RUNS OFF THE END OF THE RECORDING
+    camera.onUpdateBuffer(depth);
+    QCOMPARE(endSpy.count(), 1);
+}
+
+QTEST_GUILESS_MAIN(LAUReplayCameraTest)
+
+#include "tst_laureplaycamera.moc"
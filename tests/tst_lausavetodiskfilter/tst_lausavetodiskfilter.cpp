@@ -0,0 +1,308 @@
+/*********************************************************************************
+ *                                                                               *
+ * Copyright (C) 2025 Dr. Daniel L. Lau                                          *
+ *                                                                               *
+ * This file is part of LAU 3D Video Inspection System.                         *
+ *                                                                               *
+ * LAU 3D Video Inspection System is free software: you can redistribute it     *
+ * and/or modify it under the terms of the GNU Lesser General Public License    *
+ * as published by the Free Software Foundation, either version 3 of the        *
+ * License, or (at your option) any later version.                              *
+ *                                                                               *
+ * LAU 3D Video Inspection System is distributed in the hope that it will be    *
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser      *
+ * General Public License for more details.                                     *
+ *                                                                               *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with LAU 3D Video Inspection System. If not, see                       *
+ * <https://www.gnu.org/licenses/>.                                             *
+ *                                                                               *
+ *********************************************************************************/
+
+#include <QtTest>
+#include <QDir>
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+
+#include "lausavetodiskfilter.h"
+
+using namespace libtiff;
+
+#define TESTWRITERWIDTH    640
+#define TESTWRITERHEIGHT   480
+#define TESTWRITERCAPACITY 4
+#define TESTWRITERFRAMES   200
+#define TESTPREROLLFRAMES  40
+#define TESTOBJECTFRAMES   20
+#define TESTCLOSECYCLES    5
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// CHECKS THE BOUNDED WRITE QUEUE OF LAUSAVETODISKWRITER AGAINST THE FRAMES THAT ACTUALLY REACH THE FILE,
+// AND THE TRAILER FRAMES THAT LAUSAVETODISKFILTER APPENDS WHEN IT CLOSES A RECORDING
+class LAUSaveToDiskFilterTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void writerQueueIsBounded();
+    void writerCountersMatchFile();
+    void trailerFramesMatchPreRoll();
+    void closeCostIndependentOfHeaderFrames();
+
+private:
+    QTemporaryDir temporaryDir;
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUMemoryObject writerFrame(int frame)
+{
+    // FILL THE FRAME WITH A RAMP THAT DEPENDS ON THE FRAME NUMBER SO WRITTEN FRAMES CAN BE TOLD APART
+    LAUMemoryObject object(TESTWRITERWIDTH, TESTWRITERHEIGHT, 1, sizeof(unsigned short), 1);
+    for (unsigned int row = 0; row < object.height(); row++) {
+        unsigned short *buffer = (unsigned short *)object.scanLine(row);
+        for (unsigned int col = 0; col < object.width(); col++) {
+            buffer[col] = (unsigned short)(frame * 977 + row * 31 + col * 7);
+        }
+    }
+    object.setElapsed((unsigned int)frame);
+    object.setRFID(QString("frame%1").arg(frame));
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static QList<unsigned int> elapsedOnDisk(QString filename)
+{
+    // READ BACK EVERY DIRECTORY AND CHECK ITS PIXELS AGAINST THE FRAME ITS ELAPSED TIME NAMES
+    QList<unsigned int> elapsed;
+    LAUMemoryObjectReader reader(filename);
+    while (reader.isValid() && reader.atEnd() == false) {
+        LAUMemoryObject object = reader.readNext();
+        LAUMemoryObject expected = writerFrame((int)object.elapsed());
+        if (object.length() != expected.length() || memcmp(object.constPointer(), expected.constPointer(), expected.length()) != 0) {
+            return (QList<unsigned int>());
+        }
+        elapsed << object.elapsed();
+    }
+    return (elapsed);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUMemoryObject filterFrame(int frame, float anchor)
+{
+    // THE FILTER ONLY RECORDS WHILE THE TAIL ANCHOR IS AT OR PAST COLUMN 100 AND MOVING RIGHT
+    LAUMemoryObject object = writerFrame(frame);
+    object.setAnchor(QPoint((int)anchor, TESTWRITERHEIGHT / 2));
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static int recordPass(LAUAbstractFilter *filter, int frame, qint64 *closeNsecs = nullptr)
+{
+    // PRE-ROLL WITH NO OBJECT IN VIEW, THEN AN OBJECT MOVING RIGHT FROM COLUMN 110, THEN
+    // NO OBJECT AGAIN UNTIL THE SIXTH EMPTY FRAME CLOSES THE FILE ON THE FILTER THREAD
+    for (int n = 0; n < TESTPREROLLFRAMES; n++) {
+        filter->onUpdateBuffer(filterFrame(frame++, 0.0f));
+    }
+    for (int n = 0; n < TESTOBJECTFRAMES; n++) {
+        filter->onUpdateBuffer(filterFrame(frame++, 110.0f + 5.0f * n));
+    }
+    for (int n = 0; n < 5; n++) {
+        filter->onUpdateBuffer(filterFrame(frame++, 0.0f));
+    }
+
+    LAUMemoryObject closingFrame = filterFrame(frame++, 0.0f);
+    QElapsedTimer timer;
+    timer.start();
+    filter->onUpdateBuffer(closingFrame);
+    if (closeNsecs) {
+        *closeNsecs = timer.nsecsElapsed();
+    }
+    return (frame);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUSaveToDiskFilterTest::initTestCase()
+{
+    // SILENCE LIBTIFF SO ITS WARNINGS DON'T LAND ON STDERR
+    TIFFSetErrorHandler(myTIFFErrorHandler);
+    TIFFSetWarningHandler(myTIFFWarningHandler);
+
+    QVERIFY(temporaryDir.isValid());
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUSaveToDiskFilterTest::writerQueueIsBounded()
+{
+    QString filename = QDir(temporaryDir.path()).absoluteFilePath("bounded.tif");
+    TIFF *file = TIFFOpen(filename.toLocal8Bit(), "w");
+    QVERIFY(file != nullptr);
+
+    // WITH THE THREAD NOT YET STARTED NOTHING DRAINS THE QUEUE, SO ONLY THE FIRST FEW LIVE FRAMES FIT
+    LAUSaveToDiskWriter writer(TESTWRITERCAPACITY);
+    QList<unsigned int> accepted;
+    for (int frame = 0; frame < 3 * TESTWRITERCAPACITY; frame++) {
+        if (writer.enqueueFrames(file, QList<LAUMemoryObject>() << writerFrame(frame))) {
+            accepted << (unsigned int)frame;
+        }
+    }
+    QCOMPARE(accepted.count(), TESTWRITERCAPACITY);
+    QCOMPARE(writer.depth(), TESTWRITERCAPACITY);
+    QCOMPARE(writer.highWaterMark(), TESTWRITERCAPACITY);
+    QCOMPARE(writer.droppedFrames(), 2 * TESTWRITERCAPACITY);
+    QCOMPARE(writer.writtenFrames(), 0);
+
+    // HEADER FRAMES AND THE CLOSE ARE ALWAYS ACCEPTED, EVEN WITH THE QUEUE FULL
+    QVERIFY(writer.enqueueFrames(file, QList<LAUMemoryObject>() << writerFrame(1000), true));
+    accepted << 1000;
+    writer.enqueueClose(file, filename);
+    QCOMPARE(writer.depth(), TESTWRITERCAPACITY + 2);
+    QCOMPARE(writer.highWaterMark(), TESTWRITERCAPACITY + 2);
+
+    writer.start();
+    writer.stop();
+    QVERIFY(writer.wait(30000));
+
+    QCOMPARE(writer.depth(), 0);
+    QCOMPARE(writer.droppedFrames(), 2 * TESTWRITERCAPACITY);
+    QCOMPARE(writer.writtenFrames(), accepted.count());
+    QCOMPARE(elapsedOnDisk(filename), accepted);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUSaveToDiskFilterTest::writerCountersMatchFile()
+{
+    QString filename = QDir(temporaryDir.path()).absoluteFilePath("flooded.tif");
+    TIFF *file = TIFFOpen(filename.toLocal8Bit(), "w");
+    QVERIFY(file != nullptr);
+
+    // A SLOW CODEC ON ONE THREAD KEEPS THE WRITER BEHIND A PRODUCER THAT NEVER WAITS
+    QList<LAUMemoryObjectCodec> codecs = QList<LAUMemoryObjectCodec>() << LAUMemoryObjectCodec::fromString("deflate:9");
+    LAUSaveToDiskWriter writer(TESTWRITERCAPACITY);
+    writer.setCompressionThreads(1);
+    writer.start();
+
+    QList<LAUMemoryObject> frames;
+    for (int frame = 0; frame < TESTWRITERFRAMES; frame++) {
+        frames << writerFrame(frame);
+    }
+
+    QList<unsigned int> accepted;
+    int maximumDepth = 0;
+    for (int frame = 0; frame < TESTWRITERFRAMES; frame++) {
+        if (writer.enqueueFrames(file, QList<LAUMemoryObject>() << frames.at(frame), false, codecs)) {
+            accepted << (unsigned int)frame;
+        }
+        maximumDepth = qMax(maximumDepth, writer.depth());
+        QVERIFY(writer.depth() <= TESTWRITERCAPACITY);
+    }
+    writer.enqueueClose(file, filename);
+    writer.stop();
+    QVERIFY(writer.wait(120000));
+
+    // EVERY FRAME IS EITHER WRITTEN OR COUNTED AS DROPPED, AND THE FILE HOLDS EXACTLY THE ACCEPTED ONES IN ORDER
+    QVERIFY2(writer.droppedFrames() > 0, "the producer never got ahead of the writer");
+    QCOMPARE(writer.droppedFrames() + accepted.count(), TESTWRITERFRAMES);
+    QCOMPARE(writer.writtenFrames(), accepted.count());
+    QCOMPARE(writer.depth(), 0);
+    QVERIFY(writer.highWaterMark() >= maximumDepth);
+    QVERIFY(writer.highWaterMark() <= TESTWRITERCAPACITY + 1);
+    QCOMPARE(elapsedOnDisk(filename), accepted);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUSaveToDiskFilterTest::trailerFramesMatchPreRoll()
+{
+    QString directory = QDir(temporaryDir.path()).absoluteFilePath("trailer");
+    QVERIFY(QDir().mkpath(directory));
+
+    LAUSaveToDiskFilter filter(directory);
+    LAUAbstractFilter *abstractFilter = &filter;
+    abstractFilter->onStart();
+    int lastFrame = recordPass(abstractFilter, 1);
+    abstractFilter->onFinish();
+
+    QCOMPARE(filter.newFiles().count(), 1);
+    QList<unsigned int> elapsed = elapsedOnDisk(filter.newFiles().first());
+    QVERIFY(elapsed.count() > NUMBER_HEADER_FRAMES);
+    QCOMPARE(lastFrame, 1 + TESTPREROLLFRAMES + TESTOBJECTFRAMES + 6);
+
+    // THE RECORDED FRAMES ARE FOLLOWED BY THE FRAMES THAT WERE BUFFERED WHEN THE FILE WAS
+    // OPENED: THE LAST PRE-ROLL FRAMES AND THE FIRST FRAME WITH AN OBJECT IN VIEW
+    QList<unsigned int> expected;
+    for (int frame = TESTPREROLLFRAMES - NUMBER_HEADER_FRAMES + 2; frame <= TESTPREROLLFRAMES + 1; frame++) {
+        expected << (unsigned int)frame;
+    }
+    QCOMPARE(elapsed.mid(elapsed.count() - NUMBER_HEADER_FRAMES), expected);
+    for (int n = 0; n < elapsed.count() - NUMBER_HEADER_FRAMES; n++) {
+        QVERIFY(elapsed.at(n) > (unsigned int)TESTPREROLLFRAMES && elapsed.at(n) <= (unsigned int)(TESTPREROLLFRAMES + TESTOBJECTFRAMES));
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUSaveToDiskFilterTest::closeCostIndependentOfHeaderFrames()
+{
+    QString directory = QDir(temporaryDir.path()).absoluteFilePath("closecost");
+    QVERIFY(QDir().mkpath(directory));
+
+    // TIME THE FILTER CALL THAT CLOSES THE FILE OVER SEVERAL RECORDINGS, KEEPING THE FASTEST
+    LAUSaveToDiskFilter filter(directory);
+    LAUAbstractFilter *abstractFilter = &filter;
+    abstractFilter->onStart();
+    qint64 closeNsecs = std::numeric_limits<qint64>::max();
+    int frame = 1;
+    for (int cycle = 0; cycle < TESTCLOSECYCLES; cycle++) {
+        qint64 nsecs = 0;
+        frame = recordPass(abstractFilter, frame, &nsecs);
+        closeNsecs = qMin(closeNsecs, nsecs);
+    }
+    abstractFilter->onFinish();
+    QCOMPARE(filter.newFiles().count(), TESTCLOSECYCLES);
+
+    // WHAT CLOSING USED TO COST: A DEEP COPY OF EVERY BUFFERED HEADER FRAME
+    LAUMemoryObject source = writerFrame(1);
+    QList<LAUMemoryObject> targets;
+    for (int n = 0; n < NUMBER_HEADER_FRAMES; n++) {
+        targets << LAUMemoryObject(source.width(), source.height(), source.colors(), source.depth(), source.frames());
+    }
+    qint64 copyNsecs = std::numeric_limits<qint64>::max();
+    for (int cycle = 0; cycle < TESTCLOSECYCLES; cycle++) {
+        QElapsedTimer timer;
+        timer.start();
+        for (int n = 0; n < NUMBER_HEADER_FRAMES; n++) {
+            memcpy(targets[n].pointer(), source.constPointer(), source.length());
+        }
+        copyNsecs = qMin(copyNsecs, timer.nsecsElapsed());
+    }
+
+    // THE CLOSING CALL STILL COPIES THE ONE INCOMING FRAME INTO THE TRAILER LIST, SO IT
+    // SHOULD COST ABOUT ONE FRAME COPY RATHER THAN NUMBER_HEADER_FRAMES OF THEM
+    qDebug() << "closing call" << closeNsecs << "ns," << NUMBER_HEADER_FRAMES << "frame copies" << copyNsecs << "ns";
+    QVERIFY2(closeNsecs < copyNsecs / 2, qPrintable(QString("closing took %1 ns against %2 ns for %3 frame copies").arg(closeNsecs).arg(copyNsecs).arg(NUMBER_HEADER_FRAMES)));
+}
+
+QTEST_GUILESS_MAIN(LAUSaveToDiskFilterTest)
+
+#include "tst_lausavetodiskfilter.moc"
@@ -0,0 +1,629 @@
+/*********************************************************************************
+ *                                                                               *
+ * Copyright (C) 2025 Dr. Daniel L. Lau                                          *
+ *                                                                               *
+ * This file is part of LAU 3D Video Inspection System.                         *
+ *                                                                               *
+ * LAU 3D Video Inspection System is free software: you can redistribute it     *
+ * and/or modify it under the terms of the GNU Lesser General Public License    *
+ * as published by the Free Software Foundation, either version 3 of the        *
+ * License, or (at your option) any later version.                              *
+ *                                                                               *
+ * LAU 3D Video Inspection System is distributed in the hope that it will be    *
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser      *
+ * General Public License for more details.                                     *
+ *                                                                               *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with LAU 3D Video Inspection System. If not, see                       *
+ * <https://www.gnu.org/licenses/>.                                             *
+ *                                                                               *
+ *********************************************************************************/
+
+#include <QtTest>
+#include <QtMath>
+#include <QRandomGenerator>
+
+#include "lauscan.h"
+#include "laulookuptable.h"
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+// RUNS THE LAUSCAN KERNELS AT EVERY SIMD LEVEL THE CPU SUPPORTS AND CHECKS THAT THEY AGREE BIT FOR BIT
+class LAUScanTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+
+    void updateLimits_data();
+    void updateLimits();
+    void mergeScans_data();
+    void mergeScans();
+    void transformScanInPlace_data();
+    void transformScanInPlace();
+    void transformScanInPlaceColors();
+    void transformScanInPlaceThreads_data();
+    void transformScanInPlaceThreads();
+    void fromRawDepth_data();
+    void fromRawDepth();
+
+    void benchmark_data();
+    void benchmark();
+    void fromRawDepthBenchmark_data();
+    void fromRawDepthBenchmark();
+
+private:
+    LAUMemoryObjectSimd::Level defaultLevel;
+};
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUScan randomScan(unsigned int cols, unsigned int rows, LAUVideoPlaybackColor color, quint32 seed)
+{
+    // COORDINATES SPREAD AROUND THE ORIGIN WITH SIGNED ZEROS, AND ABOUT ONE PIXEL IN TWENTY HAS A NAN
+    LAUScan scan(cols, rows, color);
+    QRandomGenerator generator(seed);
+    for (unsigned int row = 0; row < rows; row++) {
+        float *buffer = (float *)scan.scanLine(row);
+        for (unsigned int col = 0; col < cols; col++) {
+            float *pixel = buffer + col * scan.colors();
+            for (unsigned int chn = 0; chn < scan.colors(); chn++) {
+                int choice = generator.bounded(16);
+                if (choice == 0) {
+                    pixel[chn] = 0.0f;
+                } else if (choice == 1) {
+                    pixel[chn] = -0.0f;
+                } else if (chn < 3) {
+                    pixel[chn] = (float)((int)generator.bounded(200000) - 100000) / 97.0f;
+                } else {
+                    pixel[chn] = (float)generator.bounded(1000) / 999.0f;
+                }
+            }
+            if (generator.bounded(20) == 0) {
+                pixel[generator.bounded(3)] = NAN;
+            }
+        }
+    }
+    return (scan);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUScan copyScan(const LAUScan &scan)
+{
+    LAUScan copy(scan.width(), scan.height(), scan.color());
+    memcpy(copy.pointer(), scan.constPointer(), scan.length());
+    return (copy);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static QVector<float> limits(const LAUScan &scan)
+{
+    return (QVector<float>() << scan.minX() << scan.maxX() << scan.minY() << scan.maxY() << scan.minZ() << scan.maxZ() << scan.centroid().x() << scan.centroid().y() << scan.centroid().z());
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static QMatrix4x4 testTransform()
+{
+    QMatrix4x4 mat;
+    mat.translate(12.5f, -40.0f, 800.0f);
+    mat.rotate(33.0f, 1.0f, 2.0f, 3.0f);
+    return (mat);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static void addScanRows()
+{
+    QTest::addColumn<int>("color");
+    QTest::addColumn<QSize>("size");
+
+    // ODD SIZES LEAVE PIXELS OVER FOR THE SSE TAIL AT EVERY LEVEL
+    QList<QSize> sizes = { QSize(1, 1), QSize(7, 3), QSize(33, 17), QSize(640, 480) };
+    QList<LAUVideoPlaybackColor> colors = { ColorXYZG, ColorXYZRGB, ColorXYZWRGBA };
+    for (LAUVideoPlaybackColor color : colors) {
+        for (const QSize &size : sizes) {
+            QTest::addRow("%d channel %dx%d", LAUScan(1, 1, color).colors(), size.width(), size.height()) << (int)color << size;
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAULookUpTable randomDepthTable(unsigned int cols, unsigned int rows, quint32 seed)
+{
+    // RANDOM FOURTH ORDER COEFFICIENTS WHOSE DEPTHS FALL BOTH INSIDE AND OUTSIDE THE TABLE'S Z-RANGE OF -8000 TO -500
+    LAULookUpTable table(cols, rows, 12, StyleFourthOrderPoly, 1.0f, 0.8f, 500.0f, 8000.0f);
+    QRandomGenerator generator(seed);
+    for (unsigned int row = 0; row < rows; row++) {
+        float *buffer = (float *)table.scanLine(row);
+        for (unsigned int col = 0; col < cols; col++) {
+            float *vector = buffer + col * table.colors();
+            vector[0] = (float)((int)generator.bounded(2001) - 1000) / 1000.0f;
+            vector[1] = (float)((int)generator.bounded(2001) - 1000) / 100.0f;
+            vector[2] = (float)((int)generator.bounded(2001) - 1000) / 1000.0f;
+            vector[3] = (float)((int)generator.bounded(2001) - 1000) / 100.0f;
+            for (int n = 4; n < 8; n++) {
+                vector[n] = (float)((int)generator.bounded(6001) - 3000);
+            }
+            vector[8] = -1000.0f - (float)generator.bounded(5000);
+            for (unsigned int chn = 9; chn < table.colors(); chn++) {
+                vector[chn] = 0.0f;
+            }
+        }
+    }
+    return (table);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUMemoryObject randomDepth(unsigned int cols, unsigned int rows, quint32 seed)
+{
+    // RAW 16-BIT DEPTH INCLUDING THE TWO EXTREMES OF THE RANGE
+    LAUMemoryObject object(cols, rows, 1, sizeof(unsigned short), 1);
+    QRandomGenerator generator(seed);
+    for (unsigned int row = 0; row < rows; row++) {
+        unsigned short *buffer = (unsigned short *)object.scanLine(row);
+        for (unsigned int col = 0; col < cols; col++) {
+            int choice = generator.bounded(32);
+            buffer[col] = (choice == 0) ? 0 : ((choice == 1) ? 65535 : (unsigned short)generator.bounded(65536));
+        }
+    }
+    return (object);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+static LAUScan fromRawDepthReference(const LAUMemoryObject &object, const LAULookUpTable &table)
+{
+    // THE SCALAR POW() LOOP THAT LAUSCAN::FROMRAWDEPTH USED BEFORE IT WAS VECTORIZED
+    LAUScan scan(object.width(), object.height(), LAU3DVideoParameters::ColorXYZG);
+
+    float zMin = qMin(table.zLimits().x(), table.zLimits().y());
+    float zMax = qMax(table.zLimits().x(), table.zLimits().y());
+
+    for (unsigned int row = 0; row < object.height(); row++) {
+        unsigned short *inBuffer = (unsigned short *)(object.constScanLine(row));
+        float *otBuffer = (float *)scan.scanLine(row);
+
+        for (unsigned int col = 0; col < object.width(); col++) {
+            float *lutVector = (float *)(table.constScanLine(row)) + (table.colors() * col);
+            float pixel = inBuffer[col] / 65535.0f;
+
+            float z = (lutVector[4] * pow(pixel, 4.0f))
+                      + (lutVector[5] * pow(pixel, 3.0f))
+                      + (lutVector[6] * pow(pixel, 2.0f))
+                      + (lutVector[7] * pixel)
+                      + lutVector[8];
+
+            z = (z <= zMin || z >= zMax) ? NAN : z;
+
+            otBuffer[4 * col + 0] = (lutVector[0] * z) + lutVector[1];
+            otBuffer[4 * col + 1] = (lutVector[2] * z) + lutVector[3];
+            otBuffer[4 * col + 2] = z;
+            otBuffer[4 * col + 3] = pixel;
+        }
+    }
+    scan.updateLimits();
+    return (scan);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::initTestCase()
+{
+    // REMEMBER THE LEVEL THE DISPATCHER PICKED SO IT CAN BE PUT BACK AFTER EACH TEST
+    defaultLevel = LAUMemoryObjectSimd::level();
+    qDebug() << "SIMD level" << LAUMemoryObjectSimd::toString(defaultLevel) << "of" << LAUMemoryObjectSimd::toString(LAUMemoryObjectSimd::supportedLevel());
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::cleanup()
+{
+    LAUMemoryObjectSimd::setLevel(defaultLevel);
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::updateLimits_data()
+{
+    addScanRows();
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::updateLimits()
+{
+    QFETCH(int, color);
+    QFETCH(QSize, size);
+
+    LAUScan scan = randomScan(size.width(), size.height(), (LAUVideoPlaybackColor)color, (quint32)(size.width() + color));
+
+    // THE OLD SCAN KEPT ONE RUNNING MIN, MAX AND SUM OVER EVERY PIXEL WITHOUT A NAN IN ITS FIRST FOUR CHANNELS
+    float minimum[4] = { 1e9f, 1e9f, 1e9f, 1e9f };
+    float maximum[4] = { -1e9f, -1e9f, -1e9f, -1e9f };
+    float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    int count = 0;
+    const float *buffer = (const float *)scan.constPointer();
+    for (unsigned int pxl = 0; pxl < scan.width() * scan.height(); pxl++) {
+        const float *pixel = buffer + pxl * scan.colors();
+        if (qIsNaN(pixel[0]) || qIsNaN(pixel[1]) || qIsNaN(pixel[2]) || qIsNaN(pixel[3])) {
+            continue;
+        }
+        for (int chn = 0; chn < 4; chn++) {
+            minimum[chn] = qMin(minimum[chn], pixel[chn]);
+            maximum[chn] = qMax(maximum[chn], pixel[chn]);
+            sum[chn] += pixel[chn];
+        }
+        count++;
+    }
+    if (qFabs(minimum[2]) > qFabs(maximum[2])) {
+        qSwap(minimum[2], maximum[2]);
+    }
+    if (minimum[2] == 0.0f) {
+        minimum[2] = 1.0f;
+    }
+
+    // EVERY LEVEL HAS TO MATCH SSE EXACTLY, INCLUDING THE SIGN OF ANY ZERO
+    QVector<float> reference;
+    for (int lvl = LAUMemoryObjectSimd::LevelSSE; lvl <= LAUMemoryObjectSimd::supportedLevel(); lvl++) {
+        QVERIFY(LAUMemoryObjectSimd::setLevel((LAUMemoryObjectSimd::Level)lvl));
+        scan.updateLimits();
+        QVector<float> result = limits(scan);
+        if (lvl == LAUMemoryObjectSimd::LevelSSE) {
+            reference = result;
+        }
+        QVERIFY2(memcmp(result.constData(), reference.constData(), reference.count() * sizeof(float)) == 0, qPrintable(LAUMemoryObjectSimd::toString((LAUMemoryObjectSimd::Level)lvl)));
+    }
+
+    // THE BOUNDING BOX EQUALS THE OLD ONE, WHILE THE CENTER OF MASS NOW ADDS FOUR PARTIAL
+    // SUMS AND SO ONLY AGREES WITH THE OLD RUNNING SUM TO WITHIN ROUNDING
+    QCOMPARE(reference[0], minimum[0]);
+    QCOMPARE(reference[1], maximum[0]);
+    QCOMPARE(reference[2], minimum[1]);
+    QCOMPARE(reference[3], maximum[1]);
+    QCOMPARE(reference[4], minimum[2]);
+    QCOMPARE(reference[5], maximum[2]);
+    if (count > 0) {
+        for (int chn = 0; chn < 3; chn++) {
+            float mean = sum[chn] / (float)count;
+            QVERIFY(qFabs(reference[6 + chn] - mean) <= 1e-3f * (1.0f + qFabs(mean)));
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::mergeScans_data()
+{
+    addScanRows();
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::mergeScans()
+{
+    QFETCH(int, color);
+    QFETCH(QSize, size);
+
+    QList<LAUScan> scans;
+    for (quint32 seed = 1; seed <= 3; seed++) {
+        scans << randomScan(size.width(), size.height(), (LAUVideoPlaybackColor)color, seed);
+    }
+
+    // THE SUM RUNS IN LIST ORDER AND IS THEN SCALED BY ONE OVER THE NUMBER OF SCANS
+    LAUScan reference = copyScan(scans.first());
+    float *buffer = (float *)reference.pointer();
+    for (unsigned long long n = 0; n < reference.length() / sizeof(float); n++) {
+        float value = ((const float *)scans[0].constPointer())[n];
+        value += ((const float *)scans[1].constPointer())[n];
+        value += ((const float *)scans[2].constPointer())[n];
+        buffer[n] = value * (1.0f / 3.0f);
+    }
+
+    // MERGESCANS ADDS INTO THE FIRST SCAN'S BUFFER, SO EVERY LEVEL GETS ITS OWN COPIES
+    for (int lvl = LAUMemoryObjectSimd::LevelSSE; lvl <= LAUMemoryObjectSimd::supportedLevel(); lvl++) {
+        QVERIFY(LAUMemoryObjectSimd::setLevel((LAUMemoryObjectSimd::Level)lvl));
+        QList<LAUScan> copies;
+        for (const LAUScan &scan : scans) {
+            copies << copyScan(scan);
+        }
+        LAUScan merged = LAUScan::mergeScans(copies);
+        QCOMPARE(merged.length(), reference.length());
+        QVERIFY2(memcmp(merged.constPointer(), reference.constPointer(), reference.length()) == 0, qPrintable(LAUMemoryObjectSimd::toString((LAUMemoryObjectSimd::Level)lvl)));
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::transformScanInPlace_data()
+{
+    addScanRows();
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::transformScanInPlace()
+{
+    QFETCH(int, color);
+    QFETCH(QSize, size);
+
+    LAUScan scan = randomScan(size.width(), size.height(), (LAUVideoPlaybackColor)color, (quint32)(size.height() + color));
+
+    LAUScan reference;
+    for (int lvl = LAUMemoryObjectSimd::LevelSSE; lvl <= LAUMemoryObjectSimd::supportedLevel(); lvl++) {
+        QVERIFY(LAUMemoryObjectSimd::setLevel((LAUMemoryObjectSimd::Level)lvl));
+        LAUScan result = copyScan(scan);
+        result.transformScanInPlace(testTransform());
+        if (lvl == LAUMemoryObjectSimd::LevelSSE) {
+            reference = result;
+        }
+        QVERIFY2(memcmp(result.constPointer(), reference.constPointer(), reference.length()) == 0, qPrintable(LAUMemoryObjectSimd::toString((LAUMemoryObjectSimd::Level)lvl)));
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::transformScanInPlaceColors()
+{
+    // AN XYZRGB SCAN MUST MOVE ITS COORDINATES EXACTLY LIKE AN XYZG SCAN AND KEEP ITS COLORS, WHERE THE
+    // OLD IN PLACE STORE LEFT 1.0 IN THE RED CHANNEL OF EVERY PIXEL
+    LAUScan colorScan = randomScan(33, 17, ColorXYZRGB, 7);
+    LAUScan grayScan(colorScan.width(), colorScan.height(), ColorXYZG);
+    const float *colorBuffer = (const float *)colorScan.constPointer();
+    float *grayBuffer = (float *)grayScan.pointer();
+    for (unsigned int pxl = 0; pxl < colorScan.width() * colorScan.height(); pxl++) {
+        memcpy(grayBuffer + 4 * pxl, colorBuffer + 6 * pxl, 3 * sizeof(float));
+        grayBuffer[4 * pxl + 3] = colorBuffer[6 * pxl + 3];
+    }
+
+    for (int lvl = LAUMemoryObjectSimd::LevelSSE; lvl <= LAUMemoryObjectSimd::supportedLevel(); lvl++) {
+        QVERIFY(LAUMemoryObjectSimd::setLevel((LAUMemoryObjectSimd::Level)lvl));
+        LAUScan colorResult = copyScan(colorScan);
+        LAUScan grayResult = copyScan(grayScan);
+        colorResult.transformScanInPlace(testTransform());
+        grayResult.transformScanInPlace(testTransform());
+
+        const float *colorPixels = (const float *)colorResult.constPointer();
+        const float *grayPixels = (const float *)grayResult.constPointer();
+        for (unsigned int pxl = 0; pxl < colorScan.width() * colorScan.height(); pxl++) {
+            QVERIFY(memcmp(colorPixels + 6 * pxl, grayPixels + 4 * pxl, 3 * sizeof(float)) == 0);
+            QVERIFY(memcmp(colorPixels + 6 * pxl + 3, colorBuffer + 6 * pxl + 3, 3 * sizeof(float)) == 0);
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::transformScanInPlaceThreads_data()
+{
+    QTest::addColumn<int>("color");
+    QTest::addColumn<QSize>("size");
+
+    // SCANS BELOW, AT AND ABOVE LAUSCANTRANSFORMTHREADTHRESHOLD, PLUS ONE WITH FEWER ROWS THAN THREADS
+    QList<QSize> sizes = { QSize(33, 17), QSize(320, 240), QSize(640, 480), QSize(1000, 3) };
+    QList<LAUVideoPlaybackColor> colors = { ColorXYZG, ColorXYZRGB, ColorXYZWRGBA };
+    for (LAUVideoPlaybackColor color : colors) {
+        for (const QSize &size : sizes) {
+            QTest::addRow("%d channel %dx%d", LAUScan(1, 1, color).colors(), size.width(), size.height()) << (int)color << size;
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::transformScanInPlaceThreads()
+{
+    QFETCH(int, color);
+    QFETCH(QSize, size);
+
+    LAUScan scan = randomScan(size.width(), size.height(), (LAUVideoPlaybackColor)color, (quint32)(size.width() * size.height() + color));
+
+    // SPLITTING THE ROWS INTO BLOCKS MUST NOT CHANGE A SINGLE BIT, AT ANY LEVEL
+    for (int lvl = LAUMemoryObjectSimd::LevelSSE; lvl <= LAUMemoryObjectSimd::supportedLevel(); lvl++) {
+        QVERIFY(LAUMemoryObjectSimd::setLevel((LAUMemoryObjectSimd::Level)lvl));
+        LAUScan reference = copyScan(scan);
+        reference.transformScanInPlace(testTransform(), 1);
+
+        for (int threads : { 2, 3, 7, 16 }) {
+            LAUScan result = copyScan(scan);
+            result.transformScanInPlace(testTransform(), threads);
+            QVERIFY2(memcmp(result.constPointer(), reference.constPointer(), reference.length()) == 0, qPrintable(QString("%1 with %2 threads").arg(LAUMemoryObjectSimd::toString((LAUMemoryObjectSimd::Level)lvl)).arg(threads)));
+            QCOMPARE(limits(result), limits(reference));
+        }
+
+        // THE DEFAULT OVERLOAD PICKS ITS OWN SPLIT AND MUST AGREE AS WELL
+        LAUScan result = copyScan(scan);
+        result.transformScanInPlace(testTransform());
+        QVERIFY(memcmp(result.constPointer(), reference.constPointer(), reference.length()) == 0);
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::fromRawDepth_data()
+{
+    QTest::addColumn<QSize>("size");
+
+    // ODD WIDTHS LEAVE PIXELS OVER FOR THE SCALAR TAIL
+    QList<QSize> sizes = { QSize(1, 1), QSize(7, 3), QSize(33, 17), QSize(640, 480) };
+    for (const QSize &size : sizes) {
+        QTest::addRow("%dx%d", size.width(), size.height()) << size;
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::fromRawDepth()
+{
+    QFETCH(QSize, size);
+
+    LAULookUpTable table = randomDepthTable(size.width(), size.height(), (quint32)size.width());
+    LAUMemoryObject object = randomDepth(size.width(), size.height(), (quint32)size.height());
+    LAUScan scan = LAUScan::fromRawDepth(object, table);
+    LAUScan reference = fromRawDepthReference(object, table);
+    QCOMPARE(scan.width(), reference.width());
+    QCOMPARE(scan.height(), reference.height());
+    QCOMPARE(scan.colors(), reference.colors());
+
+    float zMin = qMin(table.zLimits().x(), table.zLimits().y());
+    float zMax = qMax(table.zLimits().x(), table.zLimits().y());
+
+    // HORNER'S SCHEME ROUNDS DIFFERENTLY FROM POW(), SO ALLOW A FEW ULPS OF THE LARGEST TERM
+    int nans = 0;
+    for (unsigned int row = 0; row < scan.height(); row++) {
+        const float *buffer = (const float *)scan.constScanLine(row);
+        const float *expected = (const float *)reference.constScanLine(row);
+        const float *lutBuffer = (const float *)table.constScanLine(row);
+        for (unsigned int col = 0; col < scan.width(); col++) {
+            const float *lutVector = lutBuffer + col * table.colors();
+            const float *pixel = buffer + 4 * col;
+            const float *other = expected + 4 * col;
+            float zTolerance = 1e-5f * (qAbs(lutVector[4]) + qAbs(lutVector[5]) + qAbs(lutVector[6]) + qAbs(lutVector[7]) + qAbs(lutVector[8]));
+
+            // THE GRAYSCALE CHANNEL IS THE SAME DIVISION ON BOTH PATHS
+            QCOMPARE(pixel[3], other[3]);
+
+            // A DEPTH WITHIN ROUNDING OF EITHER LIMIT MAY LAND ON EITHER SIDE OF IT
+            if (qIsNaN(pixel[2]) != qIsNaN(other[2])) {
+                float z = qIsNaN(pixel[2]) ? other[2] : pixel[2];
+                QVERIFY2(qAbs(z - zMin) <= zTolerance || qAbs(z - zMax) <= zTolerance, qPrintable(QString("NaN mismatch at %1,%2 with z = %3").arg(col).arg(row).arg(z)));
+                continue;
+            }
+            if (qIsNaN(other[2])) {
+                QVERIFY(qIsNaN(pixel[0]) && qIsNaN(pixel[1]));
+                nans++;
+                continue;
+            }
+            QVERIFY2(qAbs(pixel[2] - other[2]) <= zTolerance, qPrintable(QString("z at %1,%2: %3 vs %4").arg(col).arg(row).arg(pixel[2]).arg(other[2])));
+            for (int chn = 0; chn < 2; chn++) {
+                float xyTolerance = qAbs(lutVector[2 * chn]) * zTolerance + 1e-5f * (qAbs(lutVector[2 * chn] * other[2]) + qAbs(lutVector[2 * chn + 1]));
+                QVERIFY2(qAbs(pixel[chn] - other[chn]) <= xyTolerance, qPrintable(QString("channel %1 at %2,%3: %4 vs %5").arg(chn).arg(col).arg(row).arg(pixel[chn]).arg(other[chn])));
+            }
+        }
+    }
+
+    // THE RANDOM TABLE MUST EXERCISE BOTH SIDES OF THE Z-RANGE TEST ON THE LARGER SIZES
+    if (size.width() * size.height() > 100) {
+        QVERIFY(nans > 0);
+        QVERIFY(nans < size.width() * size.height());
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::benchmark_data()
+{
+    QTest::addColumn<int>("level");
+    QTest::addColumn<QString>("kernel");
+
+    // ONE 640X480 XYZG FRAME PER KERNEL AT EVERY LEVEL THIS CPU SUPPORTS
+    for (int lvl = LAUMemoryObjectSimd::LevelSSE; lvl <= LAUMemoryObjectSimd::supportedLevel(); lvl++) {
+        QString name = LAUMemoryObjectSimd::toString((LAUMemoryObjectSimd::Level)lvl);
+        for (QString kernel : { QString("updateLimits"), QString("mergeScans"), QString("transformScanInPlace") }) {
+            QTest::addRow("%s %s", qPrintable(kernel), qPrintable(name)) << lvl << kernel;
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::benchmark()
+{
+    QFETCH(int, level);
+    QFETCH(QString, kernel);
+
+    LAUScan scan = randomScan(640, 480, ColorXYZG, 1);
+    QVERIFY(LAUMemoryObjectSimd::setLevel((LAUMemoryObjectSimd::Level)level));
+    if (kernel == QString("updateLimits")) {
+        QBENCHMARK {
+            scan.updateLimits();
+        }
+    } else if (kernel == QString("mergeScans")) {
+        LAUScan other = randomScan(640, 480, ColorXYZG, 2);
+        QBENCHMARK {
+            LAUScan merged = LAUScan::mergeScans(QList<LAUScan>() << copyScan(scan) << other);
+            Q_UNUSED(merged);
+        }
+    } else {
+        // A RIGID TRANSFORM SO REPEATED CALLS DON'T GROW THE COORDINATES
+        QBENCHMARK {
+            scan.transformScanInPlace(testTransform());
+        }
+    }
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::fromRawDepthBenchmark_data()
+{
+    QTest::addColumn<bool>("reference");
+
+    QTest::newRow("scalar pow") << true;
+    QTest::newRow("fromRawDepth") << false;
+}
+
+/****************************************************************************/
+/****************************************************************************/
+/****************************************************************************/
+void LAUScanTest::fromRawDepthBenchmark()
+{
+    QFETCH(bool, reference);
+
+    LAULookUpTable table = randomDepthTable(640, 480, 1);
+    LAUMemoryObject object = randomDepth(640, 480, 2);
+    if (reference) {
+        QBENCHMARK {
+            LAUScan scan = fromRawDepthReference(object, table);
+            Q_UNUSED(scan);
+        }
+    } else {
+        QBENCHMARK {
+            LAUScan scan = LAUScan::fromRawDepth(object, table);
+            Q_UNUSED(scan);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(LAUScanTest)
+
+#include "tst_lauscan.moc"